@@ -0,0 +1,77 @@
+#include "SPBPQueuePool.h"
+#include "SPBPriorityQueue.h"
+#include <stdlib.h> // NULL
+#include <stdbool.h> // bool, true
+#include <pthread.h> // pthread_once, pthread_key_create, pthread_setspecific
+
+// The pool of the calling thread, used as a stack
+static __thread SPBPQueue pool[SP_BPQUEUE_POOL_CAPACITY];
+static __thread int poolSize = 0;
+static __thread bool poolRegistered = false; // Indicates that poolKey drains the pool at thread exit
+
+static pthread_once_t poolKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t poolKey; // Drains the pool of an exiting thread
+
+// Called when a thread which cached a queue exits
+static void poolExit(void* arg) {
+	(void) arg;
+	spBPQueuePoolDrain();
+	poolRegistered = false;
+}
+
+static void poolCreateKey() {
+	pthread_key_create(&poolKey, poolExit);
+}
+
+SPBPQueue spBPQueueAcquire(int maxSize, SP_BPQUEUE_BACKEND backend) {
+	// Function variables
+	SPBPQueue queue;
+	int i; // Generic loop variable
+	// Function code
+	if (maxSize < 0) {
+		return NULL; // Invalid parameters
+	}
+	for (i = poolSize - 1; i >= 0; i--) { // Most recently released first, it is likely cached
+		if (spBPQueueGetBackend(pool[i]) == backend) {
+			queue = pool[i];
+			pool[i] = pool[poolSize - 1];
+			poolSize--;
+			if (spBPQueueReset(queue, maxSize) == SP_BPQUEUE_SUCCESS) {
+				return queue;
+			}
+			spBPQueueDestroy(queue); // Growing it failed, a new queue may still fit
+			break;
+		}
+	}
+	return spBPQueueCreateWithBackend(maxSize, backend);
+}
+
+void spBPQueueRelease(SPBPQueue source) {
+	if (source == NULL) {
+		return;
+	}
+	if (poolSize == SP_BPQUEUE_POOL_CAPACITY) {
+		spBPQueueDestroy(source);
+		return;
+	}
+	if (!poolRegistered) { // First queue cached by this thread
+		pthread_once(&poolKeyOnce, poolCreateKey);
+		pthread_setspecific(poolKey, pool);
+		poolRegistered = true;
+	}
+	spBPQueueClear(source);
+	pool[poolSize] = source;
+	poolSize++;
+}
+
+void spBPQueuePoolDrain() {
+	while (poolSize > 0) {
+		poolSize--;
+		spBPQueueDestroy(pool[poolSize]);
+		pool[poolSize] = NULL;
+	}
+}
+
+int spBPQueuePoolSize() {
+	return poolSize;
+}
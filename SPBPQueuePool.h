@@ -0,0 +1,65 @@
+#ifndef SPBPQUEUEPOOL_H_
+#define SPBPQUEUEPOOL_H_
+#include "SPBPriorityQueue.h"
+/**
+ * SP Bounded Priority Queue Pool summary
+ *
+ * A thread-local cache of SPBPQueue objects for code which needs a short
+ * lived queue per query. Instead of creating and destroying a queue for every
+ * query, a queue is acquired from the pool of the calling thread and released
+ * back into it afterwards. Released queues keep their memory (see
+ * spBPQueueReset), so after warm-up the acquire/release cycle does not
+ * allocate.
+ *
+ * Every thread has its own pool, so no locking is involved. A queue may be
+ * released by a different thread than the one which acquired it, it then
+ * joins the pool of the releasing thread. The pool of a thread is drained
+ * when the thread exits through pthread_exit or by returning from its start
+ * routine. The main thread does not drain its pool that way, so it should call
+ * spBPQueuePoolDrain before the program exits.
+ *
+ * The following functions are available:
+ *
+ *   spBPQueueAcquire    - Returns an empty queue from the pool
+ *   spBPQueueRelease    - Returns a queue to the pool
+ *   spBPQueuePoolDrain  - Destroys all queues cached by the calling thread
+ *   spBPQueuePoolSize   - Returns the number of cached queues
+ */
+
+/** The maximal number of queues cached by a single thread **/
+#define SP_BPQUEUE_POOL_CAPACITY 16
+
+/**
+ * Returns an empty queue from the pool of the calling thread, or creates a
+ * new one if the pool holds no queue of the requested backend. A pooled
+ * queue which cannot grow to maxSize is destroyed, and a new one is created
+ * instead.
+ *
+ * @param maxSize - The maximal number of elements allowed in the queue.
+ * @param backend - The storage of the queue.
+ * @return
+ * NULL in case of memory allocation fails, if maxSize < 0 or if backend
+ * is not a valid backend.
+ * Otherwise an empty queue with size bound of maxSize.
+ */
+SPBPQueue spBPQueueAcquire(int maxSize, SP_BPQUEUE_BACKEND backend);
+
+/**
+ * Returns a queue to the pool of the calling thread. The queue must not be
+ * used afterwards. If the pool is full the queue is destroyed.
+ *
+ * @param source - The queue to release. If source is NULL nothing is done.
+ */
+void spBPQueueRelease(SPBPQueue source);
+
+/**
+ * Destroys all queues cached by the calling thread.
+ */
+void spBPQueuePoolDrain();
+
+/**
+ * Returns the number of queues cached by the calling thread.
+ */
+int spBPQueuePoolSize();
+
+#endif /* SPBPQUEUEPOOL_H_ */
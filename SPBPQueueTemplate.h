@@ -0,0 +1,234 @@
+#ifndef SPBPQUEUETEMPLATE_H_
+#define SPBPQUEUETEMPLATE_H_
+#include "SPBPriorityQueue.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+/**
+ * SP Bounded Priority Queue Template summary
+ *
+ * SPBPQueue stores SPListElement, an (int index, double value) pair.
+ * This header generates bounded priority queues for any key and payload
+ * types instead, for example float distances with 64 bit ids, or uint32
+ * Hamming distances. Each instantiation is specialized static inline code, so
+ * keys and payloads are stored unboxed and comparisons can be inlined.
+ *
+ * SP_DEFINE_BPQUEUE(name, KeyT, PayloadT, cmp) defines the type name and the
+ * functions below, each prefixed by name:
+ *
+ *   Init       - Initializes an empty queue with a size bound
+ *   Destroy    - Frees the memory held by the queue
+ *   Clear      - Removes all elements, keeping the memory
+ *   Reset      - Removes all elements and sets a new size bound
+ *   Size       - Returns the number of elements
+ *   GetMaxSize - Returns the size bound
+ *   IsEmpty    - Returns true if the queue is empty
+ *   IsFull     - Returns true if the queue is full
+ *   Enqueue    - Inserts a (key, payload) pair
+ *   Dequeue    - Removes the lowest priority element
+ *   Peek       - Reads the lowest priority element
+ *   PeekLast   - Reads the highest priority element
+ *   At         - Reads the i-th lowest priority element
+ *
+ * cmp(a, b) is a function or a macro which compares two keys, and returns a
+ * negative number, zero or a positive number if a is lower, equal or higher
+ * priority than b. SP_BPQUEUE_COMPARE_NUMBERS can be used for numeric keys.
+ * Elements with equal keys are kept in insertion order, and a new element
+ * whose key equals the highest key of a full queue does not enter it. To get
+ * the SPBPQueue tie breaking, make the index part of the key.
+ *
+ * The queue is a sorted array in which the elements occupy a window, so
+ * peeking at both ends and dequeueing are O(1), finding the insertion point
+ * is a binary search, and an insertion shifts the shorter side of the window
+ * with a single memmove.
+ *
+ * For example:
+ * @code
+ * SP_DEFINE_BPQUEUE(SPFloatIdQueue, float, uint64_t, SP_BPQUEUE_COMPARE_NUMBERS)
+ *
+ * void f(const float* distances, int n) {
+ *   SPFloatIdQueue queue;
+ *   float key;
+ *   uint64_t id;
+ *   SPFloatIdQueueInit(&queue, 10);
+ *   for (int i = 0; i < n; i++) {
+ *     SPFloatIdQueueEnqueue(&queue, distances[i], (uint64_t) i);
+ *   }
+ *   while (SPFloatIdQueuePeek(&queue, &key, &id)) {
+ *     printf("%llu %f\n", (unsigned long long) id, key);
+ *     SPFloatIdQueueDequeue(&queue);
+ *   }
+ *   SPFloatIdQueueDestroy(&queue);
+ * }
+ * @endcode
+ */
+
+/** Compares two numeric keys of any type without overflow **/
+#define SP_BPQUEUE_COMPARE_NUMBERS(a, b) (((a) > (b)) - ((a) < (b)))
+
+#define SP_DEFINE_BPQUEUE(name, KeyT, PayloadT, cmp) \
+\
+typedef struct name##_t { \
+	KeyT* keys; \
+	PayloadT* payloads; \
+	int first; /* Position of the lowest priority element */ \
+	int size; \
+	int maxSize; \
+	int capacity; \
+} name; \
+\
+static inline SP_BPQUEUE_MSG name##Init(name* queue, int maxSize) { \
+	int capacity = maxSize > 0 ? maxSize : 1; \
+	if (queue == NULL || maxSize < 0) { \
+		return SP_BPQUEUE_INVALID_ARGUMENT; \
+	} \
+	queue->keys = (KeyT*) malloc(sizeof(KeyT)*capacity); \
+	queue->payloads = (PayloadT*) malloc(sizeof(PayloadT)*capacity); \
+	if (queue->keys == NULL || queue->payloads == NULL) { \
+		free(queue->keys); \
+		free(queue->payloads); \
+		queue->keys = NULL; \
+		queue->payloads = NULL; \
+		return SP_BPQUEUE_OUT_OF_MEMORY; \
+	} \
+	queue->first = 0; \
+	queue->size = 0; \
+	queue->maxSize = maxSize; \
+	queue->capacity = capacity; \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline void name##Destroy(name* queue) { \
+	if (queue != NULL) { \
+		free(queue->keys); \
+		free(queue->payloads); \
+		queue->keys = NULL; \
+		queue->payloads = NULL; \
+		queue->size = 0; \
+	} \
+} \
+\
+static inline void name##Clear(name* queue) { \
+	if (queue != NULL) { \
+		queue->first = 0; \
+		queue->size = 0; \
+	} \
+} \
+\
+static inline SP_BPQUEUE_MSG name##Reset(name* queue, int maxSize) { \
+	KeyT* keys; \
+	PayloadT* payloads; \
+	if (queue == NULL || maxSize < 0) { \
+		return SP_BPQUEUE_INVALID_ARGUMENT; \
+	} \
+	name##Clear(queue); \
+	if (maxSize > queue->capacity) { \
+		keys = (KeyT*) realloc(queue->keys, sizeof(KeyT)*maxSize); \
+		if (keys == NULL) { \
+			return SP_BPQUEUE_OUT_OF_MEMORY; \
+		} \
+		queue->keys = keys; \
+		payloads = (PayloadT*) realloc(queue->payloads, sizeof(PayloadT)*maxSize); \
+		if (payloads == NULL) { \
+			return SP_BPQUEUE_OUT_OF_MEMORY; \
+		} \
+		queue->payloads = payloads; \
+		queue->capacity = maxSize; \
+	} \
+	queue->maxSize = maxSize; \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline int name##Size(const name* queue) { \
+	return queue == NULL ? -1 : queue->size; \
+} \
+\
+static inline int name##GetMaxSize(const name* queue) { \
+	return queue == NULL ? -1 : queue->maxSize; \
+} \
+\
+static inline bool name##IsEmpty(const name* queue) { \
+	return queue->size == 0; \
+} \
+\
+static inline bool name##IsFull(const name* queue) { \
+	return queue->size == queue->maxSize; \
+} \
+\
+static inline SP_BPQUEUE_MSG name##Enqueue(name* queue, KeyT key, PayloadT payload) { \
+	int low, high, middle, position; \
+	bool wasFull; \
+	if (queue == NULL) { \
+		return SP_BPQUEUE_INVALID_ARGUMENT; \
+	} \
+	wasFull = queue->size == queue->maxSize; \
+	if (wasFull) { \
+		if (queue->size == 0 \
+				|| cmp(key, queue->keys[queue->first + queue->size - 1]) >= 0) { \
+			return SP_BPQUEUE_FULL; \
+		} \
+		queue->size--; /* Evict the highest priority element */ \
+	} \
+	low = 0; /* Find the first element with a greater key */ \
+	high = queue->size; \
+	while (low < high) { \
+		middle = low + (high - low) / 2; \
+		if (cmp(key, queue->keys[queue->first + middle]) < 0) { \
+			high = middle; \
+		} else { \
+			low = middle + 1; \
+		} \
+	} \
+	if (queue->first > 0 && (low < queue->size / 2 \
+			|| queue->first + queue->size == queue->capacity)) { /* Shift the lower side */ \
+		memmove(queue->keys + queue->first - 1, queue->keys + queue->first, sizeof(KeyT)*low); \
+		memmove(queue->payloads + queue->first - 1, queue->payloads + queue->first, \
+				sizeof(PayloadT)*low); \
+		queue->first--; \
+	} else { /* Shift the upper side */ \
+		memmove(queue->keys + queue->first + low + 1, queue->keys + queue->first + low, \
+				sizeof(KeyT)*(queue->size - low)); \
+		memmove(queue->payloads + queue->first + low + 1, queue->payloads + queue->first + low, \
+				sizeof(PayloadT)*(queue->size - low)); \
+	} \
+	position = queue->first + low; \
+	queue->keys[position] = key; \
+	queue->payloads[position] = payload; \
+	queue->size++; \
+	return wasFull ? SP_BPQUEUE_FULL : SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline SP_BPQUEUE_MSG name##Dequeue(name* queue) { \
+	if (queue == NULL) { \
+		return SP_BPQUEUE_INVALID_ARGUMENT; \
+	} \
+	if (queue->size == 0) { \
+		return SP_BPQUEUE_EMPTY; \
+	} \
+	queue->size--; \
+	queue->first = queue->size == 0 ? 0 : queue->first + 1; \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline bool name##At(const name* queue, int i, KeyT* key, PayloadT* payload) { \
+	if (queue == NULL || i < 0 || i >= queue->size) { \
+		return false; \
+	} \
+	if (key != NULL) { \
+		*key = queue->keys[queue->first + i]; \
+	} \
+	if (payload != NULL) { \
+		*payload = queue->payloads[queue->first + i]; \
+	} \
+	return true; \
+} \
+\
+static inline bool name##Peek(const name* queue, KeyT* key, PayloadT* payload) { \
+	return name##At(queue, 0, key, payload); \
+} \
+\
+static inline bool name##PeekLast(const name* queue, KeyT* key, PayloadT* payload) { \
+	return queue != NULL && name##At(queue, queue->size - 1, key, payload); \
+}
+
+#endif /* SPBPQUEUETEMPLATE_H_ */
@@ -1,36 +1,266 @@
 #include "SPBPriorityQueue.h"
 #include "SPList.h"
+#include "SPSkipList.h"
 #include "SPListElement.h"
+#include "SPListElementInternal.h"
 #include <stdlib.h> // malloc, free, NULL
+#include <string.h> // memcpy
 #include <assert.h> // assert
 
+// An element stored by value in the heap backend
+typedef struct sp_bp_queue_entry_t {
+	int index;
+	double value;
+} SPBPQueueEntry;
+
 struct sp_bp_queue_t {
-	SPList elementList;
+	SP_BPQUEUE_BACKEND backend;
+	SPList elementList; // SP_BPQUEUE_LIST_BACKEND storage, sorted ascending
+	SPBPQueueEntry* heap; // SP_BPQUEUE_HEAP_BACKEND storage, a min-max heap
+	SPSkipList skipList; // SP_BPQUEUE_SKIPLIST_BACKEND storage
+	int heapSize;
+	int heapCapacity;
 	int maxSize;
 };
 
+/*
+ * Min-max heap helpers.
+ * Nodes on even levels (the root is on level 0) are smaller than or equal to
+ * all of their descendants, nodes on odd levels are greater than or equal to
+ * all of their descendants. The lowest priority element is the root, and the
+ * highest priority element is one of the root's children.
+ */
+
+// Same relation as spListElementCompare
+static int entryCompare(const SPBPQueueEntry* e1, const SPBPQueueEntry* e2) {
+	return spListElementKeyCompare(spListElementValueKey(e1->value), e1->index,
+			spListElementValueKey(e2->value), e2->index);
+}
+
+static int entryQsortCompare(const void* e1, const void* e2) {
+	return entryCompare((const SPBPQueueEntry*) e1, (const SPBPQueueEntry*) e2);
+}
+
+static void entrySwap(SPBPQueueEntry* heap, int i, int j) {
+	SPBPQueueEntry temp = heap[i];
+	heap[i] = heap[j];
+	heap[j] = temp;
+}
+
+static bool heapIsMinLevel(int i) {
+	int level = 0;
+	for (i = i + 1; i > 1; i >>= 1) {
+		level++;
+	}
+	return (level & 1) == 0;
+}
+
+// Returns -1 for a min level node and 1 for a max level node, so that
+// (order * entryCompare(a, b) < 0) means a should be above b
+static int heapOrder(int i) {
+	return heapIsMinLevel(i) ? 1 : -1;
+}
+
+static void heapBubbleUpSameLevels(SPBPQueueEntry* heap, int i, int order) {
+	int grandparent;
+	while (i > 2) {
+		grandparent = ((i - 1) / 2 - 1) / 2;
+		if (order * entryCompare(&heap[i], &heap[grandparent]) >= 0) {
+			break;
+		}
+		entrySwap(heap, i, grandparent);
+		i = grandparent;
+	}
+}
+
+static void heapBubbleUp(SPBPQueueEntry* heap, int i) {
+	int parent;
+	int order = heapOrder(i);
+	if (i == 0) {
+		return;
+	}
+	parent = (i - 1) / 2;
+	if (order * entryCompare(&heap[i], &heap[parent]) > 0) { // Belongs to the parent's levels
+		entrySwap(heap, i, parent);
+		heapBubbleUpSameLevels(heap, parent, -order);
+	} else {
+		heapBubbleUpSameLevels(heap, i, order);
+	}
+}
+
+static void heapTrickleDown(SPBPQueueEntry* heap, int size, int i) {
+	int order = heapOrder(i);
+	int best, child, grandchild, last; // best - the extreme among children and grandchildren
+	while (2 * i + 1 < size) {
+		best = 2 * i + 1;
+		for (child = 2 * i + 1; child <= 2 * i + 2 && child < size; child++) {
+			if (order * entryCompare(&heap[child], &heap[best]) < 0) {
+				best = child;
+			}
+			last = 2 * child + 2 < size ? 2 * child + 2 : size - 1;
+			for (grandchild = 2 * child + 1; grandchild <= last; grandchild++) {
+				if (order * entryCompare(&heap[grandchild], &heap[best]) < 0) {
+					best = grandchild;
+				}
+			}
+		}
+		if (order * entryCompare(&heap[best], &heap[i]) >= 0) {
+			return; // Heap property holds
+		}
+		entrySwap(heap, i, best);
+		if (best <= 2 * i + 2) {
+			return; // A child has no descendants on the same levels
+		}
+		if (order * entryCompare(&heap[best], &heap[(best - 1) / 2]) > 0) {
+			entrySwap(heap, best, (best - 1) / 2);
+		}
+		i = best;
+	}
+}
+
+static int heapMaxPosition(SPBPQueueEntry* heap, int size) {
+	if (size <= 2) {
+		return size - 1;
+	}
+	return entryCompare(&heap[1], &heap[2]) >= 0 ? 1 : 2;
+}
+
+static void heapRemoveAt(SPBPQueue source, int i) {
+	source->heapSize--;
+	if (i < source->heapSize) {
+		source->heap[i] = source->heap[source->heapSize];
+		heapTrickleDown(source->heap, source->heapSize, i);
+	}
+}
+
+static void heapPush(SPBPQueue source, SPBPQueueEntry* entry) {
+	source->heap[source->heapSize] = *entry;
+	source->heapSize++;
+	heapBubbleUp(source->heap, source->heapSize - 1);
+}
+
+static SP_BPQUEUE_MSG heapEnqueue(SPBPQueue source, SPListElement element) {
+	// Function variables
+	SPBPQueueEntry entry;
+	int maxPosition;
+	// Function code
+	entry.index = spListElementGetIndex(element);
+	entry.value = spListElementGetValue(element);
+	if (source->heapSize < source->maxSize) {
+		heapPush(source, &entry);
+		return SP_BPQUEUE_SUCCESS;
+	}
+	if (source->heapSize == 0) { // maxSize is 0
+		return SP_BPQUEUE_FULL;
+	}
+	maxPosition = heapMaxPosition(source->heap, source->heapSize);
+	if (entryCompare(&entry, &source->heap[maxPosition]) < 0) { // Evict the highest priority element
+		heapRemoveAt(source, maxPosition);
+		heapPush(source, &entry);
+	}
+	return SP_BPQUEUE_FULL;
+}
+
+static SPBPQueueEntry* heapFirst(SPBPQueue source) {
+	return &source->heap[0];
+}
+
+static SPBPQueueEntry* heapLast(SPBPQueue source) {
+	return &source->heap[heapMaxPosition(source->heap, source->heapSize)];
+}
+
+static SP_BPQUEUE_MSG skipListEnqueue(SPBPQueue source, SPListElement element) {
+	// Function variables
+	bool overflow = spSkipListGetSize(source->skipList) == source->maxSize;
+	// Function code
+	if (overflow) {
+		if (source->maxSize == 0 || spListElementOrder(element, spSkipListMax(source->skipList)) >= 0) {
+			return SP_BPQUEUE_FULL; // The element would be evicted at once
+		}
+		spSkipListRemoveLast(source->skipList);
+	}
+	if (spSkipListInsert(source->skipList, element) == SP_SKIP_LIST_OUT_OF_MEMORY) {
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	return overflow ? SP_BPQUEUE_FULL : SP_BPQUEUE_SUCCESS;
+}
+
 SPBPQueue spBPQueueCreate(int maxSize) {
+	return spBPQueueCreateWithBackend(maxSize, SP_BPQUEUE_LIST_BACKEND);
+}
+
+SPBPQueue spBPQueueCreateWithBackend(int maxSize, SP_BPQUEUE_BACKEND backend) {
 	// Function variables
 	SPBPQueue BPQueue;
-	SPList elemList;
+	SPList elemList = NULL;
+	SPBPQueueEntry* heap = NULL;
+	SPSkipList skipList = NULL;
+	int heapCapacity = maxSize > 0 ? maxSize : 1;
 	// Function code
-	if (maxSize < 0) {
+	if (maxSize < 0 || (backend != SP_BPQUEUE_LIST_BACKEND && backend != SP_BPQUEUE_HEAP_BACKEND
+			&& backend != SP_BPQUEUE_SKIPLIST_BACKEND)) {
 		return NULL; // Invalid parameters
 	}
 	BPQueue = (SPBPQueue) malloc(sizeof(struct sp_bp_queue_t));
 	if (BPQueue == NULL) { // Allocation Fails
 		return NULL;
 	}
-	elemList = spListCreate();
+	if (backend == SP_BPQUEUE_LIST_BACKEND) {
+		elemList = spListCreate();
+		if (elemList == NULL) { // Allocation Fails
+			free(BPQueue);
+			return NULL;
+		}
+	} else if (backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		skipList = spSkipListCreate();
+		if (skipList == NULL) { // Allocation Fails
+			free(BPQueue);
+			return NULL;
+		}
+	} else {
+		heap = (SPBPQueueEntry*) malloc(sizeof(SPBPQueueEntry)*heapCapacity);
+		if (heap == NULL) { // Allocation Fails
+			free(BPQueue);
+			return NULL;
+		}
+	}
+	BPQueue->backend = backend;
+	BPQueue->maxSize = maxSize;
+	BPQueue->elementList = elemList;
+	BPQueue->heap = heap;
+	BPQueue->skipList = skipList;
+	BPQueue->heapSize = 0;
+	BPQueue->heapCapacity = heapCapacity;
+	return BPQueue;
+}
+
+SPBPQueue spBPQueueCreateWithPool(int maxSize, SPListNodePool pool) {
+	// Function variables
+	SPBPQueue BPQueue;
+	SPList elemList;
+	// Function code
+	if (pool == NULL) {
+		return NULL; // Invalid parameters
+	}
+	BPQueue = spBPQueueCreateWithBackend(maxSize, SP_BPQUEUE_LIST_BACKEND);
+	if (BPQueue == NULL) { // Allocation Fails
+		return NULL;
+	}
+	elemList = spListCreateWithPool(pool);
 	if (elemList == NULL) { // Allocation Fails
-		free(BPQueue);
+		spBPQueueDestroy(BPQueue);
 		return NULL;
 	}
-	BPQueue->maxSize = maxSize;
+	spListDestroy(BPQueue->elementList); // Replace the list using a private pool
 	BPQueue->elementList = elemList;
 	return BPQueue;
 }
 
+SP_BPQUEUE_BACKEND spBPQueueGetBackend(SPBPQueue source) {
+	assert(source != NULL);
+	return source->backend;
+}
+
 SPBPQueue spBPQueueCopy(SPBPQueue source) {
 	// Function variables
 	SPBPQueue newBPQueue;
@@ -38,10 +268,27 @@ SPBPQueue spBPQueueCopy(SPBPQueue source) {
 	if (source == NULL) {
 		return NULL; // Invalid source queue
 	}
-	newBPQueue = spBPQueueCreate(source->maxSize);
-	if (newBPQueue != NULL) { // Creation Succeeded
+	newBPQueue = spBPQueueCreateWithBackend(source->maxSize, source->backend);
+	if (newBPQueue == NULL) { // Creation Failed
+		return NULL;
+	}
+	if (source->backend == SP_BPQUEUE_LIST_BACKEND) {
 		spListDestroy(newBPQueue->elementList); // Free the empty list
 		newBPQueue->elementList = spListCopy(source->elementList); // Copy source's list
+		if (newBPQueue->elementList == NULL) { // Allocation Fails
+			free(newBPQueue);
+			return NULL;
+		}
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		spSkipListDestroy(newBPQueue->skipList);
+		newBPQueue->skipList = spSkipListCopy(source->skipList);
+		if (newBPQueue->skipList == NULL) { // Allocation Fails
+			free(newBPQueue);
+			return NULL;
+		}
+	} else {
+		memcpy(newBPQueue->heap, source->heap, sizeof(SPBPQueueEntry)*source->heapSize);
+		newBPQueue->heapSize = source->heapSize;
 	}
 	return newBPQueue;
 }
@@ -49,6 +296,8 @@ SPBPQueue spBPQueueCopy(SPBPQueue source) {
 void spBPQueueDestroy(SPBPQueue source) {
 	if (source != NULL) {
 		spListDestroy(source->elementList);
+		spSkipListDestroy(source->skipList);
+		free(source->heap);
 		free(source);
 	}
 }
@@ -56,12 +305,38 @@ void spBPQueueDestroy(SPBPQueue source) {
 void spBPQueueClear(SPBPQueue source) {
 	if (source != NULL) {
 		spListClear(source->elementList);
+		spSkipListClear(source->skipList);
+		source->heapSize = 0;
+	}
+}
+
+SP_BPQUEUE_MSG spBPQueueReset(SPBPQueue source, int newMaxSize) {
+	// Function variables
+	SPBPQueueEntry* heap;
+	// Function code
+	if (source == NULL || newMaxSize < 0) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
 	}
+	spBPQueueClear(source);
+	if (source->backend == SP_BPQUEUE_HEAP_BACKEND && newMaxSize > source->heapCapacity) {
+		heap = (SPBPQueueEntry*) realloc(source->heap, sizeof(SPBPQueueEntry)*newMaxSize);
+		if (heap == NULL) { // Allocation Fails
+			return SP_BPQUEUE_OUT_OF_MEMORY;
+		}
+		source->heap = heap;
+		source->heapCapacity = newMaxSize;
+	}
+	source->maxSize = newMaxSize;
+	return SP_BPQUEUE_SUCCESS;
 }
 
 int spBPQueueSize(SPBPQueue source) {
 	if (source == NULL) {
 		return -1;
+	} else if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		return source->heapSize;
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return spSkipListGetSize(source->skipList);
 	} else {
 		return spListGetSize(source->elementList);
 	}
@@ -83,15 +358,24 @@ SP_BPQUEUE_MSG spBPQueueEnqueue(SPBPQueue source, SPListElement element) {
 	if (source == NULL || element == NULL) {
 		return SP_BPQUEUE_INVALID_ARGUMENT;
 	}
+	if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		return heapEnqueue(source, element);
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return skipListEnqueue(source, element);
+	}
 	iter = spListGetFirst(source->elementList);
 	if (iter == NULL) { // The list is empty
 		listIndicator = spListInsertFirst(source->elementList,element);
 		if (listIndicator == SP_LIST_OUT_OF_MEMORY) { // Allocation Fails
 			return SP_BPQUEUE_OUT_OF_MEMORY;
 		}
+		if (spBPQueueSize(source) > spBPQueueGetMaxSize(source)) { // maxSize is 0
+			spListClear(source->elementList);
+			return SP_BPQUEUE_FULL;
+		}
 		return SP_BPQUEUE_SUCCESS;
 	}
-	while (iter != NULL && spListElementCompare(iter,element) < 0) { // Find insertion point
+	while (iter != NULL && spListElementOrder(iter,element) < 0) { // Find insertion point
 		iter = spListGetNext(source->elementList);
 	}
 	// Insert a copy of the element (allocation inside spListInsert)
@@ -111,6 +395,107 @@ SP_BPQUEUE_MSG spBPQueueEnqueue(SPBPQueue source, SPListElement element) {
 	return SP_BPQUEUE_SUCCESS;
 }
 
+// Merges a sorted run into the sorted list, the run has at most maxSize elements
+static SP_BPQUEUE_MSG listEnqueueSorted(SPBPQueue source, const int* indices,
+		const double* values, int n) {
+	// Function variables
+	SPListElement scratch = spListElementCreate(0, 0.0);
+	SPListElement iter;
+	SP_LIST_MSG listIndicator = SP_LIST_SUCCESS;
+	bool overflow = false;
+	int i; // Generic loop variable
+	// Function code
+	if (scratch == NULL) { // Allocation Fails
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	iter = spListGetFirst(source->elementList);
+	for (i = 0; i < n && listIndicator == SP_LIST_SUCCESS; i++) {
+		spListElementSetIndex(scratch, indices[i]);
+		spListElementSetValue(scratch, values[i]);
+		while (iter != NULL && spListElementOrder(iter,scratch) < 0) { // Find insertion point
+			iter = spListGetNext(source->elementList);
+		}
+		if (iter == NULL) {
+			if (spBPQueueSize(source) >= source->maxSize) { // The rest of the run cannot enter
+				overflow = true;
+				break;
+			}
+			listIndicator = spListInsertLast(source->elementList,scratch);
+		} else {
+			listIndicator = spListInsertBeforeCurrent(source->elementList,scratch);
+		}
+	}
+	spListElementDestroy(scratch);
+	while (spBPQueueSize(source) > spBPQueueGetMaxSize(source)) { // Queue overflow
+		overflow = true;
+		spListGetLast(source->elementList);
+		spListRemoveCurrent(source->elementList);
+	}
+	if (listIndicator == SP_LIST_OUT_OF_MEMORY) {
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	return overflow ? SP_BPQUEUE_FULL : SP_BPQUEUE_SUCCESS;
+}
+
+SP_BPQUEUE_MSG spBPQueueEnqueueSorted(SPBPQueue source, const int* indices,
+		const double* values, int n) {
+	// Function variables
+	SPBPQueueEntry entry;
+	SPListElement scratch;
+	SP_BPQUEUE_MSG msg = SP_BPQUEUE_SUCCESS;
+	bool overflow;
+	int i; // Generic loop variable
+	// Function code
+	if (source == NULL || indices == NULL || values == NULL || n < 0) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	for (i = 0; i < n; i++) { // Validate the whole run before changing the queue
+		if (indices[i] < 0 || !(values[i] >= 0.0) || (i > 0
+				&& (values[i] < values[i-1] || (values[i] == values[i-1] && indices[i] < indices[i-1])))) {
+			return SP_BPQUEUE_INVALID_ARGUMENT;
+		}
+	}
+	overflow = n > source->maxSize; // The tail of the run can never enter the queue
+	if (overflow) {
+		n = source->maxSize;
+	}
+	if (source->backend == SP_BPQUEUE_LIST_BACKEND) {
+		msg = listEnqueueSorted(source, indices, values, n);
+		return (msg == SP_BPQUEUE_SUCCESS && overflow) ? SP_BPQUEUE_FULL : msg;
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		scratch = spListElementCreate(0, 0.0);
+		if (scratch == NULL) { // Allocation Fails
+			return SP_BPQUEUE_OUT_OF_MEMORY;
+		}
+		for (i = 0; i < n && msg != SP_BPQUEUE_OUT_OF_MEMORY; i++) {
+			spListElementSetIndex(scratch, indices[i]);
+			spListElementSetValue(scratch, values[i]);
+			msg = skipListEnqueue(source, scratch);
+			overflow = overflow || msg == SP_BPQUEUE_FULL;
+		}
+		spListElementDestroy(scratch);
+		if (msg == SP_BPQUEUE_OUT_OF_MEMORY) {
+			return msg;
+		}
+		return overflow ? SP_BPQUEUE_FULL : SP_BPQUEUE_SUCCESS;
+	}
+	for (i = 0; i < n; i++) {
+		entry.index = indices[i];
+		entry.value = values[i];
+		if (source->heapSize < source->maxSize) {
+			heapPush(source, &entry);
+		} else {
+			overflow = true;
+			if (entryCompare(&entry, heapLast(source)) >= 0) {
+				break; // The rest of the run cannot enter
+			}
+			heapRemoveAt(source, heapMaxPosition(source->heap, source->heapSize));
+			heapPush(source, &entry);
+		}
+	}
+	return overflow ? SP_BPQUEUE_FULL : SP_BPQUEUE_SUCCESS;
+}
+
 SP_BPQUEUE_MSG spBPQueueDequeue(SPBPQueue source) {
 	if (source == NULL) {
 		return SP_BPQUEUE_INVALID_ARGUMENT;
@@ -118,41 +503,94 @@ SP_BPQUEUE_MSG spBPQueueDequeue(SPBPQueue source) {
 	if (spBPQueueIsEmpty(source)) {
 		return SP_BPQUEUE_EMPTY;
 	}
-	spListGetFirst(source->elementList);
-	spListRemoveCurrent(source->elementList);
+	if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		heapRemoveAt(source, 0);
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		spSkipListRemoveFirst(source->skipList);
+	} else {
+		spListGetFirst(source->elementList);
+		spListRemoveCurrent(source->elementList);
+	}
 	return SP_BPQUEUE_SUCCESS;
 }
 
 SPListElement spBPQueuePeek(SPBPQueue source) {
 	if (source == NULL || spBPQueueIsEmpty(source)) {
 		return NULL;
+	} else if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		return spListElementCreate(heapFirst(source)->index, heapFirst(source)->value);
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return spListElementCopy(spSkipListMin(source->skipList));
 	} else {
-		return spListElementCopy(spListGetFirst(source->elementList));
+		SPListIter iter = spListIterBegin(source->elementList); // Leaves the list untouched
+		return spListElementCopy(spListIterGet(&iter));
 	}
 }
 
 SPListElement spBPQueuePeekLast(SPBPQueue source) {
 	if (source == NULL || spBPQueueIsEmpty(source)) {
 		return NULL;
+	} else if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		return spListElementCreate(heapLast(source)->index, heapLast(source)->value);
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return spListElementCopy(spSkipListMax(source->skipList));
 	} else {
-		return spListElementCopy(spListGetLast(source->elementList));
+		SPListIter iter = spListIterLast(source->elementList);
+		return spListElementCopy(spListIterGet(&iter));
 	}
 }
 
 double spBPQueueMinValue(SPBPQueue source) {
 	if (source == NULL || spBPQueueIsEmpty(source)) {
 		return -1.0;
+	} else if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		return heapFirst(source)->value;
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return spListElementGetValue(spSkipListMin(source->skipList));
 	} else {
-		return spListElementGetValue(spListGetFirst(source->elementList));
+		SPListIter iter = spListIterBegin(source->elementList);
+		return spListElementGetValue(spListIterGet(&iter));
 	}
 }
 
 double spBPQueueMaxValue(SPBPQueue source) {
 	if (source == NULL || spBPQueueIsEmpty(source)) {
 		return -1.0;
+	} else if (source->backend == SP_BPQUEUE_HEAP_BACKEND) {
+		return heapLast(source)->value;
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return spListElementGetValue(spSkipListMax(source->skipList));
 	} else {
-		return spListElementGetValue(spListGetLast(source->elementList));
+		SPListIter iter = spListIterLast(source->elementList);
+		return spListElementGetValue(spListIterGet(&iter));
+	}
+}
+
+int spBPQueueToArray(SPBPQueue source, int* indices, double* values) {
+	// Function variables
+	SPBPQueueEntry* sorted;
+	int i; // Generic loop variable
+	// Function code
+	if (source == NULL || indices == NULL || values == NULL) {
+		return -1;
+	}
+	if (source->backend == SP_BPQUEUE_LIST_BACKEND) {
+		return spListToArray(source->elementList, indices, values);
+	} else if (source->backend == SP_BPQUEUE_SKIPLIST_BACKEND) {
+		return spSkipListToArray(source->skipList, indices, values);
+	}
+	sorted = (SPBPQueueEntry*) malloc(sizeof(SPBPQueueEntry)*(source->heapSize + 1));
+	if (sorted == NULL) { // Allocation Fails
+		return -1;
+	}
+	memcpy(sorted, source->heap, sizeof(SPBPQueueEntry)*source->heapSize);
+	qsort(sorted, source->heapSize, sizeof(SPBPQueueEntry), entryQsortCompare);
+	for (i = 0; i < source->heapSize; i++) {
+		indices[i] = sorted[i].index;
+		values[i] = sorted[i].value;
 	}
+	free(sorted);
+	return source->heapSize;
 }
 
 bool spBPQueueIsEmpty(SPBPQueue source) {
@@ -1,11 +1,26 @@
 #ifndef SPBPRIORITYQUEUE_H_
 #define SPBPRIORITYQUEUE_H_
 #include "SPListElement.h"
+#include "SPList.h"
 #include <stdbool.h>
 /**
  * SP Bounded Priority Queue summary
  *
- * TODO Complete documentation
+ * Implements a priority queue of SPListElement which holds at most maxSize
+ * elements. Once the queue is full, inserting a new element removes the
+ * highest priority element (see spBPQueueEnqueue for the ordering).
+ *
+ * The queue can be stored in one of the following backends, chosen at
+ * creation time. All functions behave the same for every backend.
+ *
+ * 	- SP_BPQUEUE_LIST_BACKEND: A sorted SPList. Peeking at both ends is O(1),
+ * 	  enqueue is O(maxSize). This is the default backend.
+ * 	- SP_BPQUEUE_HEAP_BACKEND: A min-max heap in one flat array. Peeking at
+ * 	  both ends is O(1), enqueue, dequeue and eviction of the highest priority
+ * 	  element are O(log(maxSize)).
+ * 	- SP_BPQUEUE_SKIPLIST_BACKEND: An SPSkipList. Peeking at both ends is O(1),
+ * 	  enqueue and eviction of the highest priority element are expected
+ * 	  O(log(maxSize)), and dequeue is O(1). Suited to large bounds.
  */
 
 
@@ -21,8 +36,16 @@ typedef enum sp_bp_queue_msg_t {
 	SP_BPQUEUE_SUCCESS
 } SP_BPQUEUE_MSG;
 
+/** type used to choose the storage of a bounded priority queue **/
+typedef enum sp_bp_queue_backend_t {
+	SP_BPQUEUE_LIST_BACKEND,
+	SP_BPQUEUE_HEAP_BACKEND,
+	SP_BPQUEUE_SKIPLIST_BACKEND
+} SP_BPQUEUE_BACKEND;
+
 /**
  * Creates a new Bounded priority queue with bounded size.
+ * The queue uses the default SP_BPQUEUE_LIST_BACKEND backend.
  *
  * @param maxSize - The maximal number of elements allowed in the queue.
  * @return
@@ -31,10 +54,47 @@ typedef enum sp_bp_queue_msg_t {
  */
 SPBPQueue spBPQueueCreate(int maxSize);
 
+/**
+ * Creates a new Bounded priority queue with bounded size, stored in the
+ * given backend.
+ *
+ * @param maxSize - The maximal number of elements allowed in the queue.
+ * @param backend - The storage of the queue.
+ * @return
+ * NULL in case of memory allocation fails, if maxSize < 0 or if backend
+ * is not a valid backend.
+ * Otherwise a new empty queue with size bound of maxSize.
+ */
+SPBPQueue spBPQueueCreateWithBackend(int maxSize, SP_BPQUEUE_BACKEND backend);
+
+/**
+ * Creates a new Bounded priority queue with bounded size, stored in the
+ * SP_BPQUEUE_LIST_BACKEND backend with nodes taken from a shared pool.
+ * Queues which are created and destroyed often (for example one per query)
+ * can share a pool, so their nodes are reused instead of being allocated.
+ *
+ * @param maxSize - The maximal number of elements allowed in the queue.
+ * @param pool    - The node pool of the queue list (see SPList.h).
+ * @return
+ * NULL in case of memory allocation fails, if maxSize < 0 or pool is NULL.
+ * Otherwise a new empty queue with size bound of maxSize.
+ */
+SPBPQueue spBPQueueCreateWithPool(int maxSize, SPListNodePool pool);
+
+/**
+ * Returns the backend in which a bounded priority queue is stored.
+ *
+ * @param source - The queue whose backend is requested.
+ * @assert source!=NULL.
+ * @return
+ * The backend of the queue.
+ */
+SP_BPQUEUE_BACKEND spBPQueueGetBackend(SPBPQueue source);
+
 /**
  * Creates a copy of target bounded priority queue.
  *
- * The new copy will contain the same elements and size bound
+ * The new copy will contain the same elements, size bound and backend
  * as the original queue.
  *
  * @param source - The source queue which will be copied.
@@ -62,6 +122,22 @@ void spBPQueueDestroy(SPBPQueue source);
  */
 void spBPQueueClear(SPBPQueue source);
 
+/**
+ * Removes all elements from target bounded priority queue and sets a new
+ * size bound, keeping the memory the queue already holds for reuse.
+ * Resetting a queue instead of destroying it and creating a new one avoids
+ * allocations when a queue is used for many short lived queries.
+ *
+ * @param source     - the queue to reset.
+ * @param newMaxSize - The new maximal number of elements allowed in the queue.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if source is NULL or newMaxSize < 0.
+ * SP_BPQUEUE_OUT_OF_MEMORY if the queue had to grow and allocation failed,
+ * in which case the queue is empty and keeps its previous size bound.
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+SP_BPQUEUE_MSG spBPQueueReset(SPBPQueue source, int newMaxSize);
+
 /**
  * Returns the number of elements in a bounded priority queue.
  *
@@ -109,6 +185,28 @@ int spBPQueueGetMaxSize(SPBPQueue source);
  */
 SP_BPQUEUE_MSG spBPQueueEnqueue(SPBPQueue source, SPListElement element);
 
+/**
+ * Adds a run of elements, given in ascending order, to the bounded priority
+ * queue. The result is the same as calling spBPQueueEnqueue for every
+ * element, but the run is merged into the queue in a single pass, and
+ * elements which cannot enter the queue are never copied.
+ * The output of spTopKSelect (see SPTopKSelect.h) is such a run.
+ *
+ * @param source  - The queue into which the elements are inserted.
+ * @param indices - The indices of the elements (indices[i] >= 0).
+ * @param values  - The values of the elements (values[i] >= 0.0).
+ * @param n       - The number of elements in the run.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if source, indices or values are NULL, n < 0,
+ * an index or a value are negative, or the run is not in ascending order.
+ * SP_BPQUEUE_OUT_OF_MEMORY if an allocation failed.
+ * SP_BPQUEUE_FULL if all elements have been handled and the queue overflowed,
+ * so some elements were removed from the queue or were not inserted.
+ * SP_BPQUEUE_SUCCESS all the elements have been inserted successfully.
+ */
+SP_BPQUEUE_MSG spBPQueueEnqueueSorted(SPBPQueue source, const int* indices,
+		const double* values, int n);
+
 /**
  * Removes the currently lowest priority element in the queue.
  *
@@ -160,6 +258,21 @@ double spBPQueueMinValue(SPBPQueue source);
  */
 double spBPQueueMaxValue(SPBPQueue source);
 
+/**
+ * Copies the indices and values of all the elements of the queue, in
+ * ascending order, to two arrays. The queue is not modified.
+ *
+ * @param source  - The source queue.
+ * @param indices - An array of at least spBPQueueSize(source) ints, which
+ * receives the indices.
+ * @param values  - An array of at least spBPQueueSize(source) doubles, which
+ * receives the values.
+ * @return
+ * -1 if a NULL pointer was sent or an allocation failed.
+ * Otherwise the number of elements copied.
+ */
+int spBPQueueToArray(SPBPQueue source, int* indices, double* values);
+
 /**
  * Returns True if the queue is empty.
  *
@@ -0,0 +1,244 @@
+#define _POSIX_C_SOURCE 200809L
+#include "SPConcurrentBPQueue.h"
+#include "SPBPriorityQueue.h"
+#include "SPListElement.h"
+#include <pthread.h> // pthread_mutex_t, pthread_mutex_lock, pthread_mutex_unlock
+#include <stdint.h> // uint64_t
+#include <stdlib.h> // malloc, free, NULL
+#include <string.h> // memcpy
+#include <math.h> // HUGE_VAL
+
+struct sp_concurrent_bp_queue_t {
+	SPBPQueue queue; // The protected queue
+	SPListElement scratch; // Element reused for insertions, guarded by lock
+	pthread_mutex_t lock;
+	uint64_t bound; // Bit pattern of the pruning bound, accessed atomically
+};
+
+struct sp_concurrent_bp_queue_stage_t {
+	SPConcurrentBPQueue queue;
+	int capacity;
+	int count;
+	int* indices;
+	double* values;
+};
+
+// Helper functions
+static uint64_t doubleToBits(double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static double bitsToDouble(uint64_t bits) {
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static double loadBound(SPConcurrentBPQueue source) {
+	return bitsToDouble(__atomic_load_n(&source->bound, __ATOMIC_ACQUIRE));
+}
+
+// Must be called while holding the lock
+static void publishBound(SPConcurrentBPQueue source) {
+	double bound = HUGE_VAL;
+	if (spBPQueueIsFull(source->queue)) {
+		bound = spBPQueueMaxValue(source->queue);
+	}
+	__atomic_store_n(&source->bound, doubleToBits(bound), __ATOMIC_RELEASE);
+}
+
+// Must be called while holding the lock
+static SP_BPQUEUE_MSG offerLocked(SPConcurrentBPQueue source, int index, double value) {
+	if (spBPQueueIsFull(source->queue) && value > spBPQueueMaxValue(source->queue)) {
+		return SP_BPQUEUE_FULL; // The bound moved since it was read
+	}
+	spListElementSetIndex(source->scratch, index);
+	spListElementSetValue(source->scratch, value);
+	return spBPQueueEnqueue(source->queue, source->scratch);
+}
+
+SPConcurrentBPQueue spConcurrentBPQueueCreate(int maxSize) {
+	// Function variables
+	SPConcurrentBPQueue source;
+	// Function code
+	if (maxSize < 0) {
+		return NULL; // Invalid parameters
+	}
+	source = (SPConcurrentBPQueue) malloc(sizeof(struct sp_concurrent_bp_queue_t));
+	if (source == NULL) { // Allocation Fails
+		return NULL;
+	}
+	source->queue = spBPQueueCreate(maxSize);
+	source->scratch = spListElementCreate(0, 0.0);
+	if (source->queue == NULL || source->scratch == NULL) { // Allocation Fails
+		spBPQueueDestroy(source->queue);
+		spListElementDestroy(source->scratch);
+		free(source);
+		return NULL;
+	}
+	if (pthread_mutex_init(&source->lock, NULL) != 0) {
+		spBPQueueDestroy(source->queue);
+		spListElementDestroy(source->scratch);
+		free(source);
+		return NULL;
+	}
+	publishBound(source);
+	return source;
+}
+
+void spConcurrentBPQueueDestroy(SPConcurrentBPQueue source) {
+	if (source != NULL) {
+		pthread_mutex_destroy(&source->lock);
+		spBPQueueDestroy(source->queue);
+		spListElementDestroy(source->scratch);
+		free(source);
+	}
+}
+
+SP_BPQUEUE_MSG spConcurrentBPQueueOffer(SPConcurrentBPQueue source, int index,
+		double value) {
+	// Function variables
+	SP_BPQUEUE_MSG msg;
+	// Function code
+	if (source == NULL || index < 0 || value < 0.0) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (value > loadBound(source)) { // Lock-free rejection
+		return SP_BPQUEUE_FULL;
+	}
+	pthread_mutex_lock(&source->lock);
+	msg = offerLocked(source, index, value);
+	publishBound(source);
+	pthread_mutex_unlock(&source->lock);
+	return msg;
+}
+
+SP_BPQUEUE_MSG spConcurrentBPQueueEnqueue(SPConcurrentBPQueue source,
+		SPListElement element) {
+	if (source == NULL || element == NULL) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	return spConcurrentBPQueueOffer(source, spListElementGetIndex(element),
+			spListElementGetValue(element));
+}
+
+double spConcurrentBPQueueBound(SPConcurrentBPQueue source) {
+	if (source == NULL) {
+		return -1.0;
+	} else {
+		return loadBound(source);
+	}
+}
+
+int spConcurrentBPQueueSize(SPConcurrentBPQueue source) {
+	// Function variables
+	int size;
+	// Function code
+	if (source == NULL) {
+		return -1;
+	}
+	pthread_mutex_lock(&source->lock);
+	size = spBPQueueSize(source->queue);
+	pthread_mutex_unlock(&source->lock);
+	return size;
+}
+
+int spConcurrentBPQueueGetMaxSize(SPConcurrentBPQueue source) {
+	if (source == NULL) {
+		return -1;
+	} else {
+		return spBPQueueGetMaxSize(source->queue); // Immutable, no lock needed
+	}
+}
+
+SPBPQueue spConcurrentBPQueueSnapshot(SPConcurrentBPQueue source) {
+	// Function variables
+	SPBPQueue snapshot;
+	// Function code
+	if (source == NULL) {
+		return NULL;
+	}
+	pthread_mutex_lock(&source->lock);
+	snapshot = spBPQueueCopy(source->queue);
+	pthread_mutex_unlock(&source->lock);
+	return snapshot;
+}
+
+SPConcurrentBPQueueStage spConcurrentBPQueueStageCreate(
+		SPConcurrentBPQueue queue, int capacity) {
+	// Function variables
+	SPConcurrentBPQueueStage stage;
+	// Function code
+	if (queue == NULL || capacity <= 0) {
+		return NULL; // Invalid parameters
+	}
+	stage = (SPConcurrentBPQueueStage) malloc(sizeof(struct sp_concurrent_bp_queue_stage_t));
+	if (stage == NULL) { // Allocation Fails
+		return NULL;
+	}
+	stage->indices = (int*) malloc(sizeof(int)*capacity);
+	stage->values = (double*) malloc(sizeof(double)*capacity);
+	if (stage->indices == NULL || stage->values == NULL) { // Allocation Fails
+		free(stage->indices);
+		free(stage->values);
+		free(stage);
+		return NULL;
+	}
+	stage->queue = queue;
+	stage->capacity = capacity;
+	stage->count = 0;
+	return stage;
+}
+
+SP_BPQUEUE_MSG spConcurrentBPQueueStageOffer(SPConcurrentBPQueueStage stage,
+		int index, double value) {
+	if (stage == NULL || index < 0 || value < 0.0) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (value > loadBound(stage->queue)) { // Lock-free rejection
+		return SP_BPQUEUE_FULL;
+	}
+	stage->indices[stage->count] = index;
+	stage->values[stage->count] = value;
+	stage->count++;
+	if (stage->count == stage->capacity) {
+		return spConcurrentBPQueueStageFlush(stage);
+	}
+	return SP_BPQUEUE_SUCCESS;
+}
+
+SP_BPQUEUE_MSG spConcurrentBPQueueStageFlush(SPConcurrentBPQueueStage stage) {
+	// Function variables
+	SP_BPQUEUE_MSG msg = SP_BPQUEUE_SUCCESS;
+	SPConcurrentBPQueue queue;
+	int i; // Generic loop variable
+	// Function code
+	if (stage == NULL) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (stage->count == 0) {
+		return SP_BPQUEUE_SUCCESS;
+	}
+	queue = stage->queue;
+	pthread_mutex_lock(&queue->lock);
+	for (i = 0; i < stage->count; i++) {
+		if (offerLocked(queue, stage->indices[i], stage->values[i]) == SP_BPQUEUE_OUT_OF_MEMORY) {
+			msg = SP_BPQUEUE_OUT_OF_MEMORY;
+		}
+	}
+	publishBound(queue);
+	pthread_mutex_unlock(&queue->lock);
+	stage->count = 0;
+	return msg;
+}
+
+void spConcurrentBPQueueStageDestroy(SPConcurrentBPQueueStage stage) {
+	if (stage != NULL) {
+		spConcurrentBPQueueStageFlush(stage);
+		free(stage->indices);
+		free(stage->values);
+		free(stage);
+	}
+}
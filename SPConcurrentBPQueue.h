@@ -0,0 +1,190 @@
+#ifndef SPCONCURRENTBPQUEUE_H_
+#define SPCONCURRENTBPQUEUE_H_
+#include "SPBPriorityQueue.h"
+#include "SPListElement.h"
+#include <stdbool.h>
+/**
+ * SP Concurrent Bounded Priority Queue summary
+ *
+ * A bounded priority queue which can be shared by many worker threads.
+ * The queue keeps the same ordering as SPBPQueue (see SPBPriorityQueue.h),
+ * and protects the underlying queue with a mutex.
+ *
+ * Once the queue is full, the value of its highest priority element (the
+ * pruning bound) is published through an atomic variable. A candidate whose
+ * value is strictly greater than the bound can never enter the queue, so it
+ * is rejected without taking the lock. Only candidates which may enter the
+ * queue pay for the lock.
+ *
+ * Workers which produce many candidates should use a staging buffer
+ * (SPConcurrentBPQueueStage). A stage is owned by a single thread, filters
+ * candidates against the bound and merges them into the shared queue in
+ * batches, taking the lock once per batch instead of once per candidate.
+ *
+ * The following functions are available:
+ *
+ *   spConcurrentBPQueueCreate       - Creates a new empty shared queue
+ *   spConcurrentBPQueueDestroy      - Frees all resources of a shared queue
+ *   spConcurrentBPQueueOffer        - Offers an (index, value) candidate
+ *   spConcurrentBPQueueEnqueue      - Offers an element as a candidate
+ *   spConcurrentBPQueueBound        - Returns the current pruning bound
+ *   spConcurrentBPQueueSize         - Returns the number of elements
+ *   spConcurrentBPQueueGetMaxSize   - Returns the size bound of the queue
+ *   spConcurrentBPQueueSnapshot     - Returns a private SPBPQueue copy
+ *   spConcurrentBPQueueStageCreate  - Creates a per-thread staging buffer
+ *   spConcurrentBPQueueStageOffer   - Offers a candidate through a stage
+ *   spConcurrentBPQueueStageFlush   - Merges a stage into the shared queue
+ *   spConcurrentBPQueueStageDestroy - Flushes and frees a stage
+ */
+
+/** type used to define a shared bounded priority queue **/
+typedef struct sp_concurrent_bp_queue_t* SPConcurrentBPQueue;
+
+/** type used to define a per-thread staging buffer of a shared queue **/
+typedef struct sp_concurrent_bp_queue_stage_t* SPConcurrentBPQueueStage;
+
+/**
+ * Creates a new shared bounded priority queue with bounded size.
+ *
+ * @param maxSize - The maximal number of elements allowed in the queue.
+ * @return
+ * NULL in case of memory allocation fails or if maxSize < 0.
+ * Otherwise a new empty shared queue with size bound of maxSize.
+ */
+SPConcurrentBPQueue spConcurrentBPQueueCreate(int maxSize);
+
+/**
+ * Destroys a shared bounded priority queue.
+ * The caller must make sure no other thread uses the queue, and that all
+ * of its stages were destroyed before.
+ *
+ * @param source - the queue which will be freed.
+ * if source is NULL, then nothing is done.
+ */
+void spConcurrentBPQueueDestroy(SPConcurrentBPQueue source);
+
+/**
+ * Offers a candidate to the shared queue. May be called concurrently from
+ * any number of threads.
+ *
+ * If the queue is full and value is greater than the pruning bound, the
+ * candidate is rejected without locking.
+ *
+ * @param source - The queue into which the candidate is offered.
+ * @param index  - The index of the candidate (index >= 0).
+ * @param value  - The value of the candidate (value >= 0.0).
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if source is NULL, index < 0 or value < 0.
+ * SP_BPQUEUE_OUT_OF_MEMORY if an allocation failed.
+ * SP_BPQUEUE_FULL if the queue was full, so the candidate or the highest
+ * priority element is not in the queue afterwards.
+ * SP_BPQUEUE_SUCCESS the candidate has been inserted successfully.
+ */
+SP_BPQUEUE_MSG spConcurrentBPQueueOffer(SPConcurrentBPQueue source, int index,
+		double value);
+
+/**
+ * Offers an element to the shared queue, same as spConcurrentBPQueueOffer.
+ *
+ * @param source  - The queue into which the element is offered.
+ * @param element - The element to offer. A copy of the element is inserted.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if source or element are NULL.
+ * Otherwise same as spConcurrentBPQueueOffer.
+ */
+SP_BPQUEUE_MSG spConcurrentBPQueueEnqueue(SPConcurrentBPQueue source,
+		SPListElement element);
+
+/**
+ * Returns the current pruning bound of the queue. The read is lock-free.
+ *
+ * @param source - The queue whose bound is requested.
+ * @return
+ * -1.0 if source is NULL.
+ * HUGE_VAL if the queue is not full (any candidate may enter).
+ * Otherwise the value of the highest priority element in the queue.
+ */
+double spConcurrentBPQueueBound(SPConcurrentBPQueue source);
+
+/**
+ * Returns the number of elements in the shared queue.
+ *
+ * @param source - The queue whose number of elements requested.
+ * @return
+ * -1 if a NULL pointer was sent.
+ * Otherwise the number of elements in the queue.
+ */
+int spConcurrentBPQueueSize(SPConcurrentBPQueue source);
+
+/**
+ * Returns the maximal number of elements allowed in the shared queue.
+ *
+ * @param source - The queue whose maximal size requested.
+ * @return
+ * -1 if a NULL pointer was sent.
+ * Otherwise the size bound of the queue.
+ */
+int spConcurrentBPQueueGetMaxSize(SPConcurrentBPQueue source);
+
+/**
+ * Returns a private copy of the shared queue, taken atomically with respect
+ * to concurrent offers. The copy may be used with all SPBPQueue functions and
+ * must be destroyed by the caller using spBPQueueDestroy.
+ *
+ * @param source - The queue to copy.
+ * @return
+ * NULL if source is NULL or memory allocation failed.
+ * Otherwise a new SPBPQueue holding the elements of the shared queue.
+ */
+SPBPQueue spConcurrentBPQueueSnapshot(SPConcurrentBPQueue source);
+
+/**
+ * Creates a staging buffer for the shared queue. A stage must only be used
+ * by a single thread at a time.
+ *
+ * @param queue    - The shared queue the stage is flushed into.
+ * @param capacity - The number of candidates buffered before a flush.
+ * @return
+ * NULL if queue is NULL, capacity <= 0 or memory allocation failed.
+ * Otherwise a new empty stage.
+ */
+SPConcurrentBPQueueStage spConcurrentBPQueueStageCreate(
+		SPConcurrentBPQueue queue, int capacity);
+
+/**
+ * Offers a candidate through a stage. Candidates worse than the pruning bound
+ * are rejected without locking; others are buffered, and the stage is flushed
+ * into the shared queue when it becomes full.
+ *
+ * @param stage - The stage of the calling thread.
+ * @param index - The index of the candidate (index >= 0).
+ * @param value - The value of the candidate (value >= 0.0).
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if stage is NULL, index < 0 or value < 0.
+ * SP_BPQUEUE_OUT_OF_MEMORY if an allocation failed during a flush.
+ * SP_BPQUEUE_FULL if the candidate was rejected by the pruning bound.
+ * SP_BPQUEUE_SUCCESS if the candidate was buffered.
+ */
+SP_BPQUEUE_MSG spConcurrentBPQueueStageOffer(SPConcurrentBPQueueStage stage,
+		int index, double value);
+
+/**
+ * Merges all buffered candidates of a stage into the shared queue, taking
+ * the queue lock once.
+ *
+ * @param stage - The stage to flush.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if stage is NULL.
+ * SP_BPQUEUE_OUT_OF_MEMORY if an allocation failed.
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+SP_BPQUEUE_MSG spConcurrentBPQueueStageFlush(SPConcurrentBPQueueStage stage);
+
+/**
+ * Flushes a stage into its shared queue and frees it.
+ *
+ * @param stage - The stage to free. If stage is NULL nothing is done.
+ */
+void spConcurrentBPQueueStageDestroy(SPConcurrentBPQueueStage stage);
+
+#endif
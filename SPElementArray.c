@@ -0,0 +1,529 @@
+#define _POSIX_C_SOURCE 200809L
+#include "SPElementArray.h"
+#include <pthread.h> // pthread_create, pthread_join
+#include <stdint.h> // uint32_t, uint64_t
+#include <stdlib.h> // posix_memalign, free, qsort, NULL
+#include <string.h> // memcpy, memset
+
+#define SP_ELEMENT_ARRAY_MIN_CAPACITY 8
+#define SP_ELEMENT_ARRAY_RADIX_BITS 11
+#define SP_ELEMENT_ARRAY_RADIX_SIZE (1 << SP_ELEMENT_ARRAY_RADIX_BITS)
+#define SP_ELEMENT_ARRAY_INDEX_DIGITS 3 // The low digits of the key, 32 index bits
+#define SP_ELEMENT_ARRAY_KEY_DIGITS 9 // And 64 value bits
+#define SP_ELEMENT_ARRAY_RADIX_MIN_SIZE 64 // Smaller arrays use insertion sort
+#define SP_ELEMENT_ARRAY_MIN_THREAD_SIZE 65536 // Elements sorted by each thread
+#define SP_ELEMENT_ARRAY_MAX_THREADS 64
+
+struct sp_element_array_t {
+	SPElement* data; // Aligned to SP_ELEMENT_ARRAY_ALIGNMENT
+	int size;
+	int capacity;
+};
+
+// Same relation as spListElementCompare, without branches
+static int elementCompare(const void* p1, const void* p2) {
+	const SPElement* e1 = (const SPElement*) p1;
+	const SPElement* e2 = (const SPElement*) p2;
+	int order = 2 * ((e1->value > e2->value) - (e1->value < e2->value))
+			+ ((e1->index > e2->index) - (e1->index < e2->index));
+	return (order > 0) - (order < 0);
+}
+
+// Moves the elements to a new aligned block of at least capacity elements
+static bool arrayReserve(SPElementArray array, int capacity) {
+	// Function variables
+	void* data;
+	int newCapacity = array->capacity > 0 ? array->capacity : SP_ELEMENT_ARRAY_MIN_CAPACITY;
+	// Function code
+	if (capacity <= array->capacity) {
+		return true;
+	}
+	while (newCapacity < capacity) {
+		newCapacity *= 2;
+	}
+	if (posix_memalign(&data, SP_ELEMENT_ARRAY_ALIGNMENT, sizeof(SPElement)*newCapacity) != 0) {
+		return false;
+	}
+	if (array->size > 0) {
+		memcpy(data, array->data, sizeof(SPElement)*array->size);
+	}
+	free(array->data);
+	array->data = (SPElement*) data;
+	array->capacity = newCapacity;
+	return true;
+}
+
+SPElementArray spElementArrayCreate(int capacity) {
+	// Function variables
+	SPElementArray array;
+	// Function code
+	if (capacity < 0) {
+		return NULL;
+	}
+	array = (SPElementArray) malloc(sizeof(struct sp_element_array_t));
+	if (array == NULL) { // Allocation Fails
+		return NULL;
+	}
+	array->data = NULL;
+	array->size = 0;
+	array->capacity = 0;
+	if (!arrayReserve(array, capacity > 0 ? capacity : 1)) { // Allocation Fails
+		free(array);
+		return NULL;
+	}
+	return array;
+}
+
+void spElementArrayDestroy(SPElementArray array) {
+	if (array != NULL) {
+		free(array->data);
+		free(array);
+	}
+}
+
+SPElementArray spElementArrayCopy(SPElementArray array) {
+	if (array == NULL) {
+		return NULL;
+	}
+	return spElementArraySlice(array, 0, array->size);
+}
+
+SPElementArray spElementArraySlice(SPElementArray array, int begin, int end) {
+	// Function variables
+	SPElementArray slice;
+	// Function code
+	if (array == NULL || begin < 0 || begin > end || end > array->size) {
+		return NULL;
+	}
+	slice = spElementArrayCreate(end - begin);
+	if (slice == NULL) { // Allocation Fails
+		return NULL;
+	}
+	if (end > begin) {
+		memcpy(slice->data, array->data + begin, sizeof(SPElement)*(end - begin));
+	}
+	slice->size = end - begin;
+	return slice;
+}
+
+int spElementArrayGetSize(SPElementArray array) {
+	return array == NULL ? -1 : array->size;
+}
+
+SPElement* spElementArrayGetData(SPElementArray array) {
+	return array == NULL ? NULL : array->data;
+}
+
+SPElement* spElementArrayGetAt(SPElementArray array, int i) {
+	if (array == NULL || i < 0 || i >= array->size) {
+		return NULL;
+	}
+	return &array->data[i];
+}
+
+SP_ELEMENT_ARRAY_MSG spElementArrayAppend(SPElementArray array, SPElement element) {
+	if (array == NULL) {
+		return SP_ELEMENT_ARRAY_INVALID_ARGUMENT;
+	}
+	if (array->size == array->capacity && !arrayReserve(array, array->size + 1)) {
+		return SP_ELEMENT_ARRAY_OUT_OF_MEMORY;
+	}
+	array->data[array->size++] = element;
+	return SP_ELEMENT_ARRAY_SUCCESS;
+}
+
+SP_ELEMENT_ARRAY_MSG spElementArrayAppendListElement(SPElementArray array,
+		SPListElement element) {
+	// Function variables
+	SPElement copy;
+	// Function code
+	if (array == NULL || element == NULL) {
+		return SP_ELEMENT_ARRAY_INVALID_ARGUMENT;
+	}
+	copy.index = spListElementGetIndex(element);
+	copy.value = spListElementGetValue(element);
+	return spElementArrayAppend(array, copy);
+}
+
+void spElementArrayClear(SPElementArray array) {
+	if (array != NULL) {
+		array->size = 0;
+	}
+}
+
+/*
+ * Radix sort helpers.
+ * The key of an element is its value bits followed by its index bits, both
+ * mapped to unsigned integers which order as the value and the index do. The
+ * digits of the key are sorted from the least significant one, so the value
+ * decides the order and the index breaks ties.
+ */
+
+static uint64_t valueKey(double value) {
+	uint64_t bits;
+	if (value == 0.0) {
+		value = 0.0; // -0.0 is equal to 0.0
+	}
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits >> 63) ? ~bits : bits | ((uint64_t) 1 << 63);
+}
+
+static uint32_t indexKey(int index) {
+	return ((uint32_t) index) ^ 0x80000000u;
+}
+
+static unsigned int keyDigit(const SPElement* element, int digit) {
+	if (digit < SP_ELEMENT_ARRAY_INDEX_DIGITS) {
+		return (indexKey(element->index) >> (digit * SP_ELEMENT_ARRAY_RADIX_BITS))
+				& (SP_ELEMENT_ARRAY_RADIX_SIZE - 1);
+	}
+	return (valueKey(element->value) >> ((digit - SP_ELEMENT_ARRAY_INDEX_DIGITS)
+			* SP_ELEMENT_ARRAY_RADIX_BITS)) & (SP_ELEMENT_ARRAY_RADIX_SIZE - 1);
+}
+
+static void insertionSort(SPElement* data, int n) {
+	// Function variables
+	SPElement current;
+	int i, j; // Generic loop variables
+	// Function code
+	for (i = 1; i < n; i++) {
+		current = data[i];
+		for (j = i; j > 0 && elementCompare(&data[j-1], &current) > 0; j--) {
+			data[j] = data[j-1];
+		}
+		data[j] = current;
+	}
+}
+
+// Sorts n elements, using a scratch buffer of n elements
+static void radixSort(SPElement* data, SPElement* buffer, int n) {
+	// Function variables
+	int counts[SP_ELEMENT_ARRAY_KEY_DIGITS][SP_ELEMENT_ARRAY_RADIX_SIZE];
+	int offsets[SP_ELEMENT_ARRAY_RADIX_SIZE];
+	SPElement* from = data;
+	SPElement* to = buffer;
+	SPElement* temp;
+	uint32_t index;
+	uint64_t value;
+	int i, digit, sum; // Generic loop variables
+	// Function code
+	if (n < SP_ELEMENT_ARRAY_RADIX_MIN_SIZE) {
+		insertionSort(data, n);
+		return;
+	}
+	memset(counts, 0, sizeof(counts));
+	for (i = 0; i < n; i++) { // One pass builds the histograms of all digits
+		index = indexKey(data[i].index);
+		value = valueKey(data[i].value);
+		for (digit = 0; digit < SP_ELEMENT_ARRAY_INDEX_DIGITS; digit++) {
+			counts[digit][(index >> (digit * SP_ELEMENT_ARRAY_RADIX_BITS))
+					& (SP_ELEMENT_ARRAY_RADIX_SIZE - 1)]++;
+		}
+		for (; digit < SP_ELEMENT_ARRAY_KEY_DIGITS; digit++) {
+			counts[digit][(value >> ((digit - SP_ELEMENT_ARRAY_INDEX_DIGITS) * SP_ELEMENT_ARRAY_RADIX_BITS))
+					& (SP_ELEMENT_ARRAY_RADIX_SIZE - 1)]++;
+		}
+	}
+	for (digit = 0; digit < SP_ELEMENT_ARRAY_KEY_DIGITS; digit++) {
+		if (counts[digit][keyDigit(&from[0], digit)] == n) {
+			continue; // All the keys have the same digit
+		}
+		for (i = 0, sum = 0; i < SP_ELEMENT_ARRAY_RADIX_SIZE; i++) {
+			offsets[i] = sum;
+			sum += counts[digit][i];
+		}
+		for (i = 0; i < n; i++) {
+			to[offsets[keyDigit(&from[i], digit)]++] = from[i];
+		}
+		temp = from;
+		from = to;
+		to = temp;
+	}
+	if (from != data) {
+		memcpy(data, from, sizeof(SPElement)*n);
+	}
+}
+
+static SPElement* bufferCreate(int n) {
+	void* buffer;
+	if (posix_memalign(&buffer, SP_ELEMENT_ARRAY_ALIGNMENT, sizeof(SPElement)*(n + 1)) != 0) {
+		return NULL;
+	}
+	return (SPElement*) buffer;
+}
+
+SP_ELEMENT_ARRAY_MSG spElementArraySort(SPElementArray array) {
+	// Function variables
+	SPElement* buffer;
+	// Function code
+	if (array == NULL) {
+		return SP_ELEMENT_ARRAY_INVALID_ARGUMENT;
+	}
+	if (array->size < SP_ELEMENT_ARRAY_RADIX_MIN_SIZE) {
+		insertionSort(array->data, array->size);
+		return SP_ELEMENT_ARRAY_SUCCESS;
+	}
+	buffer = bufferCreate(array->size);
+	if (buffer == NULL) { // Allocation Fails
+		qsort(array->data, array->size, sizeof(SPElement), elementCompare);
+		return SP_ELEMENT_ARRAY_SUCCESS;
+	}
+	radixSort(array->data, buffer, array->size);
+	free(buffer);
+	return SP_ELEMENT_ARRAY_SUCCESS;
+}
+
+// A part of the array sorted or merged by one thread
+typedef struct sp_element_array_task_t {
+	SPElement* data; // The part to sort, or the first run to merge
+	SPElement* buffer; // The scratch buffer, or the merge output
+	int size; // The size of the part, or of the first run
+	int secondSize; // The size of the second run, which follows the first
+} SPElementArrayTask;
+
+static void* sortTask(void* task) {
+	SPElementArrayTask* t = (SPElementArrayTask*) task;
+	radixSort(t->data, t->buffer, t->size);
+	return NULL;
+}
+
+static void* mergeTask(void* task) {
+	// Function variables
+	SPElementArrayTask* t = (SPElementArrayTask*) task;
+	const SPElement* first = t->data;
+	const SPElement* second = t->data + t->size;
+	int i = 0, j = 0, k = 0;
+	// Function code
+	while (i < t->size && j < t->secondSize) {
+		if (elementCompare(&second[j], &first[i]) < 0) {
+			t->buffer[k++] = second[j++];
+		} else {
+			t->buffer[k++] = first[i++];
+		}
+	}
+	memcpy(t->buffer + k, first + i, sizeof(SPElement)*(t->size - i));
+	k += t->size - i;
+	memcpy(t->buffer + k, second + j, sizeof(SPElement)*(t->secondSize - j));
+	return NULL;
+}
+
+// Runs the tasks on their own threads, or on the calling thread if a thread cannot be created
+static void runTasks(void* (*function)(void*), SPElementArrayTask* tasks, int count) {
+	// Function variables
+	pthread_t threads[SP_ELEMENT_ARRAY_MAX_THREADS];
+	bool started[SP_ELEMENT_ARRAY_MAX_THREADS];
+	int i; // Generic loop variable
+	// Function code
+	for (i = 1; i < count; i++) {
+		started[i] = pthread_create(&threads[i], NULL, function, &tasks[i]) == 0;
+		if (!started[i]) {
+			function(&tasks[i]);
+		}
+	}
+	function(&tasks[0]);
+	for (i = 1; i < count; i++) {
+		if (started[i]) {
+			pthread_join(threads[i], NULL);
+		}
+	}
+}
+
+SP_ELEMENT_ARRAY_MSG spElementArraySortParallel(SPElementArray array, int threads) {
+	// Function variables
+	SPElementArrayTask tasks[SP_ELEMENT_ARRAY_MAX_THREADS];
+	int bounds[SP_ELEMENT_ARRAY_MAX_THREADS + 1];
+	SPElement* buffer;
+	SPElement* from;
+	SPElement* to;
+	SPElement* temp;
+	int runs, count, i; // Generic loop variables
+	// Function code
+	if (array == NULL || threads < 1) {
+		return SP_ELEMENT_ARRAY_INVALID_ARGUMENT;
+	}
+	if (threads > SP_ELEMENT_ARRAY_MAX_THREADS) {
+		threads = SP_ELEMENT_ARRAY_MAX_THREADS;
+	}
+	if (threads > array->size / SP_ELEMENT_ARRAY_MIN_THREAD_SIZE) {
+		threads = array->size / SP_ELEMENT_ARRAY_MIN_THREAD_SIZE;
+	}
+	if (threads <= 1) {
+		return spElementArraySort(array);
+	}
+	buffer = bufferCreate(array->size);
+	if (buffer == NULL) { // Allocation Fails
+		return spElementArraySort(array);
+	}
+	for (i = 0; i <= threads; i++) {
+		bounds[i] = (int) ((long long) array->size * i / threads);
+	}
+	for (i = 0; i < threads; i++) {
+		tasks[i].data = array->data + bounds[i];
+		tasks[i].buffer = buffer + bounds[i];
+		tasks[i].size = bounds[i+1] - bounds[i];
+	}
+	runTasks(sortTask, tasks, threads);
+	from = array->data;
+	to = buffer;
+	for (runs = threads; runs > 1; runs = (runs + 1) / 2) { // Merge the runs pairwise
+		for (i = 0, count = 0; i < runs; i += 2, count++) {
+			tasks[count].data = from + bounds[i];
+			tasks[count].buffer = to + bounds[i];
+			tasks[count].size = bounds[i+1] - bounds[i];
+			tasks[count].secondSize = i + 1 < runs ? bounds[i+2] - bounds[i+1] : 0;
+		}
+		runTasks(mergeTask, tasks, count);
+		for (i = 0; 2 * i <= runs; i++) { // The bounds of the merged runs
+			bounds[i] = bounds[2 * i < runs ? 2 * i : runs];
+		}
+		bounds[(runs + 1) / 2] = array->size;
+		temp = from;
+		from = to;
+		to = temp;
+	}
+	if (from != array->data) {
+		memcpy(array->data, from, sizeof(SPElement)*array->size);
+	}
+	free(buffer);
+	return SP_ELEMENT_ARRAY_SUCCESS;
+}
+
+SPElementArray spElementArrayFromList(SPList list) {
+	// Function variables
+	SPElementArray array;
+	SPListIter iter;
+	SPListElement current;
+	// Function code
+	if (list == NULL) {
+		return NULL;
+	}
+	array = spElementArrayCreate(spListGetSize(list));
+	if (array == NULL) { // Allocation Fails
+		return NULL;
+	}
+	for (iter = spListIterBegin(list); (current = spListIterGet(&iter)) != NULL;
+			spListIterNext(&iter)) {
+		array->data[array->size].index = spListElementGetIndex(current);
+		array->data[array->size].value = spListElementGetValue(current);
+		array->size++;
+	}
+	return array;
+}
+
+SPList spElementArrayToList(SPElementArray array, SP_LIST_BACKEND backend) {
+	// Function variables
+	SPList list;
+	SPListElement scratch;
+	int i; // Generic loop variable
+	// Function code
+	if (array == NULL) {
+		return NULL;
+	}
+	list = spListCreateWithBackend(backend);
+	scratch = spListElementCreate(0, 0.0);
+	if (list == NULL || scratch == NULL) { // Allocation Fails or invalid backend
+		spListDestroy(list);
+		spListElementDestroy(scratch);
+		return NULL;
+	}
+	for (i = 0; i < array->size; i++) {
+		spListElementSetIndex(scratch, array->data[i].index);
+		spListElementSetValue(scratch, array->data[i].value);
+		if (spListInsertLast(list, scratch) != SP_LIST_SUCCESS) { // Allocation Fails
+			spListDestroy(list);
+			list = NULL;
+			break;
+		}
+	}
+	spListElementDestroy(scratch);
+	return list;
+}
+
+SPElementArray spElementArrayFromBPQueue(SPBPQueue queue) {
+	// Function variables
+	SPElementArray array;
+	int* indices;
+	double* values;
+	int size = spBPQueueSize(queue);
+	int i; // Generic loop variable
+	// Function code
+	if (queue == NULL) {
+		return NULL;
+	}
+	array = spElementArrayCreate(size);
+	indices = (int*) malloc(sizeof(int)*(size + 1));
+	values = (double*) malloc(sizeof(double)*(size + 1));
+	if (array == NULL || indices == NULL || values == NULL
+			|| spBPQueueToArray(queue, indices, values) != size) { // Allocation Fails
+		spElementArrayDestroy(array);
+		free(indices);
+		free(values);
+		return NULL;
+	}
+	for (i = 0; i < size; i++) {
+		array->data[i].index = indices[i];
+		array->data[i].value = values[i];
+	}
+	array->size = size;
+	free(indices);
+	free(values);
+	return array;
+}
+
+// Merges a sorted array into the queue with spBPQueueEnqueueSorted
+static SP_BPQUEUE_MSG enqueueSorted(SPElementArray array, SPBPQueue queue) {
+	// Function variables
+	SP_BPQUEUE_MSG msg = SP_BPQUEUE_OUT_OF_MEMORY;
+	int* indices = (int*) malloc(sizeof(int)*array->size);
+	double* values = (double*) malloc(sizeof(double)*array->size);
+	int i; // Generic loop variable
+	// Function code
+	if (indices != NULL && values != NULL) {
+		for (i = 0; i < array->size; i++) {
+			indices[i] = array->data[i].index;
+			values[i] = array->data[i].value;
+		}
+		msg = spBPQueueEnqueueSorted(queue, indices, values, array->size);
+	}
+	free(indices);
+	free(values);
+	return msg;
+}
+
+SP_BPQUEUE_MSG spElementArrayToBPQueue(SPElementArray array, SPBPQueue queue) {
+	// Function variables
+	SPListElement scratch;
+	SP_BPQUEUE_MSG msg, result = SP_BPQUEUE_SUCCESS;
+	bool sorted = true;
+	int i; // Generic loop variable
+	// Function code
+	if (array == NULL || queue == NULL) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	for (i = 0; i < array->size; i++) { // Validate the whole array before changing the queue
+		if (array->data[i].index < 0 || !(array->data[i].value >= 0.0)) {
+			return SP_BPQUEUE_INVALID_ARGUMENT;
+		}
+		sorted = sorted && (i == 0 || elementCompare(&array->data[i-1], &array->data[i]) <= 0);
+	}
+	if (sorted && array->size > 0) {
+		return enqueueSorted(array, queue);
+	}
+	scratch = spListElementCreate(0, 0.0);
+	if (scratch == NULL) { // Allocation Fails
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	for (i = 0; i < array->size; i++) {
+		spListElementSetIndex(scratch, array->data[i].index);
+		spListElementSetValue(scratch, array->data[i].value);
+		msg = spBPQueueEnqueue(queue, scratch);
+		if (msg == SP_BPQUEUE_OUT_OF_MEMORY) {
+			result = msg;
+			break;
+		} else if (msg == SP_BPQUEUE_FULL) {
+			result = msg;
+		}
+	}
+	spListElementDestroy(scratch);
+	return result;
+}
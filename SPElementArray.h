@@ -0,0 +1,261 @@
+#ifndef SPELEMENTARRAY_H_
+#define SPELEMENTARRAY_H_
+
+#include <stdbool.h>
+#include "SPListElement.h"
+#include "SPList.h"
+#include "SPBPriorityQueue.h"
+/**
+ * Element Array Summary
+ *
+ * SPListElement is an opaque pointer, so a collection of SPListElement is an
+ * array of pointers to separately allocated elements. SPElement is a public
+ * (index, value) pair which is handled by value, and SPElementArray is a
+ * growable array which stores SPElement values contiguously, so a result set
+ * can be scanned, sorted and passed between the stages of a pipeline as one
+ * block of memory.
+ *
+ * The storage of an array is aligned to SP_ELEMENT_ARRAY_ALIGNMENT bytes (a
+ * cache line), and grows by doubling. Elements are ordered by the
+ * spListElementCompare relation:
+ *
+ * Element e1 is lower than element e2 iff:
+ * 		(e1.value < e2.value)   OR (e1.value == e2.value AND e1.index < e2.index)
+ *
+ * The following functions are available:
+ *
+ *   spElementArrayCreate          - Creates a new empty array
+ *   spElementArrayDestroy         - Frees all the memory of an array
+ *   spElementArrayCopy            - Copies an array
+ *   spElementArraySlice           - Copies a range of an array to a new array
+ *   spElementArrayGetSize         - Returns the number of elements
+ *   spElementArrayGetData         - Returns the storage of the elements
+ *   spElementArrayGetAt           - Returns the element at a given position
+ *   spElementArrayAppend          - Appends an element
+ *   spElementArrayAppendListElement - Appends a copy of an SPListElement
+ *   spElementArrayClear           - Removes all the elements
+ *   spElementArraySort            - Sorts the elements in ascending order
+ *   spElementArraySortParallel    - Sorts the elements in ascending order using
+ *                                   several threads
+ *   spElementArrayFromList        - Creates an array holding the elements of a
+ *                                   list
+ *   spElementArrayToList          - Creates a list holding the elements of an
+ *                                   array
+ *   spElementArrayFromBPQueue     - Creates an array holding the elements of a
+ *                                   bounded priority queue, in ascending order
+ *   spElementArrayToBPQueue       - Enqueues the elements of an array into a
+ *                                   bounded priority queue
+ */
+
+/** The alignment in bytes of the storage of an element array **/
+#define SP_ELEMENT_ARRAY_ALIGNMENT 64
+
+/** An (index, value) pair stored by value **/
+typedef struct sp_element_t {
+	int index;
+	double value;
+} SPElement;
+
+/** Type for defining the element array **/
+typedef struct sp_element_array_t* SPElementArray;
+
+/** Type used for returning error codes from element array functions **/
+typedef enum sp_element_array_msg_t {
+	SP_ELEMENT_ARRAY_SUCCESS,
+	SP_ELEMENT_ARRAY_INVALID_ARGUMENT,
+	SP_ELEMENT_ARRAY_OUT_OF_MEMORY
+} SP_ELEMENT_ARRAY_MSG;
+
+/**
+ * Allocates a new empty element array.
+ *
+ * @param capacity The number of elements for which memory is reserved
+ * (capacity >= 0). The array grows as needed past this number.
+ * @return
+ * NULL if capacity < 0 or an allocation failed.
+ * A new empty array otherwise.
+ */
+SPElementArray spElementArrayCreate(int capacity);
+
+/**
+ * Deallocates an element array.
+ *
+ * @param array The array to free. If array is NULL nothing is done.
+ */
+void spElementArrayDestroy(SPElementArray array);
+
+/**
+ * Creates a copy of an element array.
+ *
+ * @param array The array to copy
+ * @return
+ * NULL if a NULL was sent or an allocation failed.
+ * A new array holding the same elements otherwise.
+ */
+SPElementArray spElementArrayCopy(SPElementArray array);
+
+/**
+ * Creates a new array holding a copy of the elements in positions
+ * [begin, end) of an array.
+ *
+ * @param array The source array
+ * @param begin The position of the first element to copy
+ * @param end The position after the last element to copy
+ * @return
+ * NULL if array is NULL, the range is not inside [0, size] or begin > end,
+ * or an allocation failed.
+ * A new array holding end - begin elements otherwise.
+ */
+SPElementArray spElementArraySlice(SPElementArray array, int begin, int end);
+
+/**
+ * Returns the number of elements in an array.
+ *
+ * @param array The target array
+ * @return
+ * -1 if a NULL pointer was sent.
+ * The number of elements otherwise.
+ */
+int spElementArrayGetSize(SPElementArray array);
+
+/**
+ * Returns the storage of an array, holding spElementArrayGetSize(array)
+ * consecutive elements. The pointer is aligned to SP_ELEMENT_ARRAY_ALIGNMENT
+ * bytes, and is valid until the array grows or is destroyed.
+ *
+ * @param array The target array
+ * @return
+ * NULL if a NULL pointer was sent.
+ * The storage of the array otherwise.
+ */
+SPElement* spElementArrayGetData(SPElementArray array);
+
+/**
+ * Returns a pointer to the element at a given position. The pointer is
+ * valid until the array grows or is destroyed.
+ *
+ * @param array The target array
+ * @param i The position of the element (counting from 0)
+ * @return
+ * NULL if array is NULL or i is not in the range [0, size).
+ * The i-th element otherwise.
+ */
+SPElement* spElementArrayGetAt(SPElementArray array, int i);
+
+/**
+ * Appends an element to the end of an array.
+ *
+ * @param array The target array
+ * @param element The element to append
+ * @return
+ * SP_ELEMENT_ARRAY_INVALID_ARGUMENT if array is NULL
+ * SP_ELEMENT_ARRAY_OUT_OF_MEMORY if an allocation failed
+ * SP_ELEMENT_ARRAY_SUCCESS the element has been appended successfully
+ */
+SP_ELEMENT_ARRAY_MSG spElementArrayAppend(SPElementArray array, SPElement element);
+
+/**
+ * Appends a copy of the index and value of an SPListElement to the end of an
+ * array.
+ *
+ * @param array The target array
+ * @param element The element to append
+ * @return
+ * SP_ELEMENT_ARRAY_INVALID_ARGUMENT if array or element are NULL
+ * SP_ELEMENT_ARRAY_OUT_OF_MEMORY if an allocation failed
+ * SP_ELEMENT_ARRAY_SUCCESS the element has been appended successfully
+ */
+SP_ELEMENT_ARRAY_MSG spElementArrayAppendListElement(SPElementArray array,
+		SPListElement element);
+
+/**
+ * Removes all the elements of an array, keeping its memory.
+ *
+ * @param array The target array. If array is NULL nothing is done.
+ */
+void spElementArrayClear(SPElementArray array);
+
+/**
+ * Sorts the elements of an array in ascending order.
+ *
+ * The sort is an LSD radix sort over a 96 bit key: the bit pattern of the
+ * value, mapped so that it orders as the value does, followed by the index.
+ * Byte positions in which all the keys agree (such as the exponent bits of
+ * values in a narrow range) are skipped. The result is exactly the
+ * spListElementCompare order. Small arrays, and arrays for which the scratch
+ * buffer cannot be allocated, are sorted by comparisons instead.
+ *
+ * @param array The target array
+ * @return
+ * SP_ELEMENT_ARRAY_INVALID_ARGUMENT if array is NULL
+ * SP_ELEMENT_ARRAY_SUCCESS otherwise
+ */
+SP_ELEMENT_ARRAY_MSG spElementArraySort(SPElementArray array);
+
+/**
+ * Sorts the elements of an array in ascending order, as spElementArraySort,
+ * using up to the given number of threads. The array is split into one part
+ * per thread, the parts are radix sorted concurrently, and the sorted parts
+ * are merged pairwise, with the merges of each round running concurrently.
+ * Arrays which are too small to benefit from threads are sorted by the
+ * calling thread.
+ *
+ * @param array The target array
+ * @param threads The maximal number of threads to use (threads >= 1)
+ * @return
+ * SP_ELEMENT_ARRAY_INVALID_ARGUMENT if array is NULL or threads < 1
+ * SP_ELEMENT_ARRAY_SUCCESS otherwise
+ */
+SP_ELEMENT_ARRAY_MSG spElementArraySortParallel(SPElementArray array, int threads);
+
+/**
+ * Creates an array holding the elements of a list, in list order. The
+ * internal iterator of the list will not change.
+ *
+ * @param list The source list
+ * @return
+ * NULL if a NULL was sent or an allocation failed.
+ * A new array otherwise.
+ */
+SPElementArray spElementArrayFromList(SPList list);
+
+/**
+ * Creates a list holding the elements of an array, in array order.
+ *
+ * @param array The source array
+ * @param backend The backend of the new list (see SPList.h)
+ * @return
+ * NULL if a NULL was sent, backend is not valid or an allocation failed.
+ * A new list otherwise.
+ */
+SPList spElementArrayToList(SPElementArray array, SP_LIST_BACKEND backend);
+
+/**
+ * Creates an array holding the elements of a bounded priority queue, in
+ * ascending order. The queue is not modified.
+ *
+ * @param queue The source queue
+ * @return
+ * NULL if a NULL was sent or an allocation failed.
+ * A new array otherwise.
+ */
+SPElementArray spElementArrayFromBPQueue(SPBPQueue queue);
+
+/**
+ * Enqueues all the elements of an array into a bounded priority queue, as
+ * spBPQueueEnqueue would. If the array is sorted, the elements are merged
+ * into the queue in a single pass (see spBPQueueEnqueueSorted).
+ *
+ * @param array The source array
+ * @param queue The target queue
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if array or queue are NULL, or an element has a
+ * negative index or value.
+ * SP_BPQUEUE_OUT_OF_MEMORY if an allocation failed.
+ * SP_BPQUEUE_FULL if the queue overflowed, so some elements were removed from
+ * the queue or were not inserted.
+ * SP_BPQUEUE_SUCCESS all the elements have been inserted successfully.
+ */
+SP_BPQUEUE_MSG spElementArrayToBPQueue(SPElementArray array, SPBPQueue queue);
+
+#endif /* SPELEMENTARRAY_H_ */
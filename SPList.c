@@ -1,98 +1,583 @@
 #include "SPList.h"
+#include "SPListElementInternal.h"
 #include <stdlib.h> // malloc, free, NULL
+#include <string.h> // memcpy, memmove
 
+#define SP_LIST_DEFAULT_CHUNK_SIZE 8 // Nodes in the first chunk of a private pool
+#define SP_LIST_MAX_CHUNK_SIZE 4096 // Chunks stop doubling at this size
+#define SP_LIST_BLOCK_CAPACITY 16 // Elements in a block of an unrolled list
+#define SP_LIST_BLOCK_MERGE_SIZE (SP_LIST_BLOCK_CAPACITY / 4) // Blocks this small are merged
+#define SP_LIST_VECTOR_MIN_CAPACITY 8 // Initial capacity of a vector list
+
+// The element is stored by value, so a node is a single 32 byte block
 typedef struct node_t {
-	SPListElement data;
+	struct sp_list_element_t data;
 	struct node_t* next;
 	struct node_t* previous;
 }*Node;
 
-Node createNode(Node previous, Node next, SPListElement element);
-void destroyNode(Node node);
+// A node of an unrolled list, holding up to SP_LIST_BLOCK_CAPACITY elements
+typedef struct block_t {
+	struct block_t* next;
+	struct block_t* previous;
+	int count;
+	struct sp_list_element_t elements[SP_LIST_BLOCK_CAPACITY];
+}*Block;
+
+typedef struct pool_chunk_t {
+	struct pool_chunk_t* next;
+	struct node_t nodes[];
+} *PoolChunk;
+
+struct sp_list_node_pool_t {
+	Node freeNodes; // Linked through the next field
+	PoolChunk chunks;
+	int nextChunkSize;
+	int references; // The creator, every list using the pool and every list holding its nodes
+};
+
+Node createNode(SPListNodePool pool, Node previous, Node next, SPListElement element);
+void destroyNode(SPListNodePool pool, Node node);
 
 struct sp_list_t {
+	SP_LIST_BACKEND backend;
+	// SP_LIST_LINKED_BACKEND storage
 	Node head;
 	Node tail;
 	Node current;
+	SPListNodePool pool;
+	SPListNodePool* borrowedPools; // Other pools whose chunks hold nodes moved into the list
+	int borrowedCount;
+	struct node_t sentinels[2]; // head and tail
+	// SP_LIST_UNROLLED_BACKEND storage, the current element is
+	// currentBlock->elements[currentOffset]
+	Block firstBlock;
+	Block lastBlock;
+	Block currentBlock;
+	int currentOffset;
+	Block spareBlock; // The last freed block, kept for the next split
+	// SP_LIST_VECTOR_BACKEND storage, the current element is array[currentIndex]
+	struct sp_list_element_t* array;
+	int capacity;
+	int currentIndex; // -1 if the iterator is invalid
 	int size;
 };
 
-Node createNode(Node previous, Node next, SPListElement element) {
-	SPListElement newElement = spListElementCopy(element);
-	if (newElement == NULL) {
+static bool poolGrow(SPListNodePool pool) {
+	PoolChunk chunk;
+	int i;
+	chunk = (PoolChunk) malloc(sizeof(*chunk) + sizeof(struct node_t)*pool->nextChunkSize);
+	if (chunk == NULL) {
+		return false;
+	}
+	for (i = pool->nextChunkSize - 1; i >= 0; i--) { // The first node is handed out first
+		chunk->nodes[i].next = pool->freeNodes;
+		pool->freeNodes = &chunk->nodes[i];
+	}
+	chunk->next = pool->chunks;
+	pool->chunks = chunk;
+	pool->nextChunkSize *= 2;
+	if (pool->nextChunkSize > SP_LIST_MAX_CHUNK_SIZE) {
+		pool->nextChunkSize = SP_LIST_MAX_CHUNK_SIZE;
+	}
+	return true;
+}
+
+static void poolRelease(SPListNodePool pool) {
+	PoolChunk chunk;
+	if (pool == NULL) {
+		return;
+	}
+	// Atomic, since a pool may be referenced by lists of other threads (see listBorrowPools)
+	if (__atomic_sub_fetch(&pool->references, 1, __ATOMIC_ACQ_REL) > 0) {
+		return;
+	}
+	while (pool->chunks != NULL) {
+		chunk = pool->chunks;
+		pool->chunks = chunk->next;
+		free(chunk);
+	}
+	free(pool);
+}
+
+SPListNodePool spListNodePoolCreate(int chunkSize) {
+	SPListNodePool pool;
+	if (chunkSize <= 0) {
 		return NULL;
 	}
-	Node newNode = (Node) malloc(sizeof(*newNode));
-	if (newNode == NULL) {
-		spListElementDestroy(newElement);
+	pool = (SPListNodePool) malloc(sizeof(*pool));
+	if (pool == NULL) {
+		return NULL;
+	}
+	pool->freeNodes = NULL;
+	pool->chunks = NULL;
+	pool->nextChunkSize = chunkSize;
+	pool->references = 1;
+	return pool;
+}
+
+void spListNodePoolDestroy(SPListNodePool pool) {
+	poolRelease(pool);
+}
+
+Node createNode(SPListNodePool pool, Node previous, Node next, SPListElement element) {
+	Node newNode;
+	if (pool->freeNodes == NULL && !poolGrow(pool)) {
 		return NULL;
 	}
-	newNode->data = newElement;
+	newNode = pool->freeNodes;
+	pool->freeNodes = newNode->next;
+	newNode->data = *element;
 	newNode->previous = previous;
 	newNode->next = next;
 	return newNode;
 }
 
-void destroyNode(Node node) {
+void destroyNode(SPListNodePool pool, Node node) {
 	if (node == NULL) {
 		return;
 	}
-	if (node->data != NULL) {
-		spListElementDestroy(node->data);
+	node->next = pool->freeNodes;
+	pool->freeNodes = node;
+}
+
+/*
+ * Unrolled list helpers.
+ * Every block holds between 1 and SP_LIST_BLOCK_CAPACITY elements. A full
+ * block is split in two when an element is inserted in its middle, and a
+ * block which becomes small after a removal is merged into a neighbour.
+ * All helpers keep the internal iterator, and the external iterator given to
+ * them if any, on the same element.
+ */
+
+// Keeps a cursor on its element when elements [from, count) of block move to
+// target, starting at position to
+static void cursorMove(Block* cursorBlock, int* cursorOffset, Block block, int from,
+		Block target, int to) {
+	if (*cursorBlock == block && *cursorOffset >= from) {
+		*cursorBlock = target;
+		*cursorOffset += to - from;
 	}
-	free(node);
 }
 
-SPList spListCreate() {
-	SPList list = (SPList) malloc(sizeof(*list));
-	if (list == NULL) {
-		return NULL;
+static void cursorsMove(SPList list, SPListIter* iter, Block block, int from,
+		Block target, int to) {
+	Block iterBlock;
+	cursorMove(&list->currentBlock, &list->currentOffset, block, from, target, to);
+	if (iter != NULL) {
+		iterBlock = (Block) iter->node;
+		cursorMove(&iterBlock, &iter->offset, block, from, target, to);
+		iter->node = iterBlock;
+	}
+}
+
+static Block blockCreate(SPList list) {
+	Block block = list->spareBlock;
+	if (block != NULL) {
+		list->spareBlock = NULL;
 	} else {
-		list->head = (Node) malloc(sizeof(*list->head));
-		if (list->head == NULL) {
-			free(list);
+		block = (Block) malloc(sizeof(*block));
+		if (block == NULL) {
 			return NULL;
 		}
-		list->tail = (Node) malloc(sizeof(*list->tail));
-		if (list->tail == NULL) {
-			free(list->head);
-			free(list);
-			return NULL;
+	}
+	block->next = NULL;
+	block->previous = NULL;
+	block->count = 0;
+	return block;
+}
+
+static void blockDestroy(SPList list, Block block) {
+	if (list->spareBlock == NULL) {
+		list->spareBlock = block;
+	} else {
+		free(block);
+	}
+}
+
+// Links block after previous, or as the first block if previous is NULL
+static void blockLinkAfter(SPList list, Block block, Block previous) {
+	block->previous = previous;
+	block->next = previous == NULL ? list->firstBlock : previous->next;
+	if (block->next == NULL) {
+		list->lastBlock = block;
+	} else {
+		block->next->previous = block;
+	}
+	if (previous == NULL) {
+		list->firstBlock = block;
+	} else {
+		previous->next = block;
+	}
+}
+
+static void blockUnlink(SPList list, Block block) {
+	if (block->previous == NULL) {
+		list->firstBlock = block->next;
+	} else {
+		block->previous->next = block->next;
+	}
+	if (block->next == NULL) {
+		list->lastBlock = block->previous;
+	} else {
+		block->next->previous = block->previous;
+	}
+}
+
+// Moves the elements of source to the end of target and frees source
+static void blockMerge(SPList list, SPListIter* iter, Block target, Block source) {
+	memcpy(target->elements + target->count, source->elements,
+			sizeof(struct sp_list_element_t)*source->count);
+	cursorsMove(list, iter, source, 0, target, target->count);
+	target->count += source->count;
+	blockUnlink(list, source);
+	blockDestroy(list, source);
+}
+
+// Inserts element at position (0 <= position <= block->count) of block, or
+// into an empty list if block is NULL
+static SP_LIST_MSG unrolledInsert(SPList list, SPListIter* iter, Block block, int position,
+		SPListElement element) {
+	Block newBlock;
+	int half = SP_LIST_BLOCK_CAPACITY / 2;
+	if (block == NULL) {
+		block = blockCreate(list);
+		if (block == NULL) {
+			return SP_LIST_OUT_OF_MEMORY;
+		}
+		blockLinkAfter(list, block, NULL);
+		position = 0;
+	} else if (block->count == SP_LIST_BLOCK_CAPACITY) {
+		if (position == SP_LIST_BLOCK_CAPACITY && block->next != NULL
+				&& block->next->count < SP_LIST_BLOCK_CAPACITY) { // Prepend to the next block
+			block = block->next;
+			position = 0;
+		} else if (position == 0 && block->previous != NULL
+				&& block->previous->count < SP_LIST_BLOCK_CAPACITY) { // Append to the previous block
+			block = block->previous;
+			position = block->count;
+		} else if (position == SP_LIST_BLOCK_CAPACITY || position == 0) { // A new block at the edge
+			newBlock = blockCreate(list);
+			if (newBlock == NULL) {
+				return SP_LIST_OUT_OF_MEMORY;
+			}
+			blockLinkAfter(list, newBlock, position == 0 ? block->previous : block);
+			block = newBlock;
+			position = 0;
+		} else { // Split, moving the upper half to a new block
+			newBlock = blockCreate(list);
+			if (newBlock == NULL) {
+				return SP_LIST_OUT_OF_MEMORY;
+			}
+			memcpy(newBlock->elements, block->elements + half,
+					sizeof(struct sp_list_element_t)*(block->count - half));
+			newBlock->count = block->count - half;
+			block->count = half;
+			blockLinkAfter(list, newBlock, block);
+			cursorsMove(list, iter, block, half, newBlock, 0);
+			if (position > half) {
+				block = newBlock;
+				position -= half;
+			}
 		}
-		list->head->data = NULL;
-		list->head->next = list->tail;
-		list->head->previous = NULL;
-		list->tail->data = NULL;
-		list->tail->next = NULL;
-		list->tail->previous = list->head;
-		list->current = NULL;
-		list->size = 0;
-		return list;
 	}
+	memmove(block->elements + position + 1, block->elements + position,
+			sizeof(struct sp_list_element_t)*(block->count - position));
+	cursorsMove(list, iter, block, position, block, position + 1);
+	block->elements[position] = *element;
+	block->count++;
+	list->size++;
+	return SP_LIST_SUCCESS;
 }
 
-SPList spListCopy(SPList list) {
-	if (list == NULL) {
-		return NULL;
+// Removes the element at position of block. The internal iterator becomes
+// invalid if it pointed to that element, and iter (if not NULL) is moved to
+// the element after it.
+static void unrolledRemove(SPList list, SPListIter* iter, Block block, int position) {
+	if (list->currentBlock == block && list->currentOffset == position) {
+		list->currentBlock = NULL;
+	}
+	block->count--;
+	memmove(block->elements + position, block->elements + position + 1,
+			sizeof(struct sp_list_element_t)*(block->count - position));
+	cursorsMove(list, NULL, block, position + 1, block, position);
+	list->size--;
+	if (iter != NULL) {
+		iter->node = position < block->count ? block : block->next;
+		iter->offset = position < block->count ? position : 0;
+	}
+	if (block->count == 0) {
+		blockUnlink(list, block);
+		blockDestroy(list, block);
+	} else if (block->count <= SP_LIST_BLOCK_MERGE_SIZE) {
+		if (block->next != NULL && block->count + block->next->count <= SP_LIST_BLOCK_CAPACITY) {
+			blockMerge(list, iter, block, block->next);
+		} else if (block->previous != NULL
+				&& block->previous->count + block->count <= SP_LIST_BLOCK_CAPACITY) {
+			blockMerge(list, iter, block->previous, block);
+		}
+	}
+}
+
+static void unrolledClear(SPList list) {
+	Block block;
+	while (list->firstBlock != NULL) {
+		block = list->firstBlock;
+		list->firstBlock = block->next;
+		blockDestroy(list, block);
 	}
-	SPList copyList = spListCreate();
+	list->lastBlock = NULL;
+	list->currentBlock = NULL;
+	list->size = 0;
+}
+
+static SPList unrolledCopy(SPList list) {
+	SPList copyList = spListCreateWithBackend(SP_LIST_UNROLLED_BACKEND);
+	Block block, copyBlock;
 	if (copyList == NULL) {
 		return NULL;
 	}
-	SPListElement currentElement = spListGetFirst(list);
-	while (currentElement) {
-		if (spListInsertLast(copyList, currentElement) != SP_LIST_SUCCESS) {
+	for (block = list->firstBlock; block != NULL; block = block->next) {
+		copyBlock = blockCreate(copyList);
+		if (copyBlock == NULL) {
 			spListDestroy(copyList);
-			list->current = NULL;
 			return NULL;
 		}
-		currentElement = spListGetNext(list);
+		memcpy(copyBlock->elements, block->elements,
+				sizeof(struct sp_list_element_t)*block->count);
+		copyBlock->count = block->count;
+		blockLinkAfter(copyList, copyBlock, copyList->lastBlock);
+	}
+	copyList->size = list->size;
+	return copyList;
+}
+
+/*
+ * Vector helpers.
+ * The elements are stored in order in array[0..size), which doubles its
+ * capacity when it is full.
+ */
+
+static bool vectorReserve(SPList list, int capacity) {
+	struct sp_list_element_t* array;
+	int newCapacity = list->capacity < SP_LIST_VECTOR_MIN_CAPACITY ?
+			SP_LIST_VECTOR_MIN_CAPACITY : list->capacity;
+	if (capacity <= list->capacity) {
+		return true;
+	}
+	while (newCapacity < capacity) {
+		newCapacity *= 2;
+	}
+	array = (struct sp_list_element_t*) realloc(list->array,
+			sizeof(struct sp_list_element_t)*newCapacity);
+	if (array == NULL) {
+		return false;
 	}
+	list->array = array;
+	list->capacity = newCapacity;
+	return true;
+}
+
+// Inserts element at position (0 <= position <= size), keeping the internal
+// iterator and iter (if not NULL) on the same element
+static SP_LIST_MSG vectorInsert(SPList list, SPListIter* iter, int position,
+		SPListElement element) {
+	if (!vectorReserve(list, list->size + 1)) {
+		return SP_LIST_OUT_OF_MEMORY;
+	}
+	memmove(list->array + position + 1, list->array + position,
+			sizeof(struct sp_list_element_t)*(list->size - position));
+	list->array[position] = *element;
+	list->size++;
+	if (list->currentIndex >= position) {
+		list->currentIndex++;
+	}
+	if (iter != NULL && iter->offset >= position) {
+		iter->offset++;
+	}
+	return SP_LIST_SUCCESS;
+}
+
+// Removes the element at position. The internal iterator becomes invalid if
+// it pointed to that element, and iter (if not NULL) is moved to the element
+// after it.
+static void vectorRemove(SPList list, SPListIter* iter, int position) {
+	list->size--;
+	memmove(list->array + position, list->array + position + 1,
+			sizeof(struct sp_list_element_t)*(list->size - position));
+	if (list->currentIndex == position) {
+		list->currentIndex = -1;
+	} else if (list->currentIndex > position) {
+		list->currentIndex--;
+	}
+	if (iter != NULL) {
+		iter->offset = position < list->size ? position : -1;
+	}
+}
+
+static SPList vectorCopy(SPList list) {
+	SPList copyList = spListCreateWithBackend(SP_LIST_VECTOR_BACKEND);
+	if (copyList == NULL) {
+		return NULL;
+	}
+	if (!vectorReserve(copyList, list->size)) {
+		spListDestroy(copyList);
+		return NULL;
+	}
+	if (list->size > 0) {
+		memcpy(copyList->array, list->array, sizeof(struct sp_list_element_t)*list->size);
+	}
+	copyList->size = list->size;
+	return copyList;
+}
+
+/*
+ * Linked list helpers.
+ */
+
+// Inserts element after previous, which may be the head sentinel
+static SP_LIST_MSG linkedInsert(SPList list, Node previous, SPListElement element) {
+	Node newNode = createNode(list->pool, previous, previous->next, element);
+	if (newNode == NULL) {
+		return SP_LIST_OUT_OF_MEMORY;
+	}
+	previous->next->previous = newNode;
+	previous->next = newNode;
+	list->size++;
+	return SP_LIST_SUCCESS;
+}
+
+// Removes node. The internal iterator becomes invalid if it pointed to node,
+// and iter (if not NULL) is moved to the node after it.
+static void linkedRemove(SPList list, SPListIter* iter, Node node) {
+	node->previous->next = node->next;
+	node->next->previous = node->previous;
+	if (list->current == node) {
+		list->current = NULL;
+	}
+	if (iter != NULL) {
+		iter->node = node->next == list->tail ? NULL : node->next;
+	}
+	destroyNode(list->pool, node);
+	list->size--;
+}
+
+static bool hasCurrent(SPList list) {
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return list->currentBlock != NULL;
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return list->currentIndex >= 0;
+	}
+	return list->current != NULL;
+}
+
+static SPList listCreate(SP_LIST_BACKEND backend, SPListNodePool pool) {
+	SPList list = (SPList) malloc(sizeof(*list));
+	if (list == NULL) {
+		return NULL;
+	}
+	list->backend = backend;
+	list->head = &list->sentinels[0];
+	list->tail = &list->sentinels[1];
+	list->head->next = list->tail;
+	list->head->previous = NULL;
+	list->tail->next = NULL;
+	list->tail->previous = list->head;
 	list->current = NULL;
-	copyList->current = NULL;
+	list->pool = pool;
+	if (pool != NULL) {
+		__atomic_add_fetch(&pool->references, 1, __ATOMIC_RELAXED);
+	}
+	list->borrowedPools = NULL;
+	list->borrowedCount = 0;
+	list->firstBlock = NULL;
+	list->lastBlock = NULL;
+	list->currentBlock = NULL;
+	list->currentOffset = 0;
+	list->spareBlock = NULL;
+	list->array = NULL;
+	list->capacity = 0;
+	list->currentIndex = -1;
+	list->size = 0;
+	return list;
+}
+
+SPList spListCreate() {
+	return spListCreateWithBackend(SP_LIST_LINKED_BACKEND);
+}
+
+SPList spListCreateWithBackend(SP_LIST_BACKEND backend) {
+	SPListNodePool pool;
+	SPList list;
+	if (backend == SP_LIST_UNROLLED_BACKEND || backend == SP_LIST_VECTOR_BACKEND) {
+		return listCreate(backend, NULL);
+	}
+	pool = spListNodePoolCreate(SP_LIST_DEFAULT_CHUNK_SIZE);
+	if (pool == NULL) {
+		return NULL;
+	}
+	list = listCreate(SP_LIST_LINKED_BACKEND, pool);
+	spListNodePoolDestroy(pool); // The list holds the only reference
+	return list;
+}
+
+SPList spListCreateWithPool(SPListNodePool pool) {
+	if (pool == NULL) {
+		return NULL;
+	}
+	return listCreate(SP_LIST_LINKED_BACKEND, pool);
+}
+
+SP_LIST_BACKEND spListGetBackend(SPList list) {
+	return list == NULL ? SP_LIST_LINKED_BACKEND : list->backend;
+}
+
+// Copies list into a new list with a private pool whose first chunk holds
+// exactly the copied nodes, linking them in a single pass
+static SPList linkedCopy(SPList list) {
+	SPListNodePool pool;
+	SPList copyList;
+	Node node, newNode, previous;
+	pool = spListNodePoolCreate(list->size > 0 ? list->size : SP_LIST_DEFAULT_CHUNK_SIZE);
+	if (pool == NULL) {
+		return NULL;
+	}
+	copyList = listCreate(SP_LIST_LINKED_BACKEND, pool);
+	spListNodePoolDestroy(pool); // The copy holds the only reference
+	if (copyList == NULL) {
+		return NULL;
+	}
+	if (list->size > 0 && !poolGrow(pool)) {
+		spListDestroy(copyList);
+		return NULL;
+	}
+	previous = copyList->head;
+	for (node = list->head->next; node != list->tail; node = node->next) {
+		newNode = pool->freeNodes; // Consecutive nodes of the chunk, in order
+		pool->freeNodes = newNode->next;
+		newNode->data = node->data;
+		newNode->previous = previous;
+		previous->next = newNode;
+		previous = newNode;
+	}
+	previous->next = copyList->tail;
+	copyList->tail->previous = previous;
+	copyList->size = list->size;
 	return copyList;
 }
 
+SPList spListCopy(SPList list) {
+	if (list == NULL) {
+		return NULL;
+	}
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledCopy(list);
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorCopy(list);
+	}
+	return linkedCopy(list);
+}
+
 int spListGetSize(SPList list) {
 	return list == NULL ? -1 : list->size;
 }
@@ -100,116 +585,361 @@ int spListGetSize(SPList list) {
 SPListElement spListGetFirst(SPList list) {
 	if (list == NULL || spListGetSize(list) == 0) {
 		return NULL;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		list->currentBlock = list->firstBlock;
+		list->currentOffset = 0;
+		return &list->currentBlock->elements[0];
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		list->currentIndex = 0;
+		return &list->array[0];
 	} else {
 		list->current = list->head->next;
-		return list->current->data;
+		return &list->current->data;
 	}
 }
 
 SPListElement spListGetLast(SPList list){
 	if (list == NULL || spListGetSize(list) == 0) {
 		return NULL;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		list->currentBlock = list->lastBlock;
+		list->currentOffset = list->lastBlock->count - 1;
+		return &list->currentBlock->elements[list->currentOffset];
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		list->currentIndex = list->size - 1;
+		return &list->array[list->currentIndex];
 	} else {
 		list->current = list->tail->previous;
-		return list->current->data;
+		return &list->current->data;
 	}
 }
 
 SPListElement spListGetNext(SPList list) {
-	if (list == NULL || spListGetSize(list) == 0 || list->current == NULL) {
+	if (list == NULL || spListGetSize(list) == 0 || !hasCurrent(list)) {
 		return NULL;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		list->currentOffset++;
+		if (list->currentOffset == list->currentBlock->count) {
+			list->currentBlock = list->currentBlock->next;
+			list->currentOffset = 0;
+			if (list->currentBlock == NULL) {
+				return NULL;
+			}
+		}
+		return &list->currentBlock->elements[list->currentOffset];
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		list->currentIndex++;
+		if (list->currentIndex == list->size) {
+			list->currentIndex = -1;
+			return NULL;
+		}
+		return &list->array[list->currentIndex];
 	} else {
 		if (list->current->next == list->tail) {
 			list->current = NULL;
 			return NULL;
 		} else {
 			list->current = list->current->next;
-			return list->current->data;
+			return &list->current->data;
 		}
 	}
 }
 
 SPListElement spListGetPrevious(SPList list) {
-	if (list == NULL || spListGetSize(list) == 0 || list->current == NULL) {
+	if (list == NULL || spListGetSize(list) == 0 || !hasCurrent(list)) {
 		return NULL;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		if (list->currentOffset == 0) {
+			list->currentBlock = list->currentBlock->previous;
+			if (list->currentBlock == NULL) {
+				return NULL;
+			}
+			list->currentOffset = list->currentBlock->count;
+		}
+		list->currentOffset--;
+		return &list->currentBlock->elements[list->currentOffset];
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		list->currentIndex--;
+		return list->currentIndex < 0 ? NULL : &list->array[list->currentIndex];
 	} else {
 		if (list->current->previous == list->head) {
 			list->current = NULL;
 			return NULL;
 		} else {
 			list->current = list->current->previous;
-			return list->current->data;
+			return &list->current->data;
 		}
 	}
 }
 
 SPListElement spListGetCurrent(SPList list) {
-	if (list == NULL || spListGetSize(list) == 0 || list->current == NULL) {
+	if (list == NULL || spListGetSize(list) == 0 || !hasCurrent(list)) {
 		return NULL;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return &list->currentBlock->elements[list->currentOffset];
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return &list->array[list->currentIndex];
 	} else {
-		return list->current->data;
+		return &list->current->data;
 	}
 }
 
+SPListElement spListGetAt(SPList list, int i) {
+	Block block;
+	Node node;
+	if (list == NULL || i < 0 || i >= list->size) {
+		return NULL;
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		list->currentIndex = i;
+		return &list->array[i];
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		for (block = list->firstBlock; i >= block->count; block = block->next) {
+			i -= block->count;
+		}
+		list->currentBlock = block;
+		list->currentOffset = i;
+		return &block->elements[i];
+	} else {
+		for (node = list->head->next; i > 0; i--) {
+			node = node->next;
+		}
+		list->current = node;
+		return &node->data;
+	}
+}
+
+int spListToArray(SPList list, int* indices, double* values) {
+	Block block;
+	Node node;
+	int i = 0, j;
+	if (list == NULL || indices == NULL || values == NULL) {
+		return -1;
+	}
+	if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		for (i = 0; i < list->size; i++) {
+			indices[i] = list->array[i].index;
+			values[i] = list->array[i].value;
+		}
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		for (block = list->firstBlock; block != NULL; block = block->next) {
+			for (j = 0; j < block->count; j++, i++) {
+				indices[i] = block->elements[j].index;
+				values[i] = block->elements[j].value;
+			}
+		}
+	} else {
+		for (node = list->head->next; node != list->tail; node = node->next, i++) {
+			indices[i] = node->data.index;
+			values[i] = node->data.value;
+		}
+	}
+	return list->size;
+}
+
+static bool iterIsValid(const SPListIter* iter) {
+	if (iter == NULL || iter->list == NULL) {
+		return false;
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		return iter->offset >= 0 && iter->offset < iter->list->size;
+	}
+	return iter->node != NULL;
+}
+
+SPListIter spListIterBegin(SPList list) {
+	SPListIter iter;
+	iter.list = list;
+	iter.node = NULL;
+	iter.offset = -1;
+	if (list == NULL || list->size == 0) {
+		return iter;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		iter.node = list->firstBlock;
+		iter.offset = 0;
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		iter.offset = 0;
+	} else {
+		iter.node = list->head->next;
+	}
+	return iter;
+}
+
+SPListIter spListIterLast(SPList list) {
+	SPListIter iter;
+	iter.list = list;
+	iter.node = NULL;
+	iter.offset = -1;
+	if (list == NULL || list->size == 0) {
+		return iter;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		iter.node = list->lastBlock;
+		iter.offset = list->lastBlock->count - 1;
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		iter.offset = list->size - 1;
+	} else {
+		iter.node = list->tail->previous;
+	}
+	return iter;
+}
+
+SPListElement spListIterGet(const SPListIter* iter) {
+	if (!iterIsValid(iter)) {
+		return NULL;
+	} else if (iter->list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return &((Block) iter->node)->elements[iter->offset];
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		return &iter->list->array[iter->offset];
+	} else {
+		return &((Node) iter->node)->data;
+	}
+}
+
+SPListElement spListIterNext(SPListIter* iter) {
+	Block block;
+	Node node;
+	if (!iterIsValid(iter)) {
+		return NULL;
+	} else if (iter->list->backend == SP_LIST_UNROLLED_BACKEND) {
+		block = (Block) iter->node;
+		iter->offset++;
+		if (iter->offset == block->count) {
+			iter->node = block->next;
+			iter->offset = 0;
+		}
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		iter->offset++;
+		if (iter->offset == iter->list->size) {
+			iter->offset = -1;
+		}
+	} else {
+		node = (Node) iter->node;
+		iter->node = node->next == iter->list->tail ? NULL : node->next;
+	}
+	return spListIterGet(iter);
+}
+
+SPListElement spListIterPrevious(SPListIter* iter) {
+	Block block;
+	Node node;
+	if (!iterIsValid(iter)) {
+		return NULL;
+	} else if (iter->list->backend == SP_LIST_UNROLLED_BACKEND) {
+		block = (Block) iter->node;
+		if (iter->offset == 0) {
+			block = block->previous;
+			iter->node = block;
+			if (block == NULL) {
+				return NULL;
+			}
+			iter->offset = block->count;
+		}
+		iter->offset--;
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		iter->offset--;
+	} else {
+		node = (Node) iter->node;
+		iter->node = node->previous == iter->list->head ? NULL : node->previous;
+	}
+	return spListIterGet(iter);
+}
+
+SP_LIST_MSG spListIterInsertBefore(SPListIter* iter, SPListElement element) {
+	if (iter == NULL || iter->list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (!iterIsValid(iter)) {
+		return SP_LIST_INVALID_CURRENT;
+	} else if (iter->list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledInsert(iter->list, iter, (Block) iter->node, iter->offset, element);
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorInsert(iter->list, iter, iter->offset, element);
+	} else {
+		return linkedInsert(iter->list, ((Node) iter->node)->previous, element);
+	}
+}
+
+SP_LIST_MSG spListIterInsertAfter(SPListIter* iter, SPListElement element) {
+	if (iter == NULL || iter->list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (!iterIsValid(iter)) {
+		return SP_LIST_INVALID_CURRENT;
+	} else if (iter->list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledInsert(iter->list, iter, (Block) iter->node, iter->offset + 1, element);
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorInsert(iter->list, iter, iter->offset + 1, element);
+	} else {
+		return linkedInsert(iter->list, (Node) iter->node, element);
+	}
+}
+
+SP_LIST_MSG spListIterRemove(SPListIter* iter) {
+	if (iter == NULL || iter->list == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (!iterIsValid(iter)) {
+		return SP_LIST_INVALID_CURRENT;
+	} else if (iter->list->backend == SP_LIST_UNROLLED_BACKEND) {
+		unrolledRemove(iter->list, iter, (Block) iter->node, iter->offset);
+	} else if (iter->list->backend == SP_LIST_VECTOR_BACKEND) {
+		vectorRemove(iter->list, iter, iter->offset);
+	} else {
+		linkedRemove(iter->list, iter, (Node) iter->node);
+	}
+	return SP_LIST_SUCCESS;
+}
+
 SP_LIST_MSG spListInsertFirst(SPList list, SPListElement element) {
 	if (list == NULL || element == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	Node newNode = createNode(list->head, list->head->next, element);
-	if (newNode == NULL) {
-		return SP_LIST_OUT_OF_MEMORY;
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledInsert(list, NULL, list->firstBlock, 0, element);
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorInsert(list, NULL, 0, element);
 	}
-	list->head->next->previous = newNode;
-	list->head->next = newNode;
-	list->size++;
-	return SP_LIST_SUCCESS;
+	return linkedInsert(list, list->head, element);
 }
 
 SP_LIST_MSG spListInsertLast(SPList list, SPListElement element) {
 	if (list == NULL || element == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	Node newNode = createNode(list->tail->previous, list->tail, element);
-	if (newNode == NULL) {
-		return SP_LIST_OUT_OF_MEMORY;
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledInsert(list, NULL, list->lastBlock,
+				list->lastBlock == NULL ? 0 : list->lastBlock->count, element);
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorInsert(list, NULL, list->size, element);
 	}
-	list->tail->previous->next = newNode;
-	list->tail->previous = newNode;
-	list->size++;
-	return SP_LIST_SUCCESS;
+	return linkedInsert(list, list->tail->previous, element);
 }
 
 SP_LIST_MSG spListInsertBeforeCurrent(SPList list, SPListElement element) {
 	if (list == NULL || element == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	if (list->current == NULL) {
+	if (!hasCurrent(list)) {
 		return SP_LIST_INVALID_CURRENT;
 	}
-	Node newNode = createNode(list->current->previous, list->current, element);
-	if (newNode == NULL) {
-		return SP_LIST_OUT_OF_MEMORY;
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledInsert(list, NULL, list->currentBlock, list->currentOffset, element);
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorInsert(list, NULL, list->currentIndex, element);
 	}
-	list->current->previous->next = newNode;
-	list->current->previous = newNode;
-	list->size++;
-	return SP_LIST_SUCCESS;
+	return linkedInsert(list, list->current->previous, element);
 }
 
 SP_LIST_MSG spListInsertAfterCurrent(SPList list, SPListElement element) {
 	if (list == NULL || element == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	if (list->current == NULL) {
+	if (!hasCurrent(list)) {
 		return SP_LIST_INVALID_CURRENT;
-	} else if (list->current == list->tail->previous) {
-		return spListInsertLast(list, element);
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		return unrolledInsert(list, NULL, list->currentBlock, list->currentOffset + 1, element);
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		return vectorInsert(list, NULL, list->currentIndex + 1, element);
 	} else {
-		Node tempCurrent = list->current;
-		list->current = list->current->next;
-		SP_LIST_MSG res = spListInsertBeforeCurrent(list, element);
-		list->current = tempCurrent;
-		return res;
+		return linkedInsert(list, list->current, element);
 	}
 }
 
@@ -217,14 +947,16 @@ SP_LIST_MSG spListRemoveCurrent(SPList list) {
 	if (list == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	if (list->current == NULL) {
+	if (!hasCurrent(list)) {
 		return SP_LIST_INVALID_CURRENT;
 	}
-	list->current->previous->next = list->current->next;
-	list->current->next->previous = list->current->previous;
-	destroyNode(list->current);
-	list->current = NULL;
-	list->size--;
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		unrolledRemove(list, NULL, list->currentBlock, list->currentOffset);
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		vectorRemove(list, NULL, list->currentIndex);
+	} else {
+		linkedRemove(list, NULL, list->current);
+	}
 	return SP_LIST_SUCCESS;
 }
 
@@ -232,18 +964,420 @@ SP_LIST_MSG spListClear(SPList list) {
 	if (list == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
+	if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		unrolledClear(list);
+		return SP_LIST_SUCCESS;
+	} else if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		list->size = 0; // The capacity is kept for reuse
+		list->currentIndex = -1;
+		return SP_LIST_SUCCESS;
+	}
 	while (spListGetFirst(list)) {
 		spListRemoveCurrent(list);
 	}
 	return SP_LIST_SUCCESS;
 }
 
+// Moves all the elements of source into target by copying them, before the
+// internal iterator of target or at its end
+static SP_LIST_MSG moveByCopy(SPList target, SPList source, bool beforeCurrent) {
+	SPListIter iter;
+	SP_LIST_MSG msg;
+	for (iter = spListIterBegin(source); spListIterGet(&iter) != NULL; spListIterNext(&iter)) {
+		msg = beforeCurrent ? spListInsertBeforeCurrent(target, spListIterGet(&iter))
+				: spListInsertLast(target, spListIterGet(&iter));
+		if (msg != SP_LIST_SUCCESS) {
+			return msg;
+		}
+	}
+	spListClear(source);
+	return SP_LIST_SUCCESS;
+}
+
+// Links the nodes of source before position in target, leaving source empty
+static void linkedSpliceBefore(SPList target, Node position, SPList source) {
+	Node first = source->head->next;
+	Node last = source->tail->previous;
+	first->previous = position->previous;
+	position->previous->next = first;
+	last->next = position;
+	position->previous = last;
+	target->size += source->size;
+	source->head->next = source->tail;
+	source->tail->previous = source->head;
+	source->current = NULL;
+	source->size = 0;
+}
+
+// Splits block at offset (0 < offset < block->count), returns the new block
+// which holds the elements from offset on
+static Block blockSplitAt(SPList list, Block block, int offset) {
+	Block newBlock = blockCreate(list);
+	if (newBlock == NULL) {
+		return NULL;
+	}
+	memcpy(newBlock->elements, block->elements + offset,
+			sizeof(struct sp_list_element_t)*(block->count - offset));
+	newBlock->count = block->count - offset;
+	block->count = offset;
+	blockLinkAfter(list, newBlock, block);
+	cursorsMove(list, NULL, block, offset, newBlock, 0);
+	return newBlock;
+}
+
+// Links the blocks of source after previous (NULL for the start) in target,
+// leaving source empty
+static void unrolledSpliceAfter(SPList target, Block previous, SPList source) {
+	Block next = previous == NULL ? target->firstBlock : previous->next;
+	source->firstBlock->previous = previous;
+	source->lastBlock->next = next;
+	if (previous == NULL) {
+		target->firstBlock = source->firstBlock;
+	} else {
+		previous->next = source->firstBlock;
+	}
+	if (next == NULL) {
+		target->lastBlock = source->lastBlock;
+	} else {
+		next->previous = source->lastBlock;
+	}
+	target->size += source->size;
+	source->firstBlock = NULL;
+	source->lastBlock = NULL;
+	source->currentBlock = NULL;
+	source->size = 0;
+}
+
+// Makes list hold a reference to pool if it is not its own pool, returns false if an allocation failed
+static bool listBorrowPool(SPList list, SPListNodePool pool) {
+	SPListNodePool* grown;
+	int i;
+	if (pool == list->pool) {
+		return true;
+	}
+	for (i = 0; i < list->borrowedCount; i++) {
+		if (list->borrowedPools[i] == pool) {
+			return true;
+		}
+	}
+	grown = (SPListNodePool*) realloc(list->borrowedPools, sizeof(SPListNodePool)*(list->borrowedCount + 1));
+	if (grown == NULL) {
+		return false;
+	}
+	list->borrowedPools = grown;
+	list->borrowedPools[list->borrowedCount++] = pool;
+	__atomic_add_fetch(&pool->references, 1, __ATOMIC_RELAXED);
+	return true;
+}
+
+// Makes target hold a reference to every pool which may hold nodes of source,
+// so the nodes of source can be relinked into target. Nodes which target
+// removes later go to the free list of its own pool, so the free lists of the
+// pools are still used only by the lists of each pool.
+static bool listBorrowPools(SPList target, SPList source) {
+	int i;
+	if (!listBorrowPool(target, source->pool)) {
+		return false;
+	}
+	for (i = 0; i < source->borrowedCount; i++) {
+		if (!listBorrowPool(target, source->borrowedPools[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Returns true if the nodes of source can be relinked into target, taking references to their pools
+static bool canRelink(SPList target, SPList source) {
+	if (target->backend != source->backend) {
+		return false;
+	} else if (target->backend == SP_LIST_LINKED_BACKEND) {
+		return listBorrowPools(target, source);
+	}
+	return target->backend == SP_LIST_UNROLLED_BACKEND;
+}
+
+SP_LIST_MSG spListConcat(SPList target, SPList source) {
+	if (target == NULL || source == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (target == source) {
+		return SP_LIST_INVALID_ARGUMENT;
+	}
+	if (source->size == 0) {
+		return SP_LIST_SUCCESS;
+	} else if (!canRelink(target, source)) {
+		return moveByCopy(target, source, false);
+	} else if (target->backend == SP_LIST_UNROLLED_BACKEND) {
+		unrolledSpliceAfter(target, target->lastBlock, source);
+	} else {
+		linkedSpliceBefore(target, target->tail, source);
+	}
+	return SP_LIST_SUCCESS;
+}
+
+SP_LIST_MSG spListSplice(SPList target, SPList source) {
+	Block block;
+	if (target == NULL || source == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (target == source) {
+		return SP_LIST_INVALID_ARGUMENT;
+	}
+	if (!hasCurrent(target)) {
+		return SP_LIST_INVALID_CURRENT;
+	}
+	if (source->size == 0) {
+		return SP_LIST_SUCCESS;
+	} else if (!canRelink(target, source)) {
+		return moveByCopy(target, source, true);
+	} else if (target->backend == SP_LIST_UNROLLED_BACKEND) {
+		block = target->currentBlock;
+		if (target->currentOffset > 0) { // The current element starts a block
+			if (blockSplitAt(target, block, target->currentOffset) == NULL) {
+				return SP_LIST_OUT_OF_MEMORY;
+			}
+		} else {
+			block = block->previous;
+		}
+		unrolledSpliceAfter(target, block, source);
+	} else {
+		linkedSpliceBefore(target, target->current, source);
+	}
+	return SP_LIST_SUCCESS;
+}
+
+SPList spListSplitAtCurrent(SPList list) {
+	SPList newList;
+	Block block;
+	Node forward, backward;
+	int count;
+	if (list == NULL || !hasCurrent(list)) {
+		return NULL;
+	}
+	if (list->backend == SP_LIST_LINKED_BACKEND) {
+		newList = spListCreateWithPool(list->pool); // Shares the nodes
+		if (newList != NULL && !listBorrowPools(newList, list)) {
+			spListDestroy(newList);
+			return NULL;
+		}
+	} else {
+		newList = spListCreateWithBackend(list->backend);
+	}
+	if (newList == NULL) {
+		return NULL;
+	}
+	if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		count = list->size - list->currentIndex;
+		if (!vectorReserve(newList, count)) {
+			spListDestroy(newList);
+			return NULL;
+		}
+		memcpy(newList->array, list->array + list->currentIndex,
+				sizeof(struct sp_list_element_t)*count);
+		newList->size = count;
+		list->size -= count;
+	} else if (list->backend == SP_LIST_UNROLLED_BACKEND) {
+		block = list->currentBlock;
+		if (list->currentOffset > 0) {
+			block = blockSplitAt(list, block, list->currentOffset);
+			if (block == NULL) {
+				spListDestroy(newList);
+				return NULL;
+			}
+		}
+		newList->firstBlock = block;
+		newList->lastBlock = list->lastBlock;
+		list->lastBlock = block->previous;
+		if (block->previous == NULL) {
+			list->firstBlock = NULL;
+		} else {
+			block->previous->next = NULL;
+		}
+		block->previous = NULL;
+		for (count = 0; block != NULL; block = block->next) {
+			count += block->count;
+		}
+		newList->size = count;
+		list->size -= count;
+	} else {
+		// Counts the moved nodes by walking both ways from current, so the
+		// walk is as long as the shorter part
+		forward = list->current;
+		backward = list->current->previous;
+		for (count = 0; forward != list->tail && backward != list->head; count++) {
+			forward = forward->next;
+			backward = backward->previous;
+		}
+		if (forward == list->tail) {
+			newList->size = count;
+		} else {
+			newList->size = list->size - count;
+		}
+		newList->head->next = list->current;
+		newList->tail->previous = list->tail->previous;
+		list->tail->previous = list->current->previous;
+		list->current->previous->next = list->tail;
+		newList->head->next->previous = newList->head;
+		newList->tail->previous->next = newList->tail;
+		list->size -= newList->size;
+	}
+	list->current = NULL;
+	list->currentBlock = NULL;
+	list->currentIndex = -1;
+	return newList;
+}
+
+/*
+ * Sorting helpers.
+ * The comparison is NULL for the spListElementCompare ordering, which is
+ * then done inline.
+ */
+
+static int sortCompare(SPListCompareFunction cmp, struct sp_list_element_t* e1,
+		struct sp_list_element_t* e2) {
+	if (cmp != NULL) {
+		return cmp(e1, e2);
+	}
+	return spListElementOrder(e1, e2);
+}
+
+// Bottom-up merge sort of a NULL terminated chain of nodes linked through
+// next, returns the new first node. The previous links are not updated.
+static Node linkedMergeSort(Node first, SPListCompareFunction cmp) {
+	Node p, q, e, last;
+	int width, pSize, qSize, merges;
+	for (width = 1; ; width *= 2) {
+		p = first;
+		first = NULL;
+		last = NULL;
+		merges = 0;
+		while (p != NULL) { // Merges the runs starting at p and q
+			merges++;
+			q = p;
+			for (pSize = 0; pSize < width && q != NULL; pSize++) {
+				q = q->next;
+			}
+			qSize = width;
+			while (pSize > 0 || (qSize > 0 && q != NULL)) {
+				if (pSize == 0 || (qSize > 0 && q != NULL
+						&& sortCompare(cmp, &q->data, &p->data) < 0)) { // Stable
+					e = q;
+					q = q->next;
+					qSize--;
+				} else {
+					e = p;
+					p = p->next;
+					pSize--;
+				}
+				if (last == NULL) {
+					first = e;
+				} else {
+					last->next = e;
+				}
+				last = e;
+			}
+			p = q;
+		}
+		last->next = NULL;
+		if (merges <= 1) {
+			return first;
+		}
+	}
+}
+
+// Bottom-up merge sort of elements[0..size) using a buffer of the same size
+static void arrayMergeSort(struct sp_list_element_t* elements, struct sp_list_element_t* buffer,
+		int size, SPListCompareFunction cmp) {
+	struct sp_list_element_t* source = elements;
+	struct sp_list_element_t* target = buffer;
+	struct sp_list_element_t* temp;
+	int width, left, middle, right, i, j, k;
+	for (width = 1; width < size; width *= 2) {
+		for (left = 0; left < size; left += 2 * width) {
+			middle = left + width < size ? left + width : size;
+			right = left + 2 * width < size ? left + 2 * width : size;
+			for (i = left, j = middle, k = left; k < right; k++) {
+				if (i < middle && (j == right || sortCompare(cmp, &source[j], &source[i]) >= 0)) {
+					target[k] = source[i++];
+				} else {
+					target[k] = source[j++];
+				}
+			}
+		}
+		temp = source;
+		source = target;
+		target = temp;
+	}
+	if (source != elements) {
+		memcpy(elements, source, sizeof(struct sp_list_element_t)*size);
+	}
+}
+
+SP_LIST_MSG spListSort(SPList list, SPListCompareFunction cmp) {
+	struct sp_list_element_t* elements;
+	struct sp_list_element_t* buffer;
+	Block block;
+	Node node, previous;
+	int i = 0;
+	if (list == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (cmp == spListElementCompare) {
+		cmp = NULL;
+	}
+	list->current = NULL;
+	list->currentBlock = NULL;
+	list->currentIndex = -1;
+	if (list->size < 2) {
+		return SP_LIST_SUCCESS;
+	}
+	if (list->backend == SP_LIST_LINKED_BACKEND) {
+		list->tail->previous->next = NULL;
+		node = linkedMergeSort(list->head->next, cmp);
+		for (previous = list->head; node != NULL; previous = node, node = node->next) {
+			previous->next = node;
+			node->previous = previous;
+		}
+		previous->next = list->tail;
+		list->tail->previous = previous;
+		return SP_LIST_SUCCESS;
+	}
+	// The array backends sort through a temporary buffer
+	buffer = (struct sp_list_element_t*) malloc(sizeof(struct sp_list_element_t)*list->size
+			* (list->backend == SP_LIST_VECTOR_BACKEND ? 1 : 2));
+	if (buffer == NULL) {
+		return SP_LIST_OUT_OF_MEMORY;
+	}
+	if (list->backend == SP_LIST_VECTOR_BACKEND) {
+		arrayMergeSort(list->array, buffer, list->size, cmp);
+	} else {
+		elements = buffer + list->size;
+		for (block = list->firstBlock; block != NULL; block = block->next) {
+			memcpy(elements + i, block->elements, sizeof(struct sp_list_element_t)*block->count);
+			i += block->count;
+		}
+		arrayMergeSort(elements, buffer, list->size, cmp);
+		for (i = 0, block = list->firstBlock; block != NULL; block = block->next) {
+			memcpy(block->elements, elements + i, sizeof(struct sp_list_element_t)*block->count);
+			i += block->count;
+		}
+	}
+	free(buffer);
+	return SP_LIST_SUCCESS;
+}
+
 void spListDestroy(SPList list) {
 	if (list == NULL) {
 		return;
 	}
 	spListClear(list);
-	destroyNode(list->head);
-	destroyNode(list->tail);
+	poolRelease(list->pool);
+	while (list->borrowedCount > 0) {
+		poolRelease(list->borrowedPools[--list->borrowedCount]);
+	}
+	free(list->borrowedPools);
+	free(list->spareBlock);
+	free(list->array);
 	free(list);
 }
@@ -13,6 +13,70 @@
  * where the state of the iterator after calling that function is not stated,
  * the state of the iterator is undefined. That is you cannot assume anything about it.
  *
+ * Each node stores the copy of its element by value, and the elements returned
+ * by the spListGet functions point into the node. Such an element belongs to
+ * the list: it may be read or modified through the SPListElement functions,
+ * but must not be destroyed, and is only valid until it is removed from the
+ * list.
+ *
+ * The nodes of a list are taken from a node pool (SPListNodePool). A pool allocates nodes in chunks and keeps
+ * removed nodes in a free list, so once a list has grown, inserting and
+ * removing elements does not call the system allocator. By default every
+ * list has a private pool. Many short lived lists can share a single pool
+ * using spListCreateWithPool, so the nodes freed by one list are reused by
+ * the next one. A pool is not thread safe: all the lists sharing a pool must
+ * be used by one thread at a time. When nodes are moved to a list of another
+ * pool (see spListConcat), that list keeps a reference to their pool until it
+ * is destroyed, and returns the nodes it removes to its own pool. So moving
+ * the result list of a thread into a list of another thread is safe, and
+ * each pool is still used only by the lists created with it.
+ *
+ * A list stores its elements in one of the following backends, chosen when
+ * it is created (see SP_LIST_BACKEND):
+ *
+ *   SP_LIST_LINKED_BACKEND   - A doubly linked list with one element per node.
+ *                              This is the default backend.
+ *   SP_LIST_UNROLLED_BACKEND - A doubly linked list of blocks, each holding up
+ *                              to 16 consecutive elements. Traversal and
+ *                              ordered insertion read whole blocks instead of
+ *                              following a pointer per element. Inserting or
+ *                              removing an element moves the other elements of
+ *                              its block, so the elements returned by the
+ *                              spListGet functions are only valid until the
+ *                              list is modified.
+ *   SP_LIST_VECTOR_BACKEND   - A dynamic array. Appending with
+ *                              spListInsertLast is amortized O(1), spListGetAt
+ *                              is O(1) and spListCopy is a single memcpy, but
+ *                              inserting or removing an element moves all the
+ *                              elements after it. This suits lists which are
+ *                              built once and then only scanned. As with the
+ *                              unrolled backend, the elements returned by the
+ *                              spListGet functions are only valid until the
+ *                              list is modified.
+ *
+ * All backends support the whole interface with the same iterator semantics.
+ *
+ * Besides the internal iterator, a list can be traversed and modified with
+ * external iterators (SPListIter). An external iterator is a small value which
+ * holds its own position, so any number of them can traverse the same list at
+ * once, and reading through them never modifies the list. As long as the list
+ * is not modified, many threads may read it concurrently using external
+ * iterators, spListGetSize, spListCopy and spListToArray (but not the
+ * internal iterator). Inserting or removing an element through the internal
+ * iterator or through an external iterator keeps that iterator valid as
+ * documented below, but makes all other external iterators of the list
+ * undefined. For example:
+ * @code
+ * double sumValues(SPList list) {
+ *   double sum = 0.0;
+ *   for (SPListIter iter = spListIterBegin(list); spListIterGet(&iter) != NULL;
+ *       spListIterNext(&iter)) {
+ *     sum += spListElementGetValue(spListIterGet(&iter));
+ *   }
+ *   return sum;
+ * }
+ * @endcode
+ *
  * The following functions are available:
  *
  *   spListCreate               - Creates a new empty list
@@ -44,19 +108,73 @@
  *   spListGetPrevious		    - Moves the list's iterator to the previous element
  *                                and return it
  *   spListClear		      	- Clears all the data from the list
+ *   spListCreateWithPool       - Creates a new empty list using a shared pool
+ *   spListNodePoolCreate       - Creates a node pool which lists can share
+ *   spListNodePoolDestroy      - Releases a node pool
+ *   spListCreateWithBackend    - Creates a new empty list using a given backend
+ *   spListGetBackend           - Returns the backend of a given list
+ *   spListGetAt                - Sets the internal iterator to the i-th element
+ *                                and returns it
+ *   spListToArray              - Copies the indices and values of all the
+ *                                elements to arrays
+ *   spListIterBegin            - Returns an external iterator to the first element
+ *   spListIterLast             - Returns an external iterator to the last element
+ *   spListIterGet              - Returns the element of an external iterator
+ *   spListIterNext             - Advances an external iterator and returns its
+ *                                element
+ *   spListIterPrevious         - Moves an external iterator back and returns its
+ *                                element
+ *   spListIterInsertBefore     - Inserts an element before an external iterator
+ *   spListIterInsertAfter      - Inserts an element after an external iterator
+ *   spListIterRemove           - Removes the element of an external iterator
+ *   spListConcat               - Moves all the elements of a list to the end of
+ *                                another list
+ *   spListSplice               - Moves all the elements of a list before the
+ *                                current element of another list
+ *   spListSplitAtCurrent       - Moves the current element and all the elements
+ *                                after it to a new list
+ *   spListSort                 - Sorts a list
  */
 
 /** Type for defining the list */
 typedef struct sp_list_t *SPList;
 
+/** Type for defining a pool of list nodes, which many lists can share */
+typedef struct sp_list_node_pool_t *SPListNodePool;
+
+/** Type used for choosing how a list stores its elements */
+typedef enum sp_list_backend_t {
+	SP_LIST_LINKED_BACKEND,
+	SP_LIST_UNROLLED_BACKEND,
+	SP_LIST_VECTOR_BACKEND,
+} SP_LIST_BACKEND;
+
 /** Type used for returning error codes from list functions */
 typedef enum sp_list_msg_t {
 	SP_LIST_SUCCESS,
 	SP_LIST_NULL_ARGUMENT,
 	SP_LIST_OUT_OF_MEMORY,
 	SP_LIST_INVALID_CURRENT,
+	SP_LIST_INVALID_ARGUMENT,
 } SP_LIST_MSG;
 
+/**
+ * A comparison function for sorting lists, which returns a negative number,
+ * zero or a positive number if e1 is less than, equal to or greater than e2,
+ * as spListElementCompare does.
+ */
+typedef int (*SPListCompareFunction)(SPListElement e1, SPListElement e2);
+
+/**
+ * An external iterator over a list. It is passed by value and needs no
+ * cleanup. Its fields are private, use the spListIter functions only.
+ */
+typedef struct sp_list_iter_t {
+	SPList list;
+	void* node; // The node or block of the element
+	int offset; // The position of the element in its block or vector
+} SPListIter;
+
 /**
  * Allocates a new List.
  *
@@ -67,12 +185,69 @@ typedef enum sp_list_msg_t {
  */
 SPList spListCreate();
 
+/**
+ * Allocates a new List which stores its elements in the given backend.
+ * spListCreate() is the same as spListCreateWithBackend(SP_LIST_LINKED_BACKEND).
+ *
+ * @param backend The storage of the list.
+ * @return
+ * 	NULL - If allocations failed.
+ * 	A new List in case of success.
+ */
+SPList spListCreateWithBackend(SP_LIST_BACKEND backend);
+
+/**
+ * Returns the backend of a list. the iterator state will not change.
+ *
+ * @param list The target list.
+ * @return
+ * SP_LIST_LINKED_BACKEND if list is NULL, the backend of list otherwise.
+ */
+SP_LIST_BACKEND spListGetBackend(SPList list);
+
+/**
+ * Allocates a new List whose nodes are taken from the given pool. The list
+ * uses the SP_LIST_LINKED_BACKEND backend.
+ *
+ * The list holds a reference to the pool, so the pool stays valid until the
+ * list is destroyed, even if spListNodePoolDestroy was called before.
+ *
+ * @param pool The pool the nodes of the list are taken from.
+ * @return
+ * 	NULL - If pool is NULL or allocations failed.
+ * 	A new List in case of success.
+ */
+SPList spListCreateWithPool(SPListNodePool pool);
+
+/**
+ * Allocates a new node pool, which can be shared by many lists.
+ *
+ * The pool allocates nodes in chunks. The first chunk holds chunkSize
+ * nodes, and every following chunk is twice as large as the previous one,
+ * up to a limit.
+ *
+ * @param chunkSize The number of nodes in the first chunk (chunkSize > 0).
+ * @return
+ * 	NULL - If chunkSize <= 0 or allocations failed.
+ * 	A new empty pool in case of success.
+ */
+SPListNodePool spListNodePoolCreate(int chunkSize);
+
+/**
+ * Releases the reference of the creator to a node pool. The memory of the
+ * pool is freed once all lists using it were destroyed as well.
+ *
+ * @param pool Target pool to release. If pool is NULL nothing will be done
+ */
+void spListNodePoolDestroy(SPListNodePool pool);
+
 /**
  * Creates a copy of target list.
  *
  * The new copy will contain all the elements from the source list in the same
- * order. The internal iterator for both the new copy and the target list will not be
- * defined afterwards.
+ * order, and uses the same backend with a private pool. The internal iterator
+ * of the source list will not change, and the internal iterator of the new
+ * copy will not be defined.
  *
  * @param list The target list to copy
  * @return
@@ -175,6 +350,213 @@ SPListElement spListGetPrevious(SPList list);
  */
 SPListElement spListGetCurrent(SPList list);
 
+/**
+ * Sets the internal iterator to the i-th element (counting from 0) and
+ * retrieves it. This is O(1) for SP_LIST_VECTOR_BACKEND lists, and takes
+ * linear time for the other backends.
+ *
+ * @param list The list for which to set the iterator
+ * @param i The position of the requested element
+ * @return
+ * NULL if a NULL pointer was sent or i is not in the range [0, size)
+ * The i-th element of the list otherwise
+ */
+SPListElement spListGetAt(SPList list, int i);
+
+/**
+ * Copies the indices and values of all the elements of the list, in order,
+ * to two arrays. The output can be passed directly to functions which take
+ * parallel index and value buffers, such as spBPQueueEnqueueSorted. The
+ * iterator state will not change.
+ *
+ * @param list The source list
+ * @param indices An array of at least spListGetSize(list) ints, which
+ * receives the indices
+ * @param values An array of at least spListGetSize(list) doubles, which
+ * receives the values
+ * @return
+ * -1 if a NULL pointer was sent
+ * The number of elements copied otherwise
+ */
+int spListToArray(SPList list, int* indices, double* values);
+
+/**
+ * Returns an external iterator pointing to the first element of the list.
+ * The state of the internal iterator will not change.
+ *
+ * @param list The list to iterate over
+ * @return
+ * An invalid iterator (spListIterGet returns NULL) if list is NULL or empty.
+ * An iterator pointing to the first element otherwise.
+ */
+SPListIter spListIterBegin(SPList list);
+
+/**
+ * Returns an external iterator pointing to the last element of the list.
+ * The state of the internal iterator will not change.
+ *
+ * @param list The list to iterate over
+ * @return
+ * An invalid iterator (spListIterGet returns NULL) if list is NULL or empty.
+ * An iterator pointing to the last element otherwise.
+ */
+SPListIter spListIterLast(SPList list);
+
+/**
+ * Returns the element an external iterator points to. Neither the list nor
+ * the iterator are modified.
+ *
+ * @param iter The iterator
+ * @return
+ * NULL if iter is NULL or invalid
+ * The element pointed by iter otherwise
+ */
+SPListElement spListIterGet(const SPListIter* iter);
+
+/**
+ * Advances an external iterator to the next element and returns it. If there
+ * is no next element, the iterator becomes invalid.
+ *
+ * @param iter The iterator to advance
+ * @return
+ * NULL if reached the end of the list, or iter is NULL or invalid
+ * The next element otherwise
+ */
+SPListElement spListIterNext(SPListIter* iter);
+
+/**
+ * Moves an external iterator to the previous element and returns it. If there
+ * is no previous element, the iterator becomes invalid.
+ *
+ * @param iter The iterator to move
+ * @return
+ * NULL if reached the start of the list, or iter is NULL or invalid
+ * The previous element otherwise
+ */
+SPListElement spListIterPrevious(SPListIter* iter);
+
+/**
+ * Inserts a copy of an element right before the element of an external
+ * iterator. The iterator keeps pointing to the same element, and so does the
+ * internal iterator.
+ *
+ * @param iter The iterator
+ * @param element The element to insert. A copy of the element will be inserted
+ * @return
+ * SP_LIST_NULL_ARGUMENT if iter, its list or element are NULL
+ * SP_LIST_INVALID_CURRENT if iter is invalid
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spListIterInsertBefore(SPListIter* iter, SPListElement element);
+
+/**
+ * Inserts a copy of an element right after the element of an external
+ * iterator. The iterator keeps pointing to the same element, and so does the
+ * internal iterator.
+ *
+ * @param iter The iterator
+ * @param element The element to insert. A copy of the element will be inserted
+ * @return
+ * SP_LIST_NULL_ARGUMENT if iter, its list or element are NULL
+ * SP_LIST_INVALID_CURRENT if iter is invalid
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spListIterInsertAfter(SPListIter* iter, SPListElement element);
+
+/**
+ * Removes the element of an external iterator. The iterator is moved to the
+ * element after the removed one, or becomes invalid if it was the last one.
+ * The internal iterator keeps pointing to the same element, unless it pointed
+ * to the removed element, in which case it is not defined afterwards.
+ *
+ * @param iter The iterator
+ * @return
+ * SP_LIST_NULL_ARGUMENT if iter or its list are NULL
+ * SP_LIST_INVALID_CURRENT if iter is invalid
+ * SP_LIST_SUCCESS the element was removed successfully
+ */
+SP_LIST_MSG spListIterRemove(SPListIter* iter);
+
+/**
+ * Moves all the elements of source to the end of target, leaving source
+ * empty. The elements are relinked in O(1) without being copied if both lists
+ * use SP_LIST_UNROLLED_BACKEND or both use SP_LIST_LINKED_BACKEND. If two
+ * linked lists use different pools, target takes a reference to the pools of
+ * the nodes of source, which takes time proportional to the number of pools
+ * target already references. Otherwise the elements are copied. The
+ * internal iterator of target will not change, and the one of source will
+ * not be defined.
+ *
+ * @param target The list which receives the elements
+ * @param source The list whose elements are moved
+ * @return
+ * SP_LIST_NULL_ARGUMENT if target or source are NULL
+ * SP_LIST_INVALID_ARGUMENT if target and source are the same list
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed, in which case target may
+ * hold copies of some of the elements of source, and source is not changed
+ * SP_LIST_SUCCESS the elements were moved successfully
+ */
+SP_LIST_MSG spListConcat(SPList target, SPList source);
+
+/**
+ * Moves all the elements of source right before the current element of target
+ * (as pointed by its internal iterator), leaving source empty. The elements
+ * are relinked or copied as in spListConcat. The internal iterator of target
+ * keeps pointing to the same element, and the one of source will not be
+ * defined.
+ *
+ * @param target The list which receives the elements
+ * @param source The list whose elements are moved
+ * @return
+ * SP_LIST_NULL_ARGUMENT if target or source are NULL
+ * SP_LIST_INVALID_ARGUMENT if target and source are the same list
+ * SP_LIST_INVALID_CURRENT if the internal iterator of target is invalid
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed, in which case target may
+ * hold copies of some of the elements of source, and source is not changed
+ * SP_LIST_SUCCESS the elements were moved successfully
+ */
+SP_LIST_MSG spListSplice(SPList target, SPList source);
+
+/**
+ * Moves the current element of the list (as pointed by its internal iterator)
+ * and all the elements after it to a new list, which uses the same backend.
+ * A SP_LIST_LINKED_BACKEND list keeps its nodes, and the new list shares its
+ * pool. An SP_LIST_UNROLLED_BACKEND list keeps its blocks, except that the
+ * block of the current element may be split. Both take time proportional to
+ * the number of nodes or blocks walked to update the sizes, which for linked
+ * lists is the smaller of the two parts. SP_LIST_VECTOR_BACKEND lists copy
+ * the moved elements. The internal iterator of both lists will not be defined
+ * afterwards.
+ *
+ * @param list The list to split
+ * @return
+ * NULL if list is NULL, its internal iterator is invalid or an allocation
+ * failed, in which case list is not changed.
+ * A new list holding the moved elements otherwise.
+ */
+SPList spListSplitAtCurrent(SPList list);
+
+/**
+ * Sorts the elements of a list in ascending order, using a stable bottom-up
+ * merge sort which takes O(n log n) time. A SP_LIST_LINKED_BACKEND list is
+ * sorted by relinking its nodes, without allocating memory. The other
+ * backends sort through a temporary buffer. If cmp is NULL or
+ * spListElementCompare, elements are compared by value and then by index
+ * without calling cmp. The state of the internal iterator will not be defined
+ * afterwards.
+ *
+ * @param list The list to sort
+ * @param cmp The comparison function, or NULL for the spListElementCompare order
+ * @return
+ * SP_LIST_NULL_ARGUMENT if list is NULL
+ * SP_LIST_OUT_OF_MEMORY if the temporary buffer could not be allocated, in
+ * which case the list is not changed
+ * SP_LIST_SUCCESS the list was sorted successfully
+ */
+SP_LIST_MSG spListSort(SPList list, SPListCompareFunction cmp);
+
 /**
  * Adds a new element to the list, the new element will be the first element. The state
  * of the iterator will not be changed
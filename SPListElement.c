@@ -1,12 +1,8 @@
 #include "SPListElement.h"
+#include "SPListElementInternal.h"
 #include <stdlib.h> // malloc, free
 #include <assert.h> // assert
 
-struct sp_list_element_t {
-	int index;
-	double value;
-};
-
 SPListElement spListElementCreate(int index, double value) {
 	SPListElement temp = NULL;
 	if (index < 0 || value <0.0) {
@@ -79,11 +75,5 @@ double spListElementGetValue(SPListElement data) {
 
 int spListElementCompare(SPListElement e1, SPListElement e2) {
 	assert(e1!=NULL && e2!=NULL);
-	if (e1->value == e2->value) {
-		return e1->index - e2->index;
-	} else if(e1->value > e2->value) {
-		return 1;
-	} else {
-		return -1;
-	}
+	return spListElementOrder(e1, e2);
 }
@@ -0,0 +1,50 @@
+#ifndef SPLISTELEMENTINTERNAL_H_
+#define SPLISTELEMENTINTERNAL_H_
+#include "SPListElement.h"
+#include <stdint.h> // uint64_t
+#include <string.h> // memcpy
+/**
+ * The layout of SPListElement, shared by the containers of this library so
+ * they can store elements inside their own memory instead of allocating each
+ * element separately. Users of SPListElement must not include this header,
+ * which SPSmallBPQueue.h includes only for its inline functions.
+ */
+struct sp_list_element_t {
+	int index;
+	double value;
+};
+
+/**
+ * Maps a value (value >= 0.0) to an unsigned integer which orders as the
+ * value does. The bit pattern of a non negative double grows with the value,
+ * so the only fix needed is folding -0.0 into 0.0, which adding 0.0 does.
+ */
+static inline uint64_t spListElementValueKey(double value) {
+	uint64_t key;
+	value += 0.0;
+	memcpy(&key, &value, sizeof(key));
+	return key;
+}
+
+/**
+ * Compares two elements given as (value key, index) pairs, in the
+ * spListElementCompare order, without branches: the value decides unless the
+ * keys are equal, and then the index does.
+ *
+ * @return -1, 0 or 1 if the first element is lower, equal or greater
+ */
+static inline int spListElementKeyCompare(uint64_t value1, int index1,
+		uint64_t value2, int index2) {
+	int order = 2 * ((value1 > value2) - (value1 < value2))
+			+ ((index1 > index2) - (index1 < index2));
+	return (order > 0) - (order < 0);
+}
+
+/** Compares two elements as spListElementKeyCompare does **/
+static inline int spListElementOrder(const struct sp_list_element_t* e1,
+		const struct sp_list_element_t* e2) {
+	return spListElementKeyCompare(spListElementValueKey(e1->value), e1->index,
+			spListElementValueKey(e2->value), e2->index);
+}
+
+#endif /* SPLISTELEMENTINTERNAL_H_ */
@@ -1,149 +1,1029 @@
+#define _POSIX_C_SOURCE 200809L
 #include "SPLogger.h"
-#include <stdio.h> // FILE, stdout, fopen, fclose, sprintf, printf, fflush, stdout
+#include "SPLoggerBinary.h"
+#include <stdio.h> // FILE, stdout, fopen, fclose, snprintf, vsnprintf, fwrite, fflush, rename
 #include <stdlib.h> // malloc, free
 #include <stdbool.h> // bool, true, false
-#include <string.h> // strlen, strcat
+#include <stdarg.h> // va_list, va_start, va_end
+#include <string.h> // strlen, strcpy, memcpy
+#include <pthread.h> // pthread_create, pthread_join, pthread_mutex_t, pthread_cond_t
+#include <time.h> // clock_gettime, nanosleep
+#include <fcntl.h> // open, posix_fallocate
+#include <errno.h> // EINVAL, EOPNOTSUPP
+#include <unistd.h> // ftruncate, close
+#include <sys/mman.h> // mmap, munmap, msync
 
 #define SP_LOGGER_OPEN_MODE "w" //File open mode
+#define SP_LOGGER_DEFAULT_QUEUE_CAPACITY 1024 // Records
+#define SP_LOGGER_DEFAULT_RECORD_SIZE 1024 // Bytes
+#define SP_LOGGER_WRITER_WAIT_NS 10000000L // Longest sleep of an idle writer thread
+#define SP_LOGGER_PRODUCER_WAIT_NS 50000L // Sleep of a print call waiting for a free record
+#define SP_LOGGER_DEFAULT_SEGMENTS_NUM 4 // Segment files kept
+#define SP_LOGGER_SEGMENT_MODE 0644 // Permissions of a new segment file
 
 SPLogger logger = NULL; // Global variable holding the logger
+int spLoggerEnabledLevel = -1; // The level of the logger, read by the SP_LOG_* macros
+static __thread char threadBuffer[SP_LOGGER_MAX_MESSAGE_SIZE]; // Messages are formatted here
+static __thread char recordBuffer[SP_LOGGER_MAX_MESSAGE_SIZE]; // Binary records of formatted messages
+static pthread_mutex_t siteMutex = PTHREAD_MUTEX_INITIALIZER; // Guards the definition of call sites
+static unsigned int loggerGeneration = 0; // Counts the created loggers, so sites know their log
+
+/*
+ * Every thread which prints has a staging area, registered in a list when the
+ * thread first prints. A print call holds the mutex of its own staging area,
+ * which no other print call takes, so print calls of different threads do not
+ * wait for each other. Creating and destroying the logger takes the mutexes of
+ * all the staging areas, so the logger never changes under a print call.
+ */
+typedef struct sp_logger_staging_t {
+	pthread_mutex_t mutex; // Held by the thread while it prints, and while others drain it
+	char* buffer; // Whole messages waiting to be written, used by synchronous loggers with staging
+	size_t length; // The number of bytes in the buffer
+	size_t size; // The allocated size of the buffer
+	bool registered; // Indicates if the staging area is in the list
+	struct sp_logger_staging_t* next;
+} SPLoggerStaging;
+
+static __thread SPLoggerStaging threadStaging = {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, false, NULL};
+static SPLoggerStaging* stagings = NULL; // The registered staging areas
+static pthread_mutex_t loggerMutex = PTHREAD_MUTEX_INITIALIZER; // Guards the logger and the list of staging areas
+static pthread_once_t stagingKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t stagingKey; // Drains and removes the staging area of an exiting thread
 
 struct sp_logger_t {
-	FILE* outputChannel; // The logger file
+	FILE* outputChannel; // The logger file, NULL if the log is written to segments
 	bool isStdOut; // Indicates if the logger is stdout
+	/*
+	 * Segment mode: the log is written to a file mapped to memory, of
+	 * segmentSize bytes. When a message does not fit, the file is cut to its
+	 * used length and renamed to "<filename>.1" (shifting older segments up to
+	 * "<filename>.<segmentsNum - 1>", and removing the oldest), and a new
+	 * segment is started. All writes to the sink are made by one thread at a
+	 * time: under sinkMutex, or by the writer thread.
+	 */
+	char* segment; // The mapped current segment
+	int segmentFd;
+	size_t segmentSize;
+	size_t segmentUsed; // The number of bytes written to the current segment
+	int segmentsNum; // The number of segment files kept, including the current one
+	char* segmentName; // The filename
+	char* segmentFrom; // Names of older segments, room for the filename and a number
+	char* segmentTo;
 	SP_LOGGER_LEVEL level; // Indicates the level
+	bool isAsync; // Indicates if the messages are written by the writer thread
+	bool isBinary; // Indicates if the messages are written as binary records
+	size_t stagingSize; // The size of the staging buffer of each thread, 0 for none
+	pthread_mutex_t sinkMutex; // Guards the writes of synchronous mode
+	unsigned int generation; // The value of loggerGeneration when the logger was created
+	unsigned int sitesNum; // The number of call sites defined in the log
+	/*
+	 * Asynchronous mode: a bounded multi producer ring of records. Each record
+	 * has a sequence number telling whose turn it is: record i is free for the
+	 * print call holding ticket t when its sequence is t (t = i mod capacity),
+	 * and ready for the writer when its sequence is t + 1. The writer then sets
+	 * it to t + capacity, freeing it for the next round.
+	 */
+	SP_LOGGER_OVERFLOW_POLICY overflowPolicy;
+	size_t capacity; // The number of records, a power of 2
+	size_t recordSize; // The size of a record, including its new line
+	char* records; // capacity records of recordSize bytes
+	size_t* lengths; // The length of the message in each record
+	size_t* sequences; // The sequence number of each record
+	size_t tail; // The next ticket, taken by print calls
+	size_t head; // The next record to write, used by the writer thread
+	size_t written; // The number of records written and flushed
+	long long dropped; // The number of dropped messages
+	bool writeFailed; // Set by the writer thread when a write fails
+	bool stop; // Tells the writer thread to write the queued records and exit
+	bool writerSleeping; // Set while the writer thread waits for records
+	pthread_t writer;
+	pthread_mutex_t mutex; // Guards the sleep of the writer thread
+	pthread_cond_t wakeup;
 };
 
+static void sleepNanoseconds(long ns) {
+	struct timespec duration;
+	duration.tv_sec = 0;
+	duration.tv_nsec = ns;
+	nanosleep(&duration, NULL);
+}
+
+static bool recordReady(SPLogger source, size_t ticket) {
+	return __atomic_load_n(&source->sequences[ticket & (source->capacity - 1)], __ATOMIC_ACQUIRE)
+			== ticket + 1;
+}
+
+static void wakeWriter(SPLogger source) {
+	__atomic_thread_fence(__ATOMIC_SEQ_CST); // Order the record publication before the check
+	if (__atomic_load_n(&source->writerSleeping, __ATOMIC_SEQ_CST)) {
+		pthread_mutex_lock(&source->mutex);
+		pthread_cond_signal(&source->wakeup);
+		pthread_mutex_unlock(&source->mutex);
+	}
+}
+
+// Maps a new empty segment to the filename
+static bool segmentOpen(SPLogger target) {
+	// Function variables
+	int error;
+	// Function code
+	target->segmentUsed = 0;
+	target->segmentFd = open(target->segmentName, O_RDWR | O_CREAT | O_TRUNC, SP_LOGGER_SEGMENT_MODE);
+	if (target->segmentFd < 0) {
+		target->segment = NULL;
+		return false;
+	}
+	// Preallocate the blocks, so a full disk fails here rather than raising SIGBUS on a write
+	error = posix_fallocate(target->segmentFd, 0, (off_t) target->segmentSize);
+	if (error != 0 && ((error != EINVAL && error != EOPNOTSUPP) // Only set the size if not supported
+			|| ftruncate(target->segmentFd, (off_t) target->segmentSize) != 0)) {
+		close(target->segmentFd);
+		target->segment = NULL;
+		return false;
+	}
+	target->segment = (char*) mmap(NULL, target->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+			target->segmentFd, 0);
+	if (target->segment == MAP_FAILED) {
+		close(target->segmentFd);
+		target->segment = NULL;
+		return false;
+	}
+	return true;
+}
+
+// Unmaps the current segment and cuts its file to the written length
+static void segmentClose(SPLogger target) {
+	if (target->segment == NULL) {
+		return;
+	}
+	munmap(target->segment, target->segmentSize);
+	if (ftruncate(target->segmentFd, (off_t) target->segmentUsed) != 0) {
+		__atomic_store_n(&target->writeFailed, true, __ATOMIC_RELAXED);
+	}
+	close(target->segmentFd);
+	target->segment = NULL;
+}
+
+// Closes the current segment, shifts the names of the kept segments and opens a new segment
+static bool segmentRotate(SPLogger target) {
+	// Function variables
+	int i; // Generic loop variable
+	// Function code
+	segmentClose(target);
+	for (i = target->segmentsNum - 1; i >= 1; i--) { // <filename>.<i-1> becomes <filename>.<i>
+		if (i == 1) {
+			strcpy(target->segmentFrom, target->segmentName);
+		} else {
+			sprintf(target->segmentFrom, "%s.%d", target->segmentName, i - 1);
+		}
+		sprintf(target->segmentTo, "%s.%d", target->segmentName, i);
+		rename(target->segmentFrom, target->segmentTo); // Fails if there is no such segment yet
+	}
+	return segmentOpen(target);
+}
+
+// Copies bytes to the current segment, rolling over when it is full
+static bool segmentCopy(SPLogger target, const char* bytes, size_t length) {
+	// Function variables
+	size_t chunk;
+	// Function code
+	while (length > 0) {
+		if (target->segment == NULL) { // A previous open failed, the kept segments are not shifted again
+			if (!segmentOpen(target)) {
+				return false;
+			}
+		} else if (target->segmentUsed == target->segmentSize) {
+			if (!segmentRotate(target)) {
+				return false;
+			}
+		}
+		chunk = target->segmentSize - target->segmentUsed;
+		if (chunk > length) {
+			chunk = length;
+		}
+		memcpy(target->segment + target->segmentUsed, bytes, chunk);
+		target->segmentUsed += chunk;
+		bytes += chunk;
+		length -= chunk;
+	}
+	return true;
+}
+
+// Writes whole messages and an optional new line to the log, returns false if the write failed
+static bool loggerSinkWrite(SPLogger target, const char* bytes, size_t length, bool newline) {
+	if (target->outputChannel != NULL) {
+		return fwrite(bytes, 1, length, target->outputChannel) == length
+				&& (!newline || putc('\n', target->outputChannel) != EOF);
+	}
+	// Start a new segment rather than splitting messages, unless they are longer than a segment
+	if (target->segment != NULL && target->segmentUsed > 0
+			&& target->segmentUsed + length + newline > target->segmentSize) {
+		if (!segmentRotate(target)) {
+			return false;
+		}
+	}
+	return segmentCopy(target, bytes, length) && (!newline || segmentCopy(target, "\n", 1));
+}
+
+// Passes the written messages to the operating system, returns false if it failed
+static bool loggerSinkFlush(SPLogger target) {
+	if (target->outputChannel != NULL) {
+		return fflush(target->outputChannel) == 0;
+	}
+	return target->segment == NULL
+			|| msync(target->segment, target->segmentSize, MS_ASYNC) == 0;
+}
+
+// The writer thread, writes the ready records in batches with one flush per batch
+static void* loggerWriter(void* arg) {
+	// Function variables
+	SPLogger source = (SPLogger) arg;
+	struct timespec deadline;
+	size_t record, count;
+	bool stop;
+	// Function code
+	for (;;) {
+		stop = __atomic_load_n(&source->stop, __ATOMIC_ACQUIRE);
+		for (count = 0; count < source->capacity && recordReady(source, source->head); count++) {
+			record = source->head & (source->capacity - 1);
+			if (!loggerSinkWrite(source, source->records + record * source->recordSize,
+					source->lengths[record], false)) {
+				__atomic_store_n(&source->writeFailed, true, __ATOMIC_RELAXED);
+			}
+			__atomic_store_n(&source->sequences[record], source->head + source->capacity, __ATOMIC_RELEASE);
+			source->head++;
+		}
+		if (count > 0) {
+			if (!loggerSinkFlush(source)) {
+				__atomic_store_n(&source->writeFailed, true, __ATOMIC_RELAXED);
+			}
+			__atomic_store_n(&source->written, source->head, __ATOMIC_RELEASE);
+			continue;
+		}
+		if (stop) { // Stop was set before the queue was found empty
+			return NULL;
+		}
+		pthread_mutex_lock(&source->mutex);
+		__atomic_store_n(&source->writerSleeping, true, __ATOMIC_SEQ_CST);
+		if (!recordReady(source, source->head) && !__atomic_load_n(&source->stop, __ATOMIC_SEQ_CST)) {
+			clock_gettime(CLOCK_REALTIME, &deadline);
+			deadline.tv_nsec += SP_LOGGER_WRITER_WAIT_NS;
+			if (deadline.tv_nsec >= 1000000000L) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1000000000L;
+			}
+			pthread_cond_timedwait(&source->wakeup, &source->mutex, &deadline);
+		}
+		__atomic_store_n(&source->writerSleeping, false, __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(&source->mutex);
+	}
+}
+
+// Copies a message and an optional new line to a free record, or drops it if the queue is full
+static void loggerEnqueue(SPLogger source, const char* msg, size_t length, bool newline) {
+	// Function variables
+	size_t ticket = __atomic_load_n(&source->tail, __ATOMIC_RELAXED);
+	size_t record, sequence;
+	// Function code
+	for (;;) {
+		record = ticket & (source->capacity - 1);
+		sequence = __atomic_load_n(&source->sequences[record], __ATOMIC_ACQUIRE);
+		if (sequence == ticket) { // The record is free, try to take the ticket
+			if (__atomic_compare_exchange_n(&source->tail, &ticket, ticket + 1, true,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				break;
+			}
+		} else if ((long long) (sequence - ticket) < 0) { // The queue is full
+			if (source->overflowPolicy == SP_LOGGER_OVERFLOW_DROP) {
+				__atomic_fetch_add(&source->dropped, 1, __ATOMIC_RELAXED);
+				return;
+			}
+			wakeWriter(source);
+			sleepNanoseconds(SP_LOGGER_PRODUCER_WAIT_NS);
+			ticket = __atomic_load_n(&source->tail, __ATOMIC_RELAXED);
+		} else { // Another print call took the ticket
+			ticket = __atomic_load_n(&source->tail, __ATOMIC_RELAXED);
+		}
+	}
+	if (length > source->recordSize - newline) { // Keep room for the new line
+		length = source->recordSize - newline;
+	}
+	memcpy(source->records + record * source->recordSize, msg, length);
+	if (newline) {
+		source->records[record * source->recordSize + length++] = '\n';
+	}
+	source->lengths[record] = length;
+	__atomic_store_n(&source->sequences[record], ticket + 1, __ATOMIC_RELEASE);
+	if (ticket + 1 - __atomic_load_n(&source->written, __ATOMIC_RELAXED) >= source->capacity / 2) {
+		wakeWriter(source); // Otherwise the writer thread wakes up on its own within SP_LOGGER_WRITER_WAIT_NS
+	}
+}
+
+// Allocates the queue and starts the writer thread of an asynchronous logger
+static SP_LOGGER_MSG loggerStartWriter(SPLogger source, const SPLoggerOptions* options) {
+	// Function variables
+	size_t i; // Generic loop variable
+	// Function code
+	source->capacity = 1;
+	while (source->capacity < (size_t) (options->queueCapacity > 0
+			? options->queueCapacity : SP_LOGGER_DEFAULT_QUEUE_CAPACITY)) {
+		source->capacity *= 2;
+	}
+	source->recordSize = options->recordSize > 0 ? (size_t) options->recordSize + 1
+			: SP_LOGGER_DEFAULT_RECORD_SIZE + 1;
+	source->records = (char*) malloc(source->capacity * source->recordSize);
+	source->lengths = (size_t*) malloc(source->capacity * sizeof(size_t));
+	source->sequences = (size_t*) malloc(source->capacity * sizeof(size_t));
+	if (source->records == NULL || source->lengths == NULL || source->sequences == NULL) {
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	for (i = 0; i < source->capacity; i++) {
+		source->sequences[i] = i;
+	}
+	source->overflowPolicy = options->overflowPolicy;
+	source->tail = 0;
+	source->head = 0;
+	source->written = 0;
+	source->dropped = 0;
+	source->writeFailed = false;
+	source->stop = false;
+	source->writerSleeping = false;
+	if (pthread_mutex_init(&source->mutex, NULL) != 0) {
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	if (pthread_cond_init(&source->wakeup, NULL) != 0) {
+		pthread_mutex_destroy(&source->mutex);
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	if (pthread_create(&source->writer, NULL, loggerWriter, source) != 0) {
+		pthread_cond_destroy(&source->wakeup);
+		pthread_mutex_destroy(&source->mutex);
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	return SP_LOGGER_SUCCESS;
+}
+
 // Creates and initializes the logger
 SP_LOGGER_MSG spLoggerCreate(const char* filename, SP_LOGGER_LEVEL level) {
-	if (logger != NULL) { // Already defined
-		return SP_LOGGER_DEFINED;
+	return spLoggerCreateWithOptions(filename, level, NULL);
+}
+
+// Writes the staged messages of a thread to the log of a synchronous logger, the staging area must be held
+static void loggerDrain(SPLogger target, SPLoggerStaging* staging) {
+	if (staging->length == 0) {
+		return;
+	}
+	pthread_mutex_lock(&target->sinkMutex);
+	if (!loggerSinkWrite(target, staging->buffer, staging->length, false)) {
+		__atomic_store_n(&target->writeFailed, true, __ATOMIC_RELAXED);
+	}
+	if (target->isStdOut) {
+		fflush(stdout);
+	}
+	pthread_mutex_unlock(&target->sinkMutex);
+	staging->length = 0;
+}
+
+// Called when a thread which printed exits, loggerMutex must not be held by the thread
+static void loggerStagingExit(void* arg) {
+	// Function variables
+	SPLoggerStaging* staging = (SPLoggerStaging*) arg;
+	SPLoggerStaging** link;
+	// Function code
+	pthread_mutex_lock(&loggerMutex);
+	pthread_mutex_lock(&staging->mutex);
+	if (logger != NULL) {
+		loggerDrain(logger, staging);
+	}
+	pthread_mutex_unlock(&staging->mutex);
+	for (link = &stagings; *link != NULL; link = &(*link)->next) {
+		if (*link == staging) {
+			*link = staging->next;
+			break;
+		}
+	}
+	staging->registered = false;
+	staging->length = 0;
+	staging->size = 0;
+	free(staging->buffer);
+	staging->buffer = NULL;
+	pthread_mutex_unlock(&loggerMutex);
+}
+
+static void loggerCreateStagingKey() {
+	pthread_key_create(&stagingKey, loggerStagingExit);
+}
+
+// Takes the staging area of the calling thread, registering it on the first call
+static void loggerEnter() {
+	if (!threadStaging.registered) {
+		pthread_once(&stagingKeyOnce, loggerCreateStagingKey);
+		pthread_mutex_lock(&loggerMutex);
+		threadStaging.next = stagings;
+		stagings = &threadStaging;
+		threadStaging.registered = true;
+		pthread_mutex_unlock(&loggerMutex);
+		pthread_setspecific(stagingKey, &threadStaging);
+	}
+	pthread_mutex_lock(&threadStaging.mutex);
+}
+
+static void loggerLeave() {
+	pthread_mutex_unlock(&threadStaging.mutex);
+}
+
+// Takes or releases the staging areas of all threads, loggerMutex must be held
+static void loggerHoldStagings(bool hold) {
+	// Function variables
+	SPLoggerStaging* staging;
+	// Function code
+	for (staging = stagings; staging != NULL; staging = staging->next) {
+		if (hold) {
+			pthread_mutex_lock(&staging->mutex);
+		} else {
+			pthread_mutex_unlock(&staging->mutex);
+		}
+	}
+}
+
+// Stops the writer thread, closes the log and frees a logger which print calls can no longer reach
+static void loggerFree(SPLogger target) {
+	if (target->isAsync) { // Write the queued records and stop the writer thread
+		__atomic_store_n(&target->stop, true, __ATOMIC_SEQ_CST);
+		pthread_mutex_lock(&target->mutex);
+		pthread_cond_signal(&target->wakeup);
+		pthread_mutex_unlock(&target->mutex);
+		pthread_join(target->writer, NULL);
+		pthread_cond_destroy(&target->wakeup);
+		pthread_mutex_destroy(&target->mutex);
+	}
+	if (target->outputChannel == NULL) {
+		segmentClose(target);
+	} else if (!target->isStdOut) { // Close file only if not stdout
+		fclose(target->outputChannel);
+	}
+	free(target->segmentName);
+	free(target->segmentFrom);
+	free(target->segmentTo);
+	pthread_mutex_destroy(&target->sinkMutex);
+	free(target->records);
+	free(target->lengths);
+	free(target->sequences);
+	free(target);//free allocation
+}
+
+// Allocates and initializes a logger
+static SP_LOGGER_MSG loggerNew(const char* filename, SP_LOGGER_LEVEL level,
+		const SPLoggerOptions* options, SPLogger* result) {
+	// Function variables
+	SPLogger created;
+	SP_LOGGER_MSG status;
+	// Function code
+	if (options != NULL && (options->queueCapacity < 0 || options->recordSize < 0
+			|| options->stagingSize < 0 || options->segmentSize < 0 || options->segmentsNum < 0
+			|| (options->segmentSize > 0 && (filename == NULL || options->binary)))) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	created = (SPLogger) malloc(sizeof(*created));
+	if (created == NULL) { // Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
 	}
-	logger = (SPLogger) malloc(sizeof(*logger));
-	if (logger == NULL) { // Allocation failure
+	created->level = level; // Set the level of the logger
+	created->isAsync = false;
+	created->isBinary = options != NULL && options->binary;
+	created->stagingSize = options != NULL && !options->async ? (size_t) options->stagingSize : 0;
+	created->generation = ++loggerGeneration;
+	created->sitesNum = 0;
+	created->writeFailed = false;
+	created->records = NULL;
+	created->lengths = NULL;
+	created->sequences = NULL;
+	created->segment = NULL;
+	created->segmentName = NULL;
+	created->segmentFrom = NULL;
+	created->segmentTo = NULL;
+	if (pthread_mutex_init(&created->sinkMutex, NULL) != 0) {
+		free(created);
 		return SP_LOGGER_OUT_OF_MEMORY;
 	}
-	logger->level = level; // Set the level of the logger
 	if (filename == NULL) { // In case the filename is not set use stdout
-		logger->outputChannel = stdout;
-		logger->isStdOut = true;
+		created->outputChannel = stdout;
+		created->isStdOut = true;
+	} else if (options != NULL && options->segmentSize > 0) { // Map the first segment
+		created->outputChannel = NULL;
+		created->isStdOut = false;
+		created->segmentSize = (size_t) options->segmentSize;
+		created->segmentsNum = options->segmentsNum > 0 ? options->segmentsNum
+				: SP_LOGGER_DEFAULT_SEGMENTS_NUM;
+		created->segmentName = (char*) malloc(strlen(filename) + 1);
+		created->segmentFrom = (char*) malloc(strlen(filename) + 16);
+		created->segmentTo = (char*) malloc(strlen(filename) + 16);
+		if (created->segmentName == NULL || created->segmentFrom == NULL || created->segmentTo == NULL) {
+			loggerFree(created);
+			return SP_LOGGER_OUT_OF_MEMORY;
+		}
+		strcpy(created->segmentName, filename);
+		if (!segmentOpen(created)) {
+			loggerFree(created);
+			return SP_LOGGER_CANNOT_OPEN_FILE;
+		}
 	} else { // Otherwise open the file in write mode
-		logger->outputChannel = fopen(filename, SP_LOGGER_OPEN_MODE);
-		if (logger->outputChannel == NULL) { // Open failed
-			free(logger);
-			logger = NULL;
+		created->outputChannel = fopen(filename, SP_LOGGER_OPEN_MODE);
+		if (created->outputChannel == NULL) { // Open failed
+			pthread_mutex_destroy(&created->sinkMutex);
+			free(created);
 			return SP_LOGGER_CANNOT_OPEN_FILE;
 		}
-		logger->isStdOut = false;
+		created->isStdOut = false;
 	}
+	if (created->isBinary && !loggerSinkWrite(created, recordBuffer,
+			spLoggerBinaryEncodeHeader(recordBuffer), false)) {
+		loggerFree(created);
+		return SP_LOGGER_WRITE_FAIL;
+	}
+	if (options != NULL && options->async) {
+		status = loggerStartWriter(created, options);
+		if (status != SP_LOGGER_SUCCESS) { // Allocation failure
+			loggerFree(created);
+			return status;
+		}
+		created->isAsync = true;
+	}
+	*result = created;
 	return SP_LOGGER_SUCCESS;
 }
 
+// Creates and initializes the logger, which may be asynchronous
+SP_LOGGER_MSG spLoggerCreateWithOptions(const char* filename, SP_LOGGER_LEVEL level,
+		const SPLoggerOptions* options) {
+	// Function variables
+	SPLogger created = NULL;
+	SP_LOGGER_MSG status = SP_LOGGER_DEFINED;
+	// Function code
+	pthread_mutex_lock(&loggerMutex);
+	if (logger == NULL) { // Otherwise already defined
+		status = loggerNew(filename, level, options, &created);
+	}
+	if (status == SP_LOGGER_SUCCESS) {
+		loggerHoldStagings(true);
+		logger = created;
+		__atomic_store_n(&spLoggerEnabledLevel, (int) level, __ATOMIC_RELAXED);
+		loggerHoldStagings(false);
+	}
+	pthread_mutex_unlock(&loggerMutex);
+	return status;
+}
+
 // Closes are frees all resources of the logger
 void spLoggerDestroy() {
-	if (!logger) {
-		return;
-	}
-	if (!logger->isStdOut) { // Close file only if not stdout
-		fclose(logger->outputChannel);
+	// Function variables
+	SPLogger destroyed;
+	SPLoggerStaging* staging;
+	// Function code
+	pthread_mutex_lock(&loggerMutex);
+	destroyed = logger;
+	if (destroyed != NULL) {
+		loggerHoldStagings(true); // Waits for the print calls in progress
+		for (staging = stagings; staging != NULL; staging = staging->next) {
+			loggerDrain(destroyed, staging);
+		}
+		__atomic_store_n(&spLoggerEnabledLevel, -1, __ATOMIC_RELAXED);
+		logger = NULL;
+		loggerHoldStagings(false);
+		loggerFree(destroyed);
 	}
-	free(logger);//free allocation
-	logger = NULL;
+	pthread_mutex_unlock(&loggerMutex);
 }
 
-// Prints error messages at leves {Error, Warning, Info, Debug}
-SP_LOGGER_MSG spLoggerPrintError(const char* msg, const char* file, const char* function, const int line) {
+// Waits until all queued and staged messages are written
+SP_LOGGER_MSG spLoggerFlush() {
 	// Function variables
-	char out[strlen(msg)+strlen(file)+strlen(function)+123];
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
+	SPLoggerStaging* staging;
+	size_t target;
 	// Function code
+	pthread_mutex_lock(&loggerMutex);
 	if (logger == NULL) { // If the logger is undefined
-			return SP_LOGGER_UNDIFINED;
+		status = SP_LOGGER_UNDIFINED;
+	} else if (logger->isAsync) {
+		target = __atomic_load_n(&logger->tail, __ATOMIC_ACQUIRE);
+		while (__atomic_load_n(&logger->written, __ATOMIC_ACQUIRE) < target) {
+			wakeWriter(logger);
+			sleepNanoseconds(SP_LOGGER_PRODUCER_WAIT_NS);
+		}
+	} else {
+		for (staging = stagings; staging != NULL; staging = staging->next) {
+			pthread_mutex_lock(&staging->mutex);
+			loggerDrain(logger, staging);
+			pthread_mutex_unlock(&staging->mutex);
+		}
+		pthread_mutex_lock(&logger->sinkMutex);
+		if (!loggerSinkFlush(logger)) {
+			__atomic_store_n(&logger->writeFailed, true, __ATOMIC_RELAXED);
+		}
+		pthread_mutex_unlock(&logger->sinkMutex);
 	}
-	if ( (msg==NULL)||(file==NULL)||(function==NULL)||(line<0) ) { // If any of msg or file or function are null or line is negative
-		return SP_LOGGER_INVAlID_ARGUMENT;
+	if (status == SP_LOGGER_SUCCESS && __atomic_load_n(&logger->writeFailed, __ATOMIC_RELAXED)) {
+		status = SP_LOGGER_WRITE_FAIL;
 	}
-	sprintf(out,"---ERROR---\n- file: %s\n- function: %s\n- line: %d\n- message: %s",file,function,line,msg);
-	return spLoggerPrintMsg(out);
+	pthread_mutex_unlock(&loggerMutex);
+	return status;
 }
 
-// Prints warnning messages at levels {Warning, Info, Debug}
-SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file, const char* function, const int line) {
+// Returns the number of messages dropped by a full queue
+long long spLoggerGetDroppedCount() {
 	// Function variables
-	char out[strlen(msg)+strlen(file)+strlen(function)+125];
+	long long dropped = 0;
 	// Function code
-	if (logger == NULL) { // If the logger is undefined
-			return SP_LOGGER_UNDIFINED;
+	pthread_mutex_lock(&loggerMutex);
+	if (logger != NULL && logger->isAsync) {
+		dropped = __atomic_load_n(&logger->dropped, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(&loggerMutex);
+	return dropped;
+}
+
+// Writes length bytes and an optional new line to the log, or queues them in asynchronous mode
+static SP_LOGGER_MSG loggerWriteDirect(const char* bytes, size_t length, bool newline) {
+	// Function variables
+	bool failed;
+	// Function code
+	if (logger->isAsync) {
+		loggerEnqueue(logger, bytes, length, newline);
+		if (__atomic_load_n(&logger->writeFailed, __ATOMIC_RELAXED)) {
+			return SP_LOGGER_WRITE_FAIL;
+		}
+		return SP_LOGGER_SUCCESS;
+	}
+	pthread_mutex_lock(&logger->sinkMutex);
+	failed = !loggerSinkWrite(logger, bytes, length, newline);
+	if (logger->isStdOut) {
+		fflush(stdout);
+	}
+	pthread_mutex_unlock(&logger->sinkMutex);
+	return failed ? SP_LOGGER_WRITE_FAIL : SP_LOGGER_SUCCESS;
+}
+
+// Writes a message as loggerWriteDirect does, through the staging buffer of the thread if the logger has one
+static SP_LOGGER_MSG loggerWriteBytes(const char* bytes, size_t length, bool newline) {
+	// Function variables
+	SPLoggerStaging* staging = &threadStaging;
+	char* grown;
+	// Function code
+	if (logger->stagingSize == 0) {
+		return loggerWriteDirect(bytes, length, newline);
+	}
+	if (staging->length + length + newline > logger->stagingSize) {
+		loggerDrain(logger, staging);
+	}
+	if (staging->size < logger->stagingSize) {
+		grown = (char*) realloc(staging->buffer, logger->stagingSize);
+		if (grown != NULL) {
+			staging->buffer = grown;
+			staging->size = logger->stagingSize;
+		}
+	}
+	if (length + newline > staging->size) { // Too long to stage, or no buffer
+		return loggerWriteDirect(bytes, length, newline);
+	}
+	memcpy(staging->buffer + staging->length, bytes, length);
+	staging->length += length;
+	if (newline) {
+		staging->buffer[staging->length++] = '\n';
 	}
-	if ( (msg==NULL)||(file==NULL)||(function==NULL)||(line<0) ) { // If any of msg or file or function are null or line is negative
+	if (__atomic_load_n(&logger->writeFailed, __ATOMIC_RELAXED)) {
+		return SP_LOGGER_WRITE_FAIL;
+	}
+	return SP_LOGGER_SUCCESS;
+}
+
+// The maximal size of a binary record, which must fit in a queued record without truncation
+static size_t loggerRecordLimit() {
+	if (logger->isAsync && logger->recordSize < SP_LOGGER_MAX_MESSAGE_SIZE) {
+		return logger->recordSize;
+	}
+	return SP_LOGGER_MAX_MESSAGE_SIZE;
+}
+
+// Returns the current time in nanoseconds, for binary records
+static long long loggerTimestamp() {
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Writes length bytes of text followed by a new line, as a text record in binary mode
+static SP_LOGGER_MSG loggerWrite(const char* text, size_t length) {
+	if (logger->isBinary) {
+		length = spLoggerBinaryEncodeText(recordBuffer, loggerRecordLimit(), loggerTimestamp(),
+				text, length);
+		return length == 0 ? SP_LOGGER_WRITE_FAIL : loggerWriteBytes(recordBuffer, length, false);
+	}
+	return loggerWriteBytes(text, length, true);
+}
+
+// Returns the id of a call site in the log, writing the definition of the site first if needed, or 0 if its messages cannot be written as binary
+static unsigned int loggerSiteId(SPLoggerSite* site) {
+	// Function variables
+	unsigned long long state = __atomic_load_n(&site->state, __ATOMIC_ACQUIRE);
+	unsigned int id = 0;
+	size_t length;
+	// Function code
+	if ((state >> 32) == logger->generation) {
+		return (unsigned int) state;
+	}
+	pthread_mutex_lock(&siteMutex);
+	state = __atomic_load_n(&site->state, __ATOMIC_RELAXED);
+	if ((state >> 32) != logger->generation) { // First message of the site in this log
+		if (site->parsed == 0) {
+			site->parsed = spLoggerBinarySignature(site->format, site->signature) ? 1 : -1;
+		}
+		if (site->parsed == 1) {
+			length = spLoggerBinaryEncodeSite(recordBuffer, loggerRecordLimit(), logger->sitesNum + 1, site);
+			// Not staged, so the definition is in the log before any message of the site
+			if (length > 0 && loggerWriteDirect(recordBuffer, length, false) == SP_LOGGER_SUCCESS) {
+				id = ++logger->sitesNum;
+			}
+		}
+		state = ((unsigned long long) logger->generation << 32) | id;
+		__atomic_store_n(&site->state, state, __ATOMIC_RELEASE);
+	}
+	pthread_mutex_unlock(&siteMutex);
+	return (unsigned int) state;
+}
+
+// Formats a message of the given level into the buffer of the calling thread and writes it
+static SP_LOGGER_MSG loggerPrintRecord(SP_LOGGER_LEVEL level, const char* file,
+		const char* function, const int line, const char* format, va_list args) {
+	// Function variables
+	char* out = threadBuffer;
+	int length;
+	int formatted;
+	// Function code
+	length = spLoggerBinaryFormatHeader(out, SP_LOGGER_MAX_MESSAGE_SIZE, level, file, function, line);
+	if (length < 0) {
 		return SP_LOGGER_INVAlID_ARGUMENT;
 	}
-	if (logger->level != SP_LOGGER_ERROR_LEVEL) {
-		sprintf(out,"---WARNING---\n- file: %s\n- function: %s\n- line: %d\n- message: %s",file,function,line,msg);
-		return spLoggerPrintMsg(out);
+	if (length < SP_LOGGER_MAX_MESSAGE_SIZE) {
+		formatted = vsnprintf(out + length, SP_LOGGER_MAX_MESSAGE_SIZE - length, format, args);
+		if (formatted < 0) {
+			return SP_LOGGER_INVAlID_ARGUMENT;
+		}
+		length += formatted;
+	}
+	if (length >= SP_LOGGER_MAX_MESSAGE_SIZE) { // Truncated
+		length = SP_LOGGER_MAX_MESSAGE_SIZE - 1;
+	}
+	return loggerWrite(out, (size_t) length);
+}
+
+// Calls loggerPrintRecord with a variable argument list
+static SP_LOGGER_MSG loggerPrint(SP_LOGGER_LEVEL level, const char* file,
+		const char* function, const int line, const char* format, ...) {
+	// Function variables
+	SP_LOGGER_MSG status;
+	va_list args;
+	// Function code
+	va_start(args, format);
+	status = loggerPrintRecord(level, file, function, line, format, args);
+	va_end(args);
+	return status;
+}
+
+// Returns true if a defined logger does not print messages of the given level, without taking a lock
+static bool loggerFiltered(SP_LOGGER_LEVEL level) {
+	int enabled = __atomic_load_n(&spLoggerEnabledLevel, __ATOMIC_RELAXED);
+	return enabled >= 0 && enabled < (int) level;
+}
+
+// Prints error messages at leves {Error, Warning, Info, Debug}
+SP_LOGGER_MSG spLoggerPrintError(const char* msg, const char* file, const char* function, const int line) {
+	// Function variables
+	SP_LOGGER_MSG status;
+	// Function code
+	loggerEnter();
+	if (logger == NULL) { // If the logger is undefined
+		status = SP_LOGGER_UNDIFINED;
+	} else if ( (msg==NULL)||(file==NULL)||(function==NULL)||(line<0) ) { // If any of msg or file or function are null or line is negative
+		status = SP_LOGGER_INVAlID_ARGUMENT;
 	} else {
+		status = loggerPrint(SP_LOGGER_ERROR_LEVEL, file, function, line, "%s", msg);
+	}
+	loggerLeave();
+	return status;
+}
+
+// Prints warnning messages at levels {Warning, Info, Debug}
+SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file, const char* function, const int line) {
+	// Function variables
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
+	// Function code
+	if (msg != NULL && file != NULL && function != NULL && line >= 0
+			&& loggerFiltered(SP_LOGGER_WARNING_ERROR_LEVEL)) {
 		return SP_LOGGER_SUCCESS;
 	}
+	loggerEnter();
+	if (logger == NULL) { // If the logger is undefined
+		status = SP_LOGGER_UNDIFINED;
+	} else if ( (msg==NULL)||(file==NULL)||(function==NULL)||(line<0) ) { // If any of msg or file or function are null or line is negative
+		status = SP_LOGGER_INVAlID_ARGUMENT;
+	} else if (logger->level != SP_LOGGER_ERROR_LEVEL) {
+		status = loggerPrint(SP_LOGGER_WARNING_ERROR_LEVEL, file, function, line, "%s", msg);
+	}
+	loggerLeave();
+	return status;
 }
 
 // Prints info messages at levels {Info, Debug}
 SP_LOGGER_MSG spLoggerPrintInfo(const char* msg) {
 	// Function variables
-	char out[strlen(msg)+24];
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
 	// Function code
+	if (msg != NULL && loggerFiltered(SP_LOGGER_INFO_WARNING_ERROR_LEVEL)) {
+		return SP_LOGGER_SUCCESS;
+	}
+	loggerEnter();
 	if (logger == NULL) { // If the logger is undefined
-			return SP_LOGGER_UNDIFINED;
+		status = SP_LOGGER_UNDIFINED;
+	} else if (msg==NULL) { // If msg is null
+		status = SP_LOGGER_INVAlID_ARGUMENT;
+	} else if ( (logger->level == SP_LOGGER_INFO_WARNING_ERROR_LEVEL)||(logger->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) ) {
+		status = loggerPrint(SP_LOGGER_INFO_WARNING_ERROR_LEVEL, NULL, NULL, 0, "%s", msg);
 	}
-	if (msg==NULL) { // If msg is null
-		return SP_LOGGER_INVAlID_ARGUMENT;
+	loggerLeave();
+	return status;
+}
+
+// Prints debug messages at level {Debug}
+SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file, const char* function, const int line) {
+	// Function variables
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
+	// Function code
+	if (msg != NULL && file != NULL && function != NULL && line >= 0
+			&& loggerFiltered(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL)) {
+		return SP_LOGGER_SUCCESS;
 	}
-	if ( (logger->level == SP_LOGGER_INFO_WARNING_ERROR_LEVEL)||(logger->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) ) {
-		sprintf(out,"---INFO---\n- message: %s",msg);
-		return spLoggerPrintMsg(out);
-	} else {
+	loggerEnter();
+	if (logger == NULL) { // If the logger is undefined
+		status = SP_LOGGER_UNDIFINED;
+	} else if ( (msg==NULL)||(file==NULL)||(function==NULL)||(line<0) ) { // If any of msg or file or function are null or line is negative
+		status = SP_LOGGER_INVAlID_ARGUMENT;
+	} else if (logger->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) {
+		status = loggerPrint(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, file, function, line, "%s", msg);
+	}
+	loggerLeave();
+	return status;
+}
+
+// Checks the arguments of spLoggerLogf
+static bool loggerValidMessage(SP_LOGGER_LEVEL level, const char* file, const char* function,
+		const int line, const char* format) {
+	return format != NULL && level >= SP_LOGGER_ERROR_LEVEL
+			&& level <= SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL
+			&& (level == SP_LOGGER_INFO_WARNING_ERROR_LEVEL
+					|| (file != NULL && function != NULL && line >= 0));
+}
+
+// Prints a printf style message of the given level
+SP_LOGGER_MSG spLoggerLogf(SP_LOGGER_LEVEL level, const char* file, const char* function,
+		const int line, const char* format, ...) {
+	// Function variables
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
+	va_list args;
+	// Function code
+	if (loggerValidMessage(level, file, function, line, format) && loggerFiltered(level)) {
 		return SP_LOGGER_SUCCESS;
 	}
+	loggerEnter();
+	if (logger == NULL) { // If the logger is undefined
+		status = SP_LOGGER_UNDIFINED;
+	} else if (!loggerValidMessage(level, file, function, line, format)) {
+		status = SP_LOGGER_INVAlID_ARGUMENT;
+	} else if (level <= logger->level) { // Otherwise not printed at the level of the logger
+		va_start(args, format);
+		status = loggerPrintRecord(level, file, function, line, format, args);
+		va_end(args);
+	}
+	loggerLeave();
+	return status;
 }
 
-// Prints debug messages at level {Debug}
-SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file, const char* function, const int line) {
+// Prints a message of a call site, as a binary record in binary mode
+SP_LOGGER_MSG spLoggerLogSite(SPLoggerSite* site, const char* format, ...) {
 	// Function variables
-	char out[strlen(msg)+strlen(file)+strlen(function)+123];
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
+	unsigned int id;
+	size_t length = 0;
+	va_list args;
+	va_list encoded;
 	// Function code
+	loggerEnter();
 	if (logger == NULL) { // If the logger is undefined
-			return SP_LOGGER_UNDIFINED;
+		status = SP_LOGGER_UNDIFINED;
+	} else if (site == NULL || site->format == NULL || site->file == NULL || site->function == NULL
+			|| !loggerValidMessage(site->level, site->file, site->function, site->line, format)) {
+		status = SP_LOGGER_INVAlID_ARGUMENT;
+	} else if (site->level <= logger->level) { // Otherwise not printed at the level of the logger
+		va_start(args, format);
+		if (logger->isBinary && (id = loggerSiteId(site)) != 0) {
+			va_copy(encoded, args);
+			length = spLoggerBinaryEncodeEvent(threadBuffer, loggerRecordLimit(), id, loggerTimestamp(),
+					site->signature, encoded);
+			va_end(encoded);
+		}
+		if (length > 0) {
+			status = loggerWriteBytes(threadBuffer, length, false);
+		} else { // Formatted now, as a text record in binary mode
+			status = loggerPrintRecord(site->level, site->file, site->function, site->line, format, args);
+		}
+		va_end(args);
 	}
-	if ( (msg==NULL)||(file==NULL)||(function==NULL)||(line<0) ) { // If any of msg or file or function are null or line is negative
-		return SP_LOGGER_INVAlID_ARGUMENT;
+	loggerLeave();
+	return status;
+}
+
+// Returns the time of a monotonic clock in nanoseconds, for limited call sites
+static long long loggerMonotonic() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Counts the calls skipped since the last check, and reports the suppressed calls if it is time to
+static void loggerReportSuppressed(SPLoggerSite* site, SPLoggerLimit* limit, long long now) {
+	limit->suppressed += limit->skipped;
+	limit->skipped = 0;
+	if (limit->suppressed > 0 && now - limit->reported >= SP_LOGGER_REPORT_INTERVAL_NS) {
+		spLoggerLogf(site->level, site->file, site->function, site->line,
+				"%llu messages of this call site were suppressed", limit->suppressed);
+		limit->suppressed = 0;
+		limit->reported = now;
 	}
-	if (logger->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) {
-		sprintf(out,"---DEBUG---\n- file: %s\n- function: %s\n- line: %d\n- message: %s",file,function,line,msg);
-		return spLoggerPrintMsg(out);
-	} else {
-		return SP_LOGGER_SUCCESS;
+}
+
+// Decides if a call of a site sampled 1 in n prints
+bool spLoggerSample(SPLoggerSite* site, SPLoggerLimit* limit, int n) {
+	if (site == NULL || limit == NULL) {
+		return false;
+	}
+	loggerReportSuppressed(site, limit, loggerMonotonic());
+	limit->skip = limit->skipped = n > 1 ? (unsigned int) n - 1 : 0;
+	return true;
+}
+
+// Decides if a call of a rate limited site prints, by the token bucket of the site in the calling thread
+bool spLoggerRateLimit(SPLoggerSite* site, SPLoggerLimit* limit, double perSecond, int burst) {
+	// Function variables
+	long long now, elapsed;
+	double calls; // The calls since the last check, including this one
+	double skip;
+	// Function code
+	if (site == NULL || limit == NULL) {
+		return false;
+	}
+	now = loggerMonotonic();
+	elapsed = now - limit->checked;
+	calls = (double) limit->skipped + 1.0;
+	if (burst < 1) {
+		burst = 1;
+	}
+	if (limit->checked == 0) { // First call of the site in this thread
+		limit->tokens = burst;
+	} else if (perSecond > 0.0) {
+		limit->tokens += elapsed * perSecond / 1e9;
+		if (limit->tokens > burst) {
+			limit->tokens = burst;
+		}
+	}
+	limit->checked = now;
+	if (perSecond > 0.0 && limit->tokens >= 1.0) {
+		limit->tokens -= 1.0;
+		loggerReportSuppressed(site, limit, now);
+		return true;
 	}
+	limit->suppressed++;
+	loggerReportSuppressed(site, limit, now); // A site which stays suppressed still reports
+	// Suppress the calls expected before the next token, at the rate of the calls since the last
+	// check, checking again on the next call if the rate is not known
+	skip = perSecond > 0.0 && elapsed > 0 ? (1.0 - limit->tokens) * 1e9 / perSecond / (elapsed / calls)
+			: 0.0;
+	limit->skip = limit->skipped = skip < SP_LOGGER_MAX_SKIP ? (unsigned int) skip : SP_LOGGER_MAX_SKIP;
+	return false;
 }
 
 // Prints the exact message at any level (Without formatting)
 SP_LOGGER_MSG spLoggerPrintMsg(const char* msg) {
 	// Function variables
-	char* out = (char *)msg;
-	size_t stat;
+	SP_LOGGER_MSG status;
 	// Function code
+	loggerEnter();
 	if (logger == NULL) { // If the logger is undefined
-			return SP_LOGGER_UNDIFINED;
-	}
-	if (out==NULL) { // If msg is null
-		return SP_LOGGER_INVAlID_ARGUMENT;
-	}
-	if (logger->isStdOut) {
-		printf("%s\n",out);
-		fflush(stdout);
+		status = SP_LOGGER_UNDIFINED;
+	} else if (msg==NULL) { // If msg is null
+		status = SP_LOGGER_INVAlID_ARGUMENT;
 	} else {
-	    strcat(out, "\n");
-	    stat = fwrite(out,1, strlen(out),logger->outputChannel);
-	    if (stat == 0) {
-	    	return SP_LOGGER_WRITE_FAIL;
-	    }
+		status = loggerWrite(msg, strlen(msg));
 	}
-	return SP_LOGGER_SUCCESS;
+	loggerLeave();
+	return status;
 }
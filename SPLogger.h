@@ -1,5 +1,6 @@
 #ifndef SPLOGGER_H_
 #define SPLOGGER_H_
+#include <stdbool.h>
 /**
  * SP Logger summary:
  * SP Logger is defined at compilation time and it must be initialized
@@ -13,6 +14,33 @@
  * 	
  * The logger supports another printing function which can be called at any level
  * The user must destroy the logger at end of usage
+ *
+ * By default every print call writes its message to the log before returning.
+ * A logger created by spLoggerCreateWithOptions can be asynchronous instead:
+ * print calls copy their message to a bounded lock-free queue of records, and
+ * a writer thread owned by the logger writes the queued records in batches,
+ * flushing the log once per batch. When the queue is full, a print call either
+ * waits for the writer thread or drops its message, as chosen by the options.
+ * Destroying an asynchronous logger writes all the queued records first.
+ *
+ * All the functions may be called by many threads at once. Each thread prints
+ * under a lock of its own, which only create, destroy and flush also take, so
+ * print calls of different threads do not wait for each other, and every
+ * message is written as a whole. A synchronous logger may also give each thread
+ * a staging buffer (see SPLoggerOptions): a thread collects its messages in its
+ * buffer and writes them at once when the buffer is full, when the thread
+ * exits, or when the logger is flushed or destroyed.
+ *
+ * A log file can also be written as a bounded set of segments (see
+ * SPLoggerOptions). The current segment is the file given by filename, which is
+ * preallocated to segmentSize bytes and mapped to memory, so writing a message
+ * copies it to memory without a system call. When a message does not fit, the
+ * segment is cut to its written length and renamed to "<filename>.1", older
+ * segments are renamed from "<filename>.<i>" to "<filename>.<i+1>", the segment
+ * beyond segmentsNum is removed, and a new segment is started. Messages are not
+ * split between segments unless they are longer than a segment (so stagingSize
+ * should be smaller than segmentSize). Until the logger is destroyed, the
+ * current segment ends with zero bytes up to segmentSize.
  *	
  * The following functions are supported:
  * spLoggerCreate 		- Creates and initializes the logger
@@ -22,7 +50,43 @@
  * spLoggerPrintInfo    - Prints info messages at levels {Info, Debug}
  * spLoggerPrintDebug   - Prints debug messages at level {Debug}
  * spLoggerPrintMsg     - Prints the exact message at any level (Without formatting)
+ * spLoggerCreateWithOptions - Creates a logger, which may be asynchronous
+ * spLoggerFlush        - Waits until all queued and staged messages are written
+ * spLoggerGetDroppedCount - Returns the number of messages dropped by a full queue
+ * spLoggerLogf         - Prints a printf style message of a given level
+ * SP_LOG_ERROR, SP_LOG_WARNING, SP_LOG_INFO, SP_LOG_DEBUG
+ *                      - Macros which print a printf style message with the
+ *                        file, function and line of the call site
+ * spLoggerLogSite      - Prints a message of a call site, used by the macros
+ * SP_LOG_EVERY_N, SP_LOG_RATE_LIMITED
+ *                      - Macros which print 1 in N messages of a call site, or
+ *                        at most a given rate of them, for calls in hot loops
+ * spLoggerSample, spLoggerRateLimit
+ *                      - Decide if a limited call site prints, used by the macros
+ *
+ * A logger created with the binary option writes the messages of the SP_LOG_*
+ * macros as compact binary records which hold the arguments unformatted, and
+ * the splog-decode tool formats them later (see SPLoggerBinary.h). Messages of
+ * the other print functions are formatted when printed, as text records.
+ *
+ * Messages with a header (all but spLoggerPrintMsg) are formatted into a buffer
+ * of SP_LOGGER_MAX_MESSAGE_SIZE bytes owned by the calling thread, so printing
+ * does not allocate memory. Longer messages are truncated.
+ */
+
+/** The maximal length of a formatted message, including its header **/
+#define SP_LOGGER_MAX_MESSAGE_SIZE 4096
+
+/**
+ * The least severe level (as the value of SP_LOGGER_LEVEL: 0 for error up to 3
+ * for debug) whose SP_LOG_* calls are compiled. Calls of less severe levels are
+ * constant false conditions, which the compiler removes together with their
+ * arguments. Define it before including this header, or with -D, to remove
+ * for example the debug calls of a release build.
  */
+#ifndef SP_LOGGER_MIN_LEVEL
+#define SP_LOGGER_MIN_LEVEL 3
+#endif
 
 /** A type used to decide the level of the logger**/
 typedef enum sp_logger_level_t {
@@ -46,6 +110,49 @@ typedef enum sp_logger_msg_t {
 /** A type used for defining the logger**/
 typedef struct sp_logger_t* SPLogger;
 
+/** A type used to decide what an asynchronous print call does when the queue is full **/
+typedef enum sp_logger_overflow_policy_t {
+	SP_LOGGER_OVERFLOW_BLOCK, // Wait until the writer thread frees a record
+	SP_LOGGER_OVERFLOW_DROP // Drop the message and count it
+} SP_LOGGER_OVERFLOW_POLICY;
+
+/**
+ * A type used to configure the logger in spLoggerCreateWithOptions. Fields which
+ * are 0 take their default value, so a zero initialized struct gives a
+ * synchronous logger.
+ */
+typedef struct sp_logger_options_t {
+	bool async; // Write the messages from a writer thread
+	int queueCapacity; // The number of queued records, rounded up to a power of 2 (default 1024)
+	int recordSize; // The maximal length of a queued message in bytes, longer messages are truncated (default 1024)
+	SP_LOGGER_OVERFLOW_POLICY overflowPolicy; // What to do when the queue is full (default block)
+	bool binary; // Write binary records, to be formatted by splog-decode (default text)
+	int stagingSize; // The size in bytes of the staging buffer of each thread, ignored by asynchronous loggers (default 0, no staging)
+	int segmentSize; // Write the log to memory mapped segment files of this size in bytes (default 0, one file written with stdio)
+	int segmentsNum; // The number of segment files kept, including the current one (default 4)
+} SPLoggerOptions;
+
+/** The maximal number of arguments of a message written as a binary record **/
+#define SP_LOGGER_MAX_ARGUMENTS 16
+
+/** The size of the argument codes of a format, with a static precision of up to 4 digits per string **/
+#define SP_LOGGER_MAX_SIGNATURE_SIZE (SP_LOGGER_MAX_ARGUMENTS * 6 + 1)
+
+/**
+ * A type describing the call site of an SP_LOG_* macro, which defines one as a
+ * static variable. The fields after format are managed by the logger.
+ */
+typedef struct sp_logger_site_t {
+	SP_LOGGER_LEVEL level; // The level of the messages
+	const char* file;
+	const char* function;
+	int line;
+	const char* format; // The printf style format of the messages
+	unsigned long long state; // The generation of the logger and the id of the site in its log
+	int parsed; // 1 if the format can be written as binary, -1 if it cannot, 0 if not checked yet
+	char signature[SP_LOGGER_MAX_SIGNATURE_SIZE]; // The argument codes of the format
+} SPLoggerSite;
+
 /**
  * Creates a logger. This function should be called once, prior
  * to the usage of any SP Logger print functions. It is the responsibility
@@ -63,12 +170,58 @@ typedef struct sp_logger_t* SPLogger;
  */
 SP_LOGGER_MSG spLoggerCreate(const char* filename, SP_LOGGER_LEVEL level);
 
+/**
+ * Creates a logger as spLoggerCreate does, configured by the given options.
+ *
+ * @param filename - The name of the log file, if not specified stdout is used
+ * 					 as default.
+ * @param level - The level of the logger prints
+ * @param options - The configuration of the logger, NULL for the defaults
+ * @return
+ * SP_LOGGER_DEFINED 			- The logger has been defined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If any of the sizes in options is negative, or segmentSize
+ * 								  is set for stdout or for a binary logger
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure, or if
+ * 								  the writer thread cannot be started
+ * SP_LOGGER_CANNOT_OPEN_FILE 	- If the file given by filename cannot be opened
+ * SP_LOGGER_WRITE_FAIL			- If the header of a binary log cannot be written
+ * SP_LOGGER_SUCCESS 			- In case the logger has been successfully opened
+ */
+SP_LOGGER_MSG spLoggerCreateWithOptions(const char* filename, SP_LOGGER_LEVEL level,
+		const SPLoggerOptions* options);
+
 /**
  * Frees all memory allocated for the logger. If the logger is not defined
- * then nothing happens.
+ * then nothing happens. An asynchronous logger writes all of its queued
+ * messages and stops its writer thread first, so no message printed before
+ * the call is lost. Print calls may run concurrently with this function: the
+ * print calls in progress complete first, and later calls return
+ * SP_LOGGER_UNDIFINED.
  */
 void spLoggerDestroy();
 
+/**
+ * Waits until all the messages printed before the call have been written to
+ * the log and flushed. For a synchronous logger, writes the staged messages of
+ * all threads and flushes the log.
+ *
+ * @return
+ * SP_LOGGER_UNDIFINED 			- If the logger is undefined
+ * SP_LOGGER_WRITE_FAIL			- If a write failure occurred
+ * SP_LOGGER_SUCCESS			- otherwise
+ */
+SP_LOGGER_MSG spLoggerFlush();
+
+/**
+ * Returns the number of messages which an asynchronous logger with the
+ * SP_LOGGER_OVERFLOW_DROP policy dropped because its queue was full.
+ *
+ * @return
+ * 0 if the logger is undefined or nothing was dropped,
+ * otherwise the number of dropped messages.
+ */
+long long spLoggerGetDroppedCount();
+
 /**
  * 	Prints error message. The error message format is given below:
  * 	---ERROR---
@@ -204,6 +357,9 @@ SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file,
 /**
  * The given message is printed. A new line is printed at the end of msg
  * The message will be printed in all levels.
+ * An asynchronous logger queues the message and returns SP_LOGGER_SUCCESS,
+ * also when the message is dropped, or SP_LOGGER_WRITE_FAIL if an earlier
+ * write of the writer thread failed.
  *
  * @param msg - The message to be printed
  * @return
@@ -214,4 +370,183 @@ SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file,
  */
 SP_LOGGER_MSG spLoggerPrintMsg(const char* msg);
 
+/**
+ * Prints a message built from a printf style format, with the header of the
+ * given level: SP_LOGGER_ERROR_LEVEL prints as spLoggerPrintError does,
+ * SP_LOGGER_WARNING_ERROR_LEVEL as spLoggerPrintWarning,
+ * SP_LOGGER_INFO_WARNING_ERROR_LEVEL as spLoggerPrintInfo (file, function and
+ * line are ignored) and SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL as
+ * spLoggerPrintDebug. The message is printed only if the level of the logger
+ * includes the given level. A message longer than SP_LOGGER_MAX_MESSAGE_SIZE - 1
+ * bytes, including its header, is truncated.
+ *
+ * @param level     - The level of the message
+ * @param file    	- A string representing the filename in which spLoggerLogf call occurred
+ * @param function 	- A string representing the function name in which spLoggerLogf call ocurred
+ * @param line		- The line in which the function call occurred
+ * @param format	- A printf style format, followed by its arguments
+ * @return
+ * SP_LOGGER_UNDIFINED 			- If the logger is undefined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If format is null, level is not a valid level, or
+ * 								  level is not the info level and any of file or
+ * 								  function are null or line is negative
+ * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_SUCCESS			- otherwise
+ */
+SP_LOGGER_MSG spLoggerLogf(SP_LOGGER_LEVEL level, const char* file,
+		const char* function, const int line, const char* format, ...)
+#ifdef __GNUC__
+		__attribute__((format(printf, 5, 6)))
+#endif
+		;
+
+/**
+ * The level of the current logger, or -1 if the logger is undefined. It is set
+ * by spLoggerCreate and spLoggerDestroy, so the SP_LOG_* macros can filter
+ * messages with a single relaxed atomic load and comparison, before any
+ * argument is evaluated. Print calls check the level again under their lock, so a macro which races with
+ * create or destroy at most skips or tries one message. Must not be modified
+ * by users.
+ */
+extern int spLoggerEnabledLevel;
+
+/**
+ * Prints a message of a call site. A text logger prints it as spLoggerLogf
+ * would, with the level, file, function and line of the site. A binary logger
+ * writes the definition of the site the first time the site prints, and then
+ * writes each message as the id of the site, a timestamp and the arguments.
+ *
+ * @param site		- The call site, whose format is the given format
+ * @param format	- The format of the site, followed by its arguments
+ * @return
+ * SP_LOGGER_UNDIFINED 			- If the logger is undefined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If site or format are null, or the fields of
+ * 								  site are not valid as arguments of spLoggerLogf
+ * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_SUCCESS			- otherwise
+ */
+SP_LOGGER_MSG spLoggerLogSite(SPLoggerSite* site, const char* format, ...)
+#ifdef __GNUC__
+		__attribute__((format(printf, 2, 3)))
+#endif
+		;
+
+/** Expands to the first of the arguments of a macro **/
+#define SP_LOGGER_FIRST_ARGUMENT(...) SP_LOGGER_FIRST_ARGUMENT_(__VA_ARGS__, 0)
+#define SP_LOGGER_FIRST_ARGUMENT_(first, ...) first
+
+/**
+ * Prints a printf style message of the given level, with the file, function and
+ * line of the call site, if the level is compiled (see SP_LOGGER_MIN_LEVEL) and
+ * the logger is defined at a level which includes it. The arguments are
+ * evaluated only if the message is printed. The status of the print is ignored.
+ * The format must be a string literal.
+ */
+#define SP_LOG(level, ...) \
+	do { \
+		if ((int) (level) <= SP_LOGGER_MIN_LEVEL && (int) (level) <= __atomic_load_n(&spLoggerEnabledLevel, __ATOMIC_RELAXED)) { \
+			static SPLoggerSite spLoggerSite = {(level), __FILE__, __func__, __LINE__, \
+					SP_LOGGER_FIRST_ARGUMENT(__VA_ARGS__), 0, 0, ""}; \
+			spLoggerLogSite(&spLoggerSite, __VA_ARGS__); \
+		} \
+	} while (0)
+
+/** Prints a message as SP_LOG does, at the given level. The first argument is the format **/
+#define SP_LOG_ERROR(...) SP_LOG(SP_LOGGER_ERROR_LEVEL, __VA_ARGS__)
+#define SP_LOG_WARNING(...) SP_LOG(SP_LOGGER_WARNING_ERROR_LEVEL, __VA_ARGS__)
+#define SP_LOG_INFO(...) SP_LOG(SP_LOGGER_INFO_WARNING_ERROR_LEVEL, __VA_ARGS__)
+#define SP_LOG_DEBUG(...) SP_LOG(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, __VA_ARGS__)
+
+/** The shortest time between two reports of suppressed messages of a call site **/
+#define SP_LOGGER_REPORT_INTERVAL_NS 1000000000LL
+
+/**
+ * The most calls a rate limited call site suppresses without reading the
+ * clock. It is small, so a site whose calls slow down right after it was
+ * suppressed reads the clock again within a few calls.
+ */
+#define SP_LOGGER_MAX_SKIP 64u
+
+/**
+ * The state of a sampled or rate limited call site, which the SP_LOG_EVERY_N
+ * and SP_LOG_RATE_LIMITED macros define as a zero initialized thread local
+ * variable, so every thread samples and limits its own calls. A suppressed
+ * call only decrements skip. The other fields are managed by the logger.
+ */
+typedef struct sp_logger_limit_t {
+	unsigned int skip; // The number of next calls which are suppressed without a check
+	unsigned int skipped; // The value skip had when it was set
+	unsigned long long suppressed; // The number of calls suppressed since the last report
+	double tokens; // The tokens in the bucket of a rate limited site
+	long long checked; // The time of the last check of a rate limited site, in nanoseconds
+	long long reported; // The time of the last report, in nanoseconds
+} SPLoggerLimit;
+
+/**
+ * Decides if a call of a site sampled 1 in n prints, for calls whose skip is 0:
+ * the call prints, and the next n - 1 calls are suppressed. Before the message
+ * is printed, the number of suppressed calls is printed in a message of the
+ * level, file, function and line of the site (as "<count> messages of this
+ * call site were suppressed"), at most once per SP_LOGGER_REPORT_INTERVAL_NS.
+ *
+ * @param site	- The call site
+ * @param limit	- The state of the site in the calling thread
+ * @param n		- The sampling period, a value below 1 is taken as 1
+ * @return
+ * false if site or limit are null, true otherwise
+ */
+bool spLoggerSample(SPLoggerSite* site, SPLoggerLimit* limit, int n);
+
+/**
+ * Decides if a call of a rate limited site prints, for calls whose skip is 0.
+ * Each thread has a token bucket for the site, which holds up to burst tokens
+ * (a value below 1 is taken as 1), starts full and gains perSecond tokens per
+ * second. A call prints if it can take a token. Otherwise, it estimates from
+ * the rate of the recent calls how many calls come before the next token, and
+ * suppresses up to SP_LOGGER_MAX_SKIP of them without reading the clock, so
+ * the site never exceeds the rate, and prints again at most
+ * SP_LOGGER_MAX_SKIP calls after a token is available. Suppressed calls are
+ * reported as spLoggerSample does, both before a printed message and when a
+ * suppressed call reads the clock, so a site which stays suppressed still
+ * reports once per SP_LOGGER_REPORT_INTERVAL_NS while it is called.
+ *
+ * @param site		- The call site
+ * @param limit		- The state of the site in the calling thread
+ * @param perSecond	- The number of messages per second, nothing is printed if
+ * 					  it is not positive
+ * @param burst		- The number of messages which can be printed at once
+ * @return
+ * true if the call prints, false otherwise or if site or limit are null
+ */
+bool spLoggerRateLimit(SPLoggerSite* site, SPLoggerLimit* limit, double perSecond, int burst);
+
+/**
+ * Prints a message as SP_LOG does, if the given check returns true. A call
+ * whose thread local skip count is not 0 is suppressed by decrementing it, and
+ * check is evaluated otherwise. The site and its state are named spLoggerSite
+ * and spLoggerLimit in check.
+ */
+#define SP_LOG_LIMITED(level, check, ...) \
+	do { \
+		if ((int) (level) <= SP_LOGGER_MIN_LEVEL && (int) (level) <= __atomic_load_n(&spLoggerEnabledLevel, __ATOMIC_RELAXED)) { \
+			static SPLoggerSite spLoggerSite = {(level), __FILE__, __func__, __LINE__, \
+					SP_LOGGER_FIRST_ARGUMENT(__VA_ARGS__), 0, 0, ""}; \
+			static __thread SPLoggerLimit spLoggerLimit; \
+			if (spLoggerLimit.skip > 0) { \
+				spLoggerLimit.skip--; \
+			} else if (check) { \
+				spLoggerLogSite(&spLoggerSite, __VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+
+/** Prints the first of every n messages of a call site in each thread (see spLoggerSample) **/
+#define SP_LOG_EVERY_N(level, n, ...) \
+	SP_LOG_LIMITED(level, spLoggerSample(&spLoggerSite, &spLoggerLimit, (n)), __VA_ARGS__)
+
+/** Prints at most perSecond messages of a call site per second in each thread (see spLoggerRateLimit) **/
+#define SP_LOG_RATE_LIMITED(level, perSecond, burst, ...) \
+	SP_LOG_LIMITED(level, spLoggerRateLimit(&spLoggerSite, &spLoggerLimit, (perSecond), (burst)), \
+			__VA_ARGS__)
+
 #endif
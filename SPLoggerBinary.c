@@ -0,0 +1,669 @@
+#include "SPLoggerBinary.h"
+#include <stdint.h> // uint32_t, uint64_t, intmax_t, uintmax_t, uintptr_t
+#include <stdio.h> // sprintf
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // strlen, strchr, memchr, memcpy, memset
+
+/*
+ * Argument codes, one per argument read by a format:
+ * 	'i' int, 'I' unsigned int (4 bytes)
+ * 	'l' long, 'L' unsigned long, 'q' long long, 'Q' unsigned long long,
+ * 	'j' intmax_t, 'J' uintmax_t, 'z' size_t, 't' ptrdiff_t, 'p' void* (8 bytes)
+ * 	'd' double, 'D' long double (8 bytes, as a double)
+ * 	's' string (4 bytes of length, then the bytes)
+ * 	'P' int read as the precision of the next string (4 bytes)
+ * and the static precision of a string, which reads no argument:
+ * 	'.' followed by the decimal precision, before the 's'
+ * A string is read up to its precision, so it does not need a '\0' after it.
+ */
+#define SP_LOGGER_MAX_CONVERSION_WIDTH 100000 // Larger widths and precisions are rejected
+#define SP_LOGGER_MAX_RECORD_SIZE (1u << 24) // Larger records are considered corrupted
+
+/** A call site read by the decoder **/
+typedef struct sp_logger_decode_site_t {
+	SP_LOGGER_LEVEL level;
+	int line;
+	char* strings; // The file, function and format, each ended by '\0'
+	const char* function;
+	const char* format;
+} SPLoggerDecodeSite;
+
+static size_t put32(char* out, size_t at, uint32_t value) {
+	memcpy(out + at, &value, sizeof(value));
+	return at + sizeof(value);
+}
+
+static size_t put64(char* out, size_t at, uint64_t value) {
+	memcpy(out + at, &value, sizeof(value));
+	return at + sizeof(value);
+}
+
+static uint32_t get32(const char* in) {
+	uint32_t value;
+	memcpy(&value, in, sizeof(value));
+	return value;
+}
+
+static uint64_t get64(const char* in) {
+	uint64_t value;
+	memcpy(&value, in, sizeof(value));
+	return value;
+}
+
+// Writes the type and body length of a record
+static size_t putRecordHeader(char* out, char type, size_t length) {
+	out[0] = type;
+	return put32(out, 1, (uint32_t) (length - SP_LOGGER_RECORD_HEADER_SIZE));
+}
+
+// Returns the number of bytes an argument code takes in a record, not counting string bytes
+static size_t codeSize(char code) {
+	if (code == '.' || (code >= '0' && code <= '9')) { // A static precision
+		return 0;
+	}
+	return (code == 'i' || code == 'I' || code == 's' || code == 'P') ? 4 : 8;
+}
+
+// Parses a decimal width or precision
+static const char* parseNumber(const char* p, int* number) {
+	*number = 0;
+	while (*p >= '0' && *p <= '9') {
+		if (*number > SP_LOGGER_MAX_CONVERSION_WIDTH) {
+			return NULL;
+		}
+		*number = *number * 10 + (*p - '0');
+		p++;
+	}
+	return p;
+}
+
+// Returns the argument code of an integer conversion with the given modifier, or 0 if not supported
+static char integerCode(const char* modifier, bool isSigned) {
+	if (modifier[0] == '\0' || strcmp(modifier, "h") == 0 || strcmp(modifier, "hh") == 0) {
+		return isSigned ? 'i' : 'I';
+	} else if (strcmp(modifier, "l") == 0) {
+		return isSigned ? 'l' : 'L';
+	} else if (strcmp(modifier, "ll") == 0) {
+		return isSigned ? 'q' : 'Q';
+	} else if (strcmp(modifier, "j") == 0) {
+		return isSigned ? 'j' : 'J';
+	} else if (strcmp(modifier, "z") == 0) {
+		return 'z';
+	} else if (strcmp(modifier, "t") == 0) {
+		return 't';
+	}
+	return 0;
+}
+
+bool spLoggerBinaryParseConversion(const char* spec, SPLoggerConversion* conversion) {
+	// Function variables
+	const char* p = spec + 1;
+	size_t flags = 0;
+	// Function code
+	memset(conversion, 0, sizeof(*conversion));
+	conversion->width = -1;
+	conversion->precision = -1;
+	if (*p == '%') {
+		conversion->length = 2;
+		conversion->conversion = '%';
+		return true;
+	}
+	while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+		if (flags == sizeof(conversion->flags) - 1) {
+			return false;
+		}
+		conversion->flags[flags++] = *p++;
+	}
+	if (*p == '*') {
+		conversion->widthArgument = true;
+		p++;
+	} else if (*p >= '1' && *p <= '9') {
+		p = parseNumber(p, &conversion->width);
+		if (p == NULL) {
+			return false;
+		}
+	}
+	if (*p == '.') {
+		p++;
+		if (*p == '*') {
+			conversion->precisionArgument = true;
+			p++;
+		} else {
+			p = parseNumber(p, &conversion->precision);
+			if (p == NULL) {
+				return false;
+			}
+		}
+	}
+	if ((p[0] == 'h' && p[1] == 'h') || (p[0] == 'l' && p[1] == 'l')) {
+		memcpy(conversion->modifier, p, 2);
+		p += 2;
+	} else if (*p != '\0' && strchr("hljztL", *p) != NULL) {
+		conversion->modifier[0] = *p++;
+	}
+	conversion->conversion = *p;
+	switch (*p) {
+	case 'd':
+	case 'i':
+		conversion->code = integerCode(conversion->modifier, true);
+		break;
+	case 'o':
+	case 'u':
+	case 'x':
+	case 'X':
+		conversion->code = integerCode(conversion->modifier, false);
+		break;
+	case 'c':
+		conversion->code = conversion->modifier[0] == '\0' ? 'i' : 0;
+		break;
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		if (conversion->modifier[0] == '\0' || strcmp(conversion->modifier, "l") == 0) {
+			conversion->code = 'd';
+		} else if (strcmp(conversion->modifier, "L") == 0) {
+			conversion->code = 'D';
+		}
+		break;
+	case 's':
+		conversion->code = conversion->modifier[0] == '\0' ? 's' : 0;
+		break;
+	case 'p':
+		conversion->code = conversion->modifier[0] == '\0' ? 'p' : 0;
+		break;
+	default: // Includes %n and the end of the format
+		break;
+	}
+	conversion->length = (size_t) (p + 1 - spec);
+	return conversion->code != 0;
+}
+
+bool spLoggerBinarySignature(const char* format, char* signature) {
+	// Function variables
+	SPLoggerConversion conversion;
+	size_t count = 0; // The number of arguments
+	size_t at = 0;
+	// Function code
+	while ((format = strchr(format, '%')) != NULL) {
+		if (!spLoggerBinaryParseConversion(format, &conversion)) {
+			return false;
+		}
+		format += conversion.length;
+		if (conversion.conversion == '%') {
+			continue;
+		}
+		if (count + conversion.widthArgument + conversion.precisionArgument + 1
+				> SP_LOGGER_MAX_ARGUMENTS) {
+			return false;
+		}
+		count += conversion.widthArgument + conversion.precisionArgument + 1;
+		if (conversion.widthArgument) {
+			signature[at++] = 'i';
+		}
+		if (conversion.precisionArgument) {
+			signature[at++] = conversion.code == 's' ? 'P' : 'i';
+		} else if (conversion.code == 's' && conversion.precision >= 0) {
+			// Longer strings do not fit in a record, so the precision is cut to 4 digits
+			at += (size_t) sprintf(signature + at, ".%d", conversion.precision < SP_LOGGER_MAX_MESSAGE_SIZE
+					? conversion.precision : SP_LOGGER_MAX_MESSAGE_SIZE);
+		}
+		signature[at++] = conversion.code;
+	}
+	signature[at] = '\0';
+	return true;
+}
+
+size_t spLoggerBinaryEncodeHeader(char* out) {
+	memcpy(out, SP_LOGGER_BINARY_MAGIC, SP_LOGGER_BINARY_MAGIC_SIZE);
+	return put32(out, SP_LOGGER_BINARY_MAGIC_SIZE, SP_LOGGER_BINARY_BYTE_ORDER);
+}
+
+size_t spLoggerBinaryEncodeSite(char* out, size_t limit, unsigned int id,
+		const SPLoggerSite* site) {
+	// Function variables
+	size_t fileLength = strlen(site->file);
+	size_t functionLength = strlen(site->function);
+	size_t formatLength = strlen(site->format);
+	size_t length = SP_LOGGER_RECORD_HEADER_SIZE + 24 + fileLength + functionLength + formatLength;
+	size_t at;
+	// Function code
+	if (length > limit) {
+		return 0;
+	}
+	at = putRecordHeader(out, SP_LOGGER_RECORD_SITE, length);
+	at = put32(out, at, id);
+	at = put32(out, at, (uint32_t) site->level);
+	at = put32(out, at, (uint32_t) site->line);
+	at = put32(out, at, (uint32_t) fileLength);
+	at = put32(out, at, (uint32_t) functionLength);
+	at = put32(out, at, (uint32_t) formatLength);
+	memcpy(out + at, site->file, fileLength);
+	memcpy(out + at + fileLength, site->function, functionLength);
+	memcpy(out + at + fileLength + functionLength, site->format, formatLength);
+	return length;
+}
+
+size_t spLoggerBinaryEncodeEvent(char* out, size_t limit, unsigned int id,
+		long long timestamp, const char* signature, va_list args) {
+	// Function variables
+	size_t at = SP_LOGGER_RECORD_HEADER_SIZE + 12;
+	size_t spare, length;
+	long precision = -1; // The precision of the next string, -1 if none
+	const char* code;
+	const char* text;
+	const char* nul;
+	// Function code
+	for (code = signature; *code != '\0'; code++) {
+		at += codeSize(*code);
+	}
+	if (at > limit) {
+		return 0;
+	}
+	spare = limit - at; // Room for string bytes
+	at = put32(out, SP_LOGGER_RECORD_HEADER_SIZE, id);
+	at = put64(out, at, (uint64_t) timestamp);
+	for (code = signature; *code != '\0'; code++) {
+		switch (*code) {
+		case 'i':
+			at = put32(out, at, (uint32_t) va_arg(args, int));
+			break;
+		case 'P': {
+			int value = va_arg(args, int);
+			precision = value; // A negative precision is taken as if it was omitted
+			at = put32(out, at, (uint32_t) value);
+			break;
+		}
+		case '.':
+			precision = 0;
+			while (code[1] >= '0' && code[1] <= '9') {
+				precision = precision * 10 + (*++code - '0');
+			}
+			break;
+		case 'I':
+			at = put32(out, at, va_arg(args, unsigned int));
+			break;
+		case 'l':
+			at = put64(out, at, (uint64_t) va_arg(args, long));
+			break;
+		case 'L':
+			at = put64(out, at, va_arg(args, unsigned long));
+			break;
+		case 'q':
+			at = put64(out, at, (uint64_t) va_arg(args, long long));
+			break;
+		case 'Q':
+			at = put64(out, at, va_arg(args, unsigned long long));
+			break;
+		case 'j':
+			at = put64(out, at, (uint64_t) va_arg(args, intmax_t));
+			break;
+		case 'J':
+			at = put64(out, at, (uint64_t) va_arg(args, uintmax_t));
+			break;
+		case 'z':
+			at = put64(out, at, (uint64_t) va_arg(args, size_t));
+			break;
+		case 't':
+			at = put64(out, at, (uint64_t) va_arg(args, ptrdiff_t));
+			break;
+		case 'p':
+			at = put64(out, at, (uint64_t) (uintptr_t) va_arg(args, void*));
+			break;
+		case 'd': {
+			double value = va_arg(args, double);
+			memcpy(out + at, &value, sizeof(value));
+			at += sizeof(value);
+			break;
+		}
+		case 'D': {
+			double value = (double) va_arg(args, long double);
+			memcpy(out + at, &value, sizeof(value));
+			at += sizeof(value);
+			break;
+		}
+		case 's':
+			text = va_arg(args, const char*);
+			if (text == NULL) {
+				text = "(null)";
+			}
+			length = spare; // Truncate to fit
+			if (precision >= 0 && (size_t) precision < length) {
+				length = (size_t) precision;
+			}
+			nul = (const char*) memchr(text, '\0', length); // Not reading past the precision
+			if (nul != NULL) {
+				length = (size_t) (nul - text);
+			}
+			precision = -1;
+			spare -= length;
+			at = put32(out, at, (uint32_t) length);
+			memcpy(out + at, text, length);
+			at += length;
+			break;
+		}
+	}
+	putRecordHeader(out, SP_LOGGER_RECORD_EVENT, at);
+	return at;
+}
+
+size_t spLoggerBinaryEncodeText(char* out, size_t limit, long long timestamp,
+		const char* text, size_t length) {
+	// Function variables
+	size_t at = SP_LOGGER_RECORD_HEADER_SIZE + 8;
+	// Function code
+	if (at > limit) {
+		return 0;
+	}
+	if (length > limit - at) { // Truncate to fit
+		length = limit - at;
+	}
+	put64(out, SP_LOGGER_RECORD_HEADER_SIZE, (uint64_t) timestamp);
+	memcpy(out + at, text, length);
+	putRecordHeader(out, SP_LOGGER_RECORD_TEXT, at + length);
+	return at + length;
+}
+
+int spLoggerBinaryFormatHeader(char* out, size_t size, SP_LOGGER_LEVEL level,
+		const char* file, const char* function, int line) {
+	// Function variables
+	static const char* headers[] = {"ERROR", "WARNING", "INFO", "DEBUG"};
+	// Function code
+	if (level == SP_LOGGER_INFO_WARNING_ERROR_LEVEL) {
+		return snprintf(out, size, "---INFO---\n- message: ");
+	}
+	return snprintf(out, size, "---%s---\n- file: %s\n- function: %s\n- line: %d\n- message: ",
+			headers[level], file, function, line);
+}
+
+// Appends formatted text to a message of size bytes, as the text logger truncates it
+static void append(char* out, size_t size, size_t* length, const char* format, ...) {
+	// Function variables
+	va_list args;
+	int formatted;
+	// Function code
+	if (*length >= size - 1) {
+		return;
+	}
+	va_start(args, format);
+	formatted = vsnprintf(out + *length, size - *length, format, args);
+	va_end(args);
+	if (formatted > 0) {
+		*length += (size_t) formatted;
+	}
+	if (*length > size - 1) {
+		*length = size - 1;
+	}
+}
+
+// Formats the message of an event into a message of size bytes, returns false if the arguments are corrupted
+static bool decodeMessage(const char* format, const char* args, size_t argsLength,
+		char* out, size_t size, size_t* length, char* string) {
+	// Function variables
+	SPLoggerConversion conversion;
+	const char* percent;
+	const char* end = args + argsLength;
+	char spec[48];
+	size_t at, stringLength;
+	int value;
+	bool isSigned;
+	// Function code
+	while ((percent = strchr(format, '%')) != NULL) {
+		append(out, size, length, "%.*s", (int) (percent - format), format);
+		if (!spLoggerBinaryParseConversion(percent, &conversion)) {
+			return false;
+		}
+		format = percent + conversion.length;
+		if (conversion.conversion == '%') {
+			append(out, size, length, "%%");
+			continue;
+		}
+		at = (size_t) sprintf(spec, "%%%s", conversion.flags);
+		if (conversion.widthArgument) {
+			if (end - args < 4) {
+				return false;
+			}
+			value = (int) get32(args);
+			args += 4;
+			if (value < 0) { // A negative width is a '-' flag
+				at += (size_t) sprintf(spec + at, "-");
+				value = value < -SP_LOGGER_MAX_CONVERSION_WIDTH ? SP_LOGGER_MAX_CONVERSION_WIDTH : -value;
+			}
+			at += (size_t) sprintf(spec + at, "%d", value > SP_LOGGER_MAX_CONVERSION_WIDTH
+					? SP_LOGGER_MAX_CONVERSION_WIDTH : value);
+		} else if (conversion.width >= 0) {
+			at += (size_t) sprintf(spec + at, "%d", conversion.width);
+		}
+		if (conversion.precisionArgument) {
+			if (end - args < 4) {
+				return false;
+			}
+			value = (int) get32(args);
+			args += 4;
+			if (value >= 0) { // A negative precision is taken as if it was omitted
+				at += (size_t) sprintf(spec + at, ".%d", value > SP_LOGGER_MAX_CONVERSION_WIDTH
+						? SP_LOGGER_MAX_CONVERSION_WIDTH : value);
+			}
+		} else if (conversion.precision >= 0) {
+			at += (size_t) sprintf(spec + at, ".%d", conversion.precision);
+		}
+		if (end - args < (ptrdiff_t) codeSize(conversion.code)) {
+			return false;
+		}
+		isSigned = conversion.conversion == 'd' || conversion.conversion == 'i'
+				|| conversion.conversion == 'c';
+		switch (conversion.code) {
+		case 'i':
+		case 'I':
+			sprintf(spec + at, "%s%c", conversion.modifier, conversion.conversion);
+			if (isSigned) {
+				append(out, size, length, spec, (int) get32(args));
+			} else {
+				append(out, size, length, spec, (unsigned int) get32(args));
+			}
+			args += 4;
+			break;
+		case 'd':
+		case 'D': {
+			double number;
+			memcpy(&number, args, sizeof(number));
+			sprintf(spec + at, "%c", conversion.conversion);
+			append(out, size, length, spec, number);
+			args += 8;
+			break;
+		}
+		case 'p':
+			sprintf(spec + at, "p");
+			append(out, size, length, spec, (void*) (uintptr_t) get64(args));
+			args += 8;
+			break;
+		case 's':
+			stringLength = get32(args);
+			args += 4;
+			if (stringLength > (size_t) (end - args) || stringLength >= size) {
+				return false;
+			}
+			memcpy(string, args, stringLength);
+			string[stringLength] = '\0';
+			args += stringLength;
+			sprintf(spec + at, "s");
+			append(out, size, length, spec, string);
+			break;
+		default: // 8 byte integers
+			sprintf(spec + at, "ll%c", conversion.conversion);
+			if (isSigned) {
+				append(out, size, length, spec, (long long) get64(args));
+			} else {
+				append(out, size, length, spec, (unsigned long long) get64(args));
+			}
+			args += 8;
+			break;
+		}
+	}
+	append(out, size, length, "%s", format);
+	return true;
+}
+
+// Reads a record into a growing buffer, returns 1 on success, 0 at the end of the input and -1 on errors
+static int readRecord(FILE* input, char** body, size_t* capacity, char* type, size_t* length) {
+	// Function variables
+	char header[SP_LOGGER_RECORD_HEADER_SIZE];
+	char* grown;
+	size_t read = fread(header, 1, sizeof(header), input);
+	// Function code
+	if (read == 0) {
+		return 0;
+	}
+	if (read != sizeof(header)) {
+		return -1;
+	}
+	*type = header[0];
+	*length = get32(header + 1);
+	if (*length > SP_LOGGER_MAX_RECORD_SIZE) {
+		return -1;
+	}
+	if (*length > *capacity) {
+		grown = (char*) realloc(*body, *length);
+		if (grown == NULL) {
+			return -2;
+		}
+		*body = grown;
+		*capacity = *length;
+	}
+	return fread(*body, 1, *length, input) == *length ? 1 : -1;
+}
+
+// Stores a call site definition read from a record
+static SP_LOGGER_MSG decodeSite(const char* body, size_t length, SPLoggerDecodeSite** sites,
+		size_t* sitesNum) {
+	// Function variables
+	size_t id, fileLength, functionLength, formatLength, i;
+	SPLoggerDecodeSite* grown;
+	SPLoggerDecodeSite* site;
+	// Function code
+	if (length < 24) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	id = get32(body);
+	fileLength = get32(body + 12);
+	functionLength = get32(body + 16);
+	formatLength = get32(body + 20);
+	if (id == 0 || get32(body + 4) > SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL
+			|| 24 + fileLength + functionLength + formatLength != length) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	if (id >= *sitesNum) {
+		grown = (SPLoggerDecodeSite*) realloc(*sites, (id + 1) * sizeof(SPLoggerDecodeSite));
+		if (grown == NULL) {
+			return SP_LOGGER_OUT_OF_MEMORY;
+		}
+		for (i = *sitesNum; i <= id; i++) {
+			grown[i].strings = NULL;
+		}
+		*sites = grown;
+		*sitesNum = id + 1;
+	}
+	site = &(*sites)[id];
+	free(site->strings);
+	site->strings = (char*) malloc(fileLength + functionLength + formatLength + 3);
+	if (site->strings == NULL) {
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	site->level = (SP_LOGGER_LEVEL) get32(body + 4);
+	site->line = (int) get32(body + 8);
+	memcpy(site->strings, body + 24, fileLength);
+	site->strings[fileLength] = '\0';
+	site->function = site->strings + fileLength + 1;
+	memcpy(site->strings + fileLength + 1, body + 24 + fileLength, functionLength);
+	site->strings[fileLength + 1 + functionLength] = '\0';
+	site->format = site->function + functionLength + 1;
+	memcpy(site->strings + fileLength + functionLength + 2, body + 24 + fileLength + functionLength,
+			formatLength);
+	site->strings[fileLength + functionLength + 2 + formatLength] = '\0';
+	return SP_LOGGER_SUCCESS;
+}
+
+// Writes the text of one message, optionally preceded by its timestamp
+static bool writeMessage(FILE* output, const char* text, size_t length, bool timestamps,
+		long long timestamp) {
+	if (timestamps && fprintf(output, "@%lld.%09lld\n", timestamp / 1000000000LL,
+			timestamp % 1000000000LL) < 0) {
+		return false;
+	}
+	return fwrite(text, 1, length, output) == length && putc('\n', output) != EOF;
+}
+
+SP_LOGGER_MSG spLoggerBinaryDecode(FILE* input, FILE* output, bool timestamps) {
+	// Function variables
+	char header[SP_LOGGER_BINARY_HEADER_SIZE];
+	char* body = NULL;
+	char* message = NULL;
+	char* string = NULL;
+	size_t capacity = 0, length, sitesNum = 0, messageLength, id, i;
+	SPLoggerDecodeSite* sites = NULL;
+	SP_LOGGER_MSG status = SP_LOGGER_SUCCESS;
+	char type;
+	int read;
+	int headerLength;
+	// Function code
+	if (input == NULL || output == NULL) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	if (fread(header, 1, sizeof(header), input) != sizeof(header)
+			|| memcmp(header, SP_LOGGER_BINARY_MAGIC, SP_LOGGER_BINARY_MAGIC_SIZE) != 0
+			|| get32(header + SP_LOGGER_BINARY_MAGIC_SIZE) != SP_LOGGER_BINARY_BYTE_ORDER) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	message = (char*) malloc(SP_LOGGER_MAX_MESSAGE_SIZE);
+	string = (char*) malloc(SP_LOGGER_MAX_MESSAGE_SIZE);
+	if (message == NULL || string == NULL) {
+		free(message);
+		free(string);
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	while (status == SP_LOGGER_SUCCESS
+			&& (read = readRecord(input, &body, &capacity, &type, &length)) != 0) {
+		if (read < 0) {
+			status = read == -2 ? SP_LOGGER_OUT_OF_MEMORY : SP_LOGGER_INVAlID_ARGUMENT;
+		} else if (type == SP_LOGGER_RECORD_SITE) {
+			status = decodeSite(body, length, &sites, &sitesNum);
+		} else if (type == SP_LOGGER_RECORD_TEXT) {
+			if (length < 8) {
+				status = SP_LOGGER_INVAlID_ARGUMENT;
+			} else if (!writeMessage(output, body + 8, length - 8, timestamps, (long long) get64(body))) {
+				status = SP_LOGGER_WRITE_FAIL;
+			}
+		} else if (type == SP_LOGGER_RECORD_EVENT) {
+			id = length < 12 ? 0 : get32(body);
+			if (id == 0 || id >= sitesNum || sites[id].strings == NULL) {
+				status = SP_LOGGER_INVAlID_ARGUMENT;
+				continue;
+			}
+			headerLength = spLoggerBinaryFormatHeader(message, SP_LOGGER_MAX_MESSAGE_SIZE,
+					sites[id].level, sites[id].strings, sites[id].function, sites[id].line);
+			messageLength = headerLength < 0 ? 0 : (size_t) headerLength;
+			if (messageLength > SP_LOGGER_MAX_MESSAGE_SIZE - 1) {
+				messageLength = SP_LOGGER_MAX_MESSAGE_SIZE - 1;
+			}
+			if (!decodeMessage(sites[id].format, body + 12, length - 12, message,
+					SP_LOGGER_MAX_MESSAGE_SIZE, &messageLength, string)) {
+				status = SP_LOGGER_INVAlID_ARGUMENT;
+			} else if (!writeMessage(output, message, messageLength, timestamps,
+					(long long) get64(body + 4))) {
+				status = SP_LOGGER_WRITE_FAIL;
+			}
+		} // Records of other types are skipped
+	}
+	for (i = 0; i < sitesNum; i++) {
+		free(sites[i].strings);
+	}
+	free(sites);
+	free(body);
+	free(message);
+	free(string);
+	return status;
+}
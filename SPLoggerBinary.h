@@ -0,0 +1,149 @@
+#ifndef SPLOGGERBINARY_H_
+#define SPLOGGERBINARY_H_
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "SPLogger.h"
+/**
+ * SP Logger binary format summary:
+ *
+ * A logger created with the binary option does not format the messages of the
+ * SP_LOG_* macros. It writes the id of the call site, a timestamp and the raw
+ * bytes of the arguments instead, and the text is produced later by the
+ * splog-decode tool (tools/splog_decode.c), in the layout of a text logger.
+ *
+ * A binary log starts with the 8 bytes of SP_LOGGER_BINARY_MAGIC and the 4 byte
+ * number SP_LOGGER_BINARY_BYTE_ORDER, followed by records. Numbers are written
+ * in the byte order of the writing machine, which the decoder checks. Every
+ * record starts with a 1 byte type and the 4 byte length of its body:
+ *
+ * 	- SP_LOGGER_RECORD_SITE: defines a call site, before its first message.
+ * 	  Body: id (4), level (4), line (4), the lengths of the file, function and
+ * 	  format (4 each), then the file, function and format strings.
+ * 	- SP_LOGGER_RECORD_EVENT: a message of a call site.
+ * 	  Body: id (4), timestamp in nanoseconds (8), then the arguments in format
+ * 	  order.
+ * 	- SP_LOGGER_RECORD_TEXT: a message which was formatted when it was printed
+ * 	  (by spLoggerPrintError and the other print functions, or by a call site
+ * 	  whose format is not supported). Body: timestamp (8), then the text.
+ *
+ * Arguments are written by their promoted type: int and unsigned int take 4
+ * bytes; the other integers and pointers take 8; floating point values are
+ * written as a double (8 bytes), so long double arguments lose precision;
+ * strings are written as their length (4) and their bytes. A format is
+ * supported if it has up to SP_LOGGER_MAX_ARGUMENTS arguments (counting '*'
+ * widths and precisions) and none of the %n, %lc and %ls conversions.
+ *
+ * The functions below are shared by the logger and the decoder.
+ */
+
+/** The first bytes of a binary log **/
+#define SP_LOGGER_BINARY_MAGIC "SPLOGB1\n"
+#define SP_LOGGER_BINARY_MAGIC_SIZE 8
+#define SP_LOGGER_BINARY_BYTE_ORDER 0x01020304u
+#define SP_LOGGER_BINARY_HEADER_SIZE 12
+
+/** The size of the type and length which start every record **/
+#define SP_LOGGER_RECORD_HEADER_SIZE 5
+
+/** The types of records **/
+#define SP_LOGGER_RECORD_SITE 'S'
+#define SP_LOGGER_RECORD_EVENT 'E'
+#define SP_LOGGER_RECORD_TEXT 'T'
+
+/** A conversion of a format, as parsed by spLoggerBinaryParseConversion **/
+typedef struct sp_logger_conversion_t {
+	size_t length; // The number of characters of the conversion, from its '%'
+	char flags[8]; // The flags, as a string
+	int width; // The width, or -1 if none or given by an argument
+	bool widthArgument; // Indicates a '*' width
+	int precision; // The precision, or -1 if none or given by an argument
+	bool precisionArgument; // Indicates a '*' precision
+	char modifier[3]; // The length modifier, as a string
+	char conversion; // The conversion specifier, such as 'd' or 's'
+	char code; // The argument code of the value (see SPLoggerBinary.c), 0 for "%%"
+} SPLoggerConversion;
+
+/**
+ * Parses the conversion which starts at spec, which must point at a '%'.
+ *
+ * @return
+ * false if the conversion is not valid or not supported, true otherwise
+ */
+bool spLoggerBinaryParseConversion(const char* spec, SPLoggerConversion* conversion);
+
+/**
+ * Computes the argument codes of a format, in argument order, as a string of
+ * up to SP_LOGGER_MAX_SIGNATURE_SIZE - 1 characters: a code per argument (up
+ * to SP_LOGGER_MAX_ARGUMENTS), and the static precisions of the strings.
+ *
+ * @return
+ * false if the format is not supported, true otherwise
+ */
+bool spLoggerBinarySignature(const char* format, char* signature);
+
+/**
+ * Writes the header of a binary log to out, which must hold at least
+ * SP_LOGGER_BINARY_HEADER_SIZE bytes.
+ *
+ * @return The number of bytes written
+ */
+size_t spLoggerBinaryEncodeHeader(char* out);
+
+/**
+ * Encodes a call site definition record into at most limit bytes of out.
+ *
+ * @return The length of the record, or 0 if it does not fit
+ */
+size_t spLoggerBinaryEncodeSite(char* out, size_t limit, unsigned int id,
+		const SPLoggerSite* site);
+
+/**
+ * Encodes a message record of the call site with the given id into at most
+ * limit bytes of out, reading the arguments given by signature from args.
+ * String arguments are truncated to fit.
+ *
+ * @return The length of the record, or 0 if it does not fit
+ */
+size_t spLoggerBinaryEncodeEvent(char* out, size_t limit, unsigned int id,
+		long long timestamp, const char* signature, va_list args);
+
+/**
+ * Encodes a text record into at most limit bytes of out, truncating the text
+ * to fit.
+ *
+ * @return The length of the record, or 0 if not even its header fits
+ */
+size_t spLoggerBinaryEncodeText(char* out, size_t limit, long long timestamp,
+		const char* text, size_t length);
+
+/**
+ * Formats the header which a text logger prints before a message of the given
+ * level, into at most size bytes of out, as snprintf does. The file, function
+ * and line are not printed for the info level.
+ *
+ * @return The length of the header, as returned by snprintf
+ */
+int spLoggerBinaryFormatHeader(char* out, size_t size, SP_LOGGER_LEVEL level,
+		const char* file, const char* function, int line);
+
+/**
+ * Decodes a binary log into the text a text logger would have printed. Each
+ * message is printed with at most SP_LOGGER_MAX_MESSAGE_SIZE - 1 characters
+ * and a new line.
+ *
+ * @param input - The binary log
+ * @param output - The stream the text is written to
+ * @param timestamps - If true, every message is preceded by a line holding its
+ * 					   timestamp, as "@seconds.nanoseconds"
+ * @return
+ * SP_LOGGER_INVAlID_ARGUMENT	- If input or output are NULL, or input is not a
+ * 								  valid binary log of this machine
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure
+ * SP_LOGGER_WRITE_FAIL			- If writing the output failed
+ * SP_LOGGER_SUCCESS			- otherwise
+ */
+SP_LOGGER_MSG spLoggerBinaryDecode(FILE* input, FILE* output, bool timestamps);
+
+#endif /* SPLOGGERBINARY_H_ */
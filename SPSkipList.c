@@ -0,0 +1,387 @@
+#include "SPSkipList.h"
+#include "SPListElementInternal.h"
+#include <stdlib.h> // malloc, free, NULL
+#include <stddef.h> // size_t
+
+#define SP_SKIP_LIST_MAX_LEVEL 16 // Enough for 4^16 elements
+#define SP_SKIP_LIST_MIN_CHUNK_BYTES 1024 // Size of the first pool chunk
+#define SP_SKIP_LIST_MAX_CHUNK_BYTES 65536 // Chunks stop doubling at this size
+
+// A node with level forward links, the node is allocated with room for them
+typedef struct skip_node_t {
+	struct sp_list_element_t data;
+	struct skip_node_t* previous; // The previous node on level 0, NULL for the first node
+	int level;
+	struct skip_node_t* next[];
+} *SkipNode;
+
+typedef struct skip_chunk_t {
+	struct skip_chunk_t* next;
+	size_t used;
+	size_t capacity;
+} *SkipChunk; // Followed by capacity bytes of nodes
+
+struct sp_skip_list_t {
+	SkipNode head; // Has SP_SKIP_LIST_MAX_LEVEL links, holds no element
+	SkipNode last;
+	SkipNode current;
+	int level; // The highest level of a node in the list
+	int size;
+	unsigned int random; // State of the level generator
+	// The pool: nodes are carved out of chunks, freed nodes are kept by level
+	SkipNode freeNodes[SP_SKIP_LIST_MAX_LEVEL]; // Linked through next[0]
+	SkipChunk chunks;
+	size_t nextChunkBytes;
+};
+
+// Helper functions
+
+// Same relation as spListElementCompare
+static int keyCompare(const struct sp_list_element_t* e1, const struct sp_list_element_t* e2) {
+	return spListElementOrder(e1, e2);
+}
+
+// Returns a level in [1, SP_SKIP_LIST_MAX_LEVEL], level l+1 with probability 1/4^l
+static int randomLevel(SPSkipList list) {
+	unsigned int bits;
+	int level = 1;
+	list->random ^= list->random << 13; // xorshift32
+	list->random ^= list->random >> 17;
+	list->random ^= list->random << 5;
+	for (bits = list->random; (bits & 3) == 0 && level < SP_SKIP_LIST_MAX_LEVEL; bits >>= 2) {
+		level++;
+	}
+	return level;
+}
+
+static size_t nodeBytes(int level) {
+	return sizeof(struct skip_node_t) + sizeof(SkipNode)*level;
+}
+
+static SkipNode nodeCreate(SPSkipList list, int level, SPListElement element) {
+	SkipNode node = list->freeNodes[level-1];
+	SkipChunk chunk = list->chunks;
+	size_t bytes = nodeBytes(level);
+	if (node != NULL) {
+		list->freeNodes[level-1] = node->next[0];
+	} else {
+		if (chunk == NULL || chunk->capacity - chunk->used < bytes) {
+			while (list->nextChunkBytes < bytes) {
+				list->nextChunkBytes *= 2;
+			}
+			chunk = (SkipChunk) malloc(sizeof(*chunk) + list->nextChunkBytes);
+			if (chunk == NULL) {
+				return NULL;
+			}
+			chunk->next = list->chunks;
+			chunk->used = 0;
+			chunk->capacity = list->nextChunkBytes;
+			list->chunks = chunk;
+			if (list->nextChunkBytes < SP_SKIP_LIST_MAX_CHUNK_BYTES) {
+				list->nextChunkBytes *= 2;
+			}
+		}
+		node = (SkipNode) ((char*) (chunk + 1) + chunk->used);
+		chunk->used += bytes;
+	}
+	node->data = *element;
+	node->level = level;
+	return node;
+}
+
+static void nodeDestroy(SPSkipList list, SkipNode node) {
+	node->next[0] = list->freeNodes[node->level-1];
+	list->freeNodes[node->level-1] = node;
+}
+
+// Removes node from all the levels it is linked in
+static void unlinkNode(SPSkipList list, SkipNode node) {
+	SkipNode update[SP_SKIP_LIST_MAX_LEVEL];
+	SkipNode x = list->head;
+	int l;
+	for (l = list->level - 1; l >= 0; l--) { // The last node lower than node on each level
+		while (x->next[l] != NULL && keyCompare(&x->next[l]->data, &node->data) < 0) {
+			x = x->next[l];
+		}
+		update[l] = x;
+	}
+	for (l = 0; l < node->level; l++) {
+		for (x = update[l]; x->next[l] != node; x = x->next[l]) {
+			// Skips elements equal to node which were inserted before it
+		}
+		x->next[l] = node->next[l];
+	}
+	if (node->next[0] == NULL) {
+		list->last = node->previous;
+	} else {
+		node->next[0]->previous = node->previous;
+	}
+	while (list->level > 1 && list->head->next[list->level-1] == NULL) {
+		list->level--;
+	}
+	if (list->current == node) {
+		list->current = NULL;
+	}
+	list->size--;
+	nodeDestroy(list, node);
+}
+
+SPSkipList spSkipListCreate() {
+	SPSkipList list = (SPSkipList) malloc(sizeof(*list));
+	int l;
+	if (list == NULL) {
+		return NULL;
+	}
+	list->head = (SkipNode) malloc(nodeBytes(SP_SKIP_LIST_MAX_LEVEL));
+	if (list->head == NULL) {
+		free(list);
+		return NULL;
+	}
+	list->head->previous = NULL;
+	list->head->level = SP_SKIP_LIST_MAX_LEVEL;
+	for (l = 0; l < SP_SKIP_LIST_MAX_LEVEL; l++) {
+		list->head->next[l] = NULL;
+		list->freeNodes[l] = NULL;
+	}
+	list->last = NULL;
+	list->current = NULL;
+	list->level = 1;
+	list->size = 0;
+	list->random = 2463534242u;
+	list->chunks = NULL;
+	list->nextChunkBytes = SP_SKIP_LIST_MIN_CHUNK_BYTES;
+	return list;
+}
+
+void spSkipListDestroy(SPSkipList list) {
+	SkipChunk chunk;
+	if (list == NULL) {
+		return;
+	}
+	while (list->chunks != NULL) {
+		chunk = list->chunks;
+		list->chunks = chunk->next;
+		free(chunk);
+	}
+	free(list->head);
+	free(list);
+}
+
+SPSkipList spSkipListCopy(SPSkipList list) {
+	SkipNode tails[SP_SKIP_LIST_MAX_LEVEL]; // The last copied node on each level
+	SkipNode node, newNode;
+	SPSkipList copyList;
+	int l;
+	if (list == NULL) {
+		return NULL;
+	}
+	copyList = spSkipListCreate();
+	if (copyList == NULL) {
+		return NULL;
+	}
+	for (l = 0; l < SP_SKIP_LIST_MAX_LEVEL; l++) {
+		tails[l] = copyList->head;
+	}
+	for (node = list->head->next[0]; node != NULL; node = node->next[0]) { // Same shape
+		newNode = nodeCreate(copyList, node->level, &node->data);
+		if (newNode == NULL) {
+			spSkipListDestroy(copyList);
+			return NULL;
+		}
+		newNode->previous = copyList->last;
+		for (l = 0; l < node->level; l++) {
+			tails[l]->next[l] = newNode;
+			tails[l] = newNode;
+		}
+		copyList->last = newNode;
+	}
+	for (l = 0; l < SP_SKIP_LIST_MAX_LEVEL; l++) {
+		tails[l]->next[l] = NULL;
+	}
+	copyList->level = list->level;
+	copyList->size = list->size;
+	copyList->random = list->random;
+	return copyList;
+}
+
+int spSkipListGetSize(SPSkipList list) {
+	return list == NULL ? -1 : list->size;
+}
+
+SP_SKIP_LIST_MSG spSkipListInsert(SPSkipList list, SPListElement element) {
+	SkipNode update[SP_SKIP_LIST_MAX_LEVEL];
+	SkipNode x, node;
+	int l, level;
+	if (list == NULL || element == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	x = list->head;
+	for (l = list->level - 1; l >= 0; l--) { // The last node not higher than element
+		while (x->next[l] != NULL && keyCompare(&x->next[l]->data, element) <= 0) {
+			x = x->next[l];
+		}
+		update[l] = x;
+	}
+	level = randomLevel(list);
+	node = nodeCreate(list, level, element);
+	if (node == NULL) {
+		return SP_SKIP_LIST_OUT_OF_MEMORY;
+	}
+	for (l = list->level; l < level; l++) {
+		update[l] = list->head;
+	}
+	if (level > list->level) {
+		list->level = level;
+	}
+	for (l = 0; l < level; l++) {
+		node->next[l] = update[l]->next[l];
+		update[l]->next[l] = node;
+	}
+	node->previous = update[0] == list->head ? NULL : update[0];
+	if (node->next[0] == NULL) {
+		list->last = node;
+	} else {
+		node->next[0]->previous = node;
+	}
+	list->size++;
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemove(SPSkipList list, SPListElement element) {
+	SkipNode x;
+	int l;
+	if (list == NULL || element == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	x = list->head;
+	for (l = list->level - 1; l >= 0; l--) {
+		while (x->next[l] != NULL && keyCompare(&x->next[l]->data, element) < 0) {
+			x = x->next[l];
+		}
+	}
+	x = x->next[0];
+	if (x == NULL || keyCompare(&x->data, element) != 0) {
+		return SP_SKIP_LIST_NOT_FOUND;
+	}
+	unlinkNode(list, x);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemoveFirst(SPSkipList list) {
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	if (list->size == 0) {
+		return SP_SKIP_LIST_EMPTY;
+	}
+	unlinkNode(list, list->head->next[0]);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemoveLast(SPSkipList list) {
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	if (list->size == 0) {
+		return SP_SKIP_LIST_EMPTY;
+	}
+	unlinkNode(list, list->last);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemoveCurrent(SPSkipList list) {
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	if (list->current == NULL) {
+		return SP_SKIP_LIST_INVALID_CURRENT;
+	}
+	unlinkNode(list, list->current);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SPListElement spSkipListMin(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	return &list->head->next[0]->data;
+}
+
+SPListElement spSkipListMax(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	return &list->last->data;
+}
+
+int spSkipListToArray(SPSkipList list, int* indices, double* values) {
+	SkipNode node;
+	int i = 0;
+	if (list == NULL || indices == NULL || values == NULL) {
+		return -1;
+	}
+	for (node = list->head->next[0]; node != NULL; node = node->next[0], i++) {
+		indices[i] = node->data.index;
+		values[i] = node->data.value;
+	}
+	return list->size;
+}
+
+SPListElement spSkipListGetFirst(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	list->current = list->head->next[0];
+	return &list->current->data;
+}
+
+SPListElement spSkipListGetLast(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	list->current = list->last;
+	return &list->current->data;
+}
+
+SPListElement spSkipListGetNext(SPSkipList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	list->current = list->current->next[0];
+	return list->current == NULL ? NULL : &list->current->data;
+}
+
+SPListElement spSkipListGetPrevious(SPSkipList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	list->current = list->current->previous;
+	return list->current == NULL ? NULL : &list->current->data;
+}
+
+SPListElement spSkipListGetCurrent(SPSkipList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	return &list->current->data;
+}
+
+SP_SKIP_LIST_MSG spSkipListClear(SPSkipList list) {
+	SkipNode node, next;
+	int l;
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	for (node = list->head->next[0]; node != NULL; node = next) {
+		next = node->next[0];
+		nodeDestroy(list, node);
+	}
+	for (l = 0; l < SP_SKIP_LIST_MAX_LEVEL; l++) {
+		list->head->next[l] = NULL;
+	}
+	list->last = NULL;
+	list->current = NULL;
+	list->level = 1;
+	list->size = 0;
+	return SP_SKIP_LIST_SUCCESS;
+}
@@ -0,0 +1,294 @@
+#ifndef SPSKIPLIST_H_
+#define SPSKIPLIST_H_
+
+#include <stdbool.h>
+#include "SPListElement.h"
+/**
+ * Skip List Container Summary
+ *
+ * Implements an ordered container of SPListElement, kept sorted by the
+ * spListElementCompare order:
+ *
+ * Element e1 is lower than element e2 iff:
+ * 		(e1.value < e2.value)   OR (e1.value == e2.value AND e1.index < e2.index)
+ *
+ * Equal elements are kept in insertion order. Inserting and removing an
+ * element take expected O(log n) time, and the lowest and highest elements
+ * are reached in O(1), so the container can replace a sorted SPList where
+ * ordered insertion into a long list is too slow.
+ *
+ * The nodes of a skip list are taken from a private pool. The pool carves
+ * nodes out of large chunks, and keeps removed nodes in free lists (one per
+ * node height) for reuse, so a list which has reached its working size does
+ * not call the system allocator.
+ *
+ * As in SPList, each node stores a copy of its element by value. The elements
+ * returned by the functions below point into the node, belong to the list,
+ * and are only valid until they are removed from it. The list has an internal
+ * iterator with the same semantics as the internal iterator of SPList.
+ *
+ * The following functions are available:
+ *
+ *   spSkipListCreate           - Creates a new empty skip list
+ *   spSkipListDestroy          - Deletes an existing skip list and frees all resources
+ *   spSkipListCopy             - Copies an existing skip list
+ *   spSkipListGetSize          - Returns the size of a given skip list
+ *   spSkipListInsert           - Inserts a copy of an element at its place
+ *   spSkipListRemove           - Removes an element equal to a given element
+ *   spSkipListRemoveFirst      - Removes the lowest element
+ *   spSkipListRemoveLast       - Removes the highest element
+ *   spSkipListRemoveCurrent    - Removes the element pointed by the internal
+ *                                iterator
+ *   spSkipListMin              - Returns the lowest element, leaving the
+ *                                internal iterator unchanged
+ *   spSkipListMax              - Returns the highest element, leaving the
+ *                                internal iterator unchanged
+ *   spSkipListToArray          - Copies the indices and values of all the
+ *                                elements to arrays, in ascending order
+ *   spSkipListGetFirst         - Sets the internal iterator to the lowest
+ *                                element and returns it
+ *   spSkipListGetLast          - Sets the internal iterator to the highest
+ *                                element and returns it
+ *   spSkipListGetNext          - Advances the internal iterator to the next
+ *                                element and returns it
+ *   spSkipListGetPrevious      - Moves the internal iterator to the previous
+ *                                element and returns it
+ *   spSkipListGetCurrent       - Returns the current element
+ *   spSkipListClear            - Removes all the elements of a skip list
+ */
+
+/** Type for defining the skip list */
+typedef struct sp_skip_list_t *SPSkipList;
+
+/** Type used for returning error codes from skip list functions */
+typedef enum sp_skip_list_msg_t {
+	SP_SKIP_LIST_SUCCESS,
+	SP_SKIP_LIST_NULL_ARGUMENT,
+	SP_SKIP_LIST_OUT_OF_MEMORY,
+	SP_SKIP_LIST_INVALID_CURRENT,
+	SP_SKIP_LIST_EMPTY,
+	SP_SKIP_LIST_NOT_FOUND,
+} SP_SKIP_LIST_MSG;
+
+/**
+ * Allocates a new empty skip list.
+ *
+ * @return
+ * 	NULL - If allocations failed.
+ * 	A new skip list in case of success.
+ */
+SPSkipList spSkipListCreate();
+
+/**
+ * Deallocates an existing skip list and all of its nodes.
+ *
+ * @param list Target list to be deallocated. If list is NULL nothing will be
+ * done
+ */
+void spSkipListDestroy(SPSkipList list);
+
+/**
+ * Creates a copy of a skip list, in O(n). The internal iterator of the source
+ * list will not change, and the one of the copy will not be defined.
+ *
+ * @param list The list to copy
+ * @return
+ * NULL if a NULL was sent or a memory allocation failed.
+ * A skip list containing the same elements otherwise.
+ */
+SPSkipList spSkipListCopy(SPSkipList list);
+
+/**
+ * Returns the number of elements in a skip list. the iterator state will not
+ * change.
+ *
+ * @param list The target list
+ * @return
+ * -1 if a NULL pointer was sent.
+ * Otherwise the number of elements in the list.
+ */
+int spSkipListGetSize(SPSkipList list);
+
+/**
+ * Inserts a copy of an element at its place in the order, after all the
+ * elements equal to it. The internal iterator keeps pointing to the same
+ * element.
+ *
+ * @param list The target list
+ * @param element The element to insert. A copy of the element will be inserted
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if list or element are NULL
+ * SP_SKIP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_SKIP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_SKIP_LIST_MSG spSkipListInsert(SPSkipList list, SPListElement element);
+
+/**
+ * Removes the first element of the list which is equal to the given element
+ * (same index and value). The internal iterator keeps pointing to the same
+ * element, unless it pointed to the removed element, in which case it is not
+ * defined afterwards.
+ *
+ * @param list The target list
+ * @param element An element equal to the element to remove
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if list or element are NULL
+ * SP_SKIP_LIST_NOT_FOUND if no element of the list is equal to element
+ * SP_SKIP_LIST_SUCCESS the element has been removed successfully
+ */
+SP_SKIP_LIST_MSG spSkipListRemove(SPSkipList list, SPListElement element);
+
+/**
+ * Removes the lowest element of the list. The internal iterator is handled as
+ * in spSkipListRemove.
+ *
+ * @param list The target list
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if list is NULL
+ * SP_SKIP_LIST_EMPTY if the list is empty
+ * SP_SKIP_LIST_SUCCESS the element has been removed successfully
+ */
+SP_SKIP_LIST_MSG spSkipListRemoveFirst(SPSkipList list);
+
+/**
+ * Removes the highest element of the list. The internal iterator is handled
+ * as in spSkipListRemove.
+ *
+ * @param list The target list
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if list is NULL
+ * SP_SKIP_LIST_EMPTY if the list is empty
+ * SP_SKIP_LIST_SUCCESS the element has been removed successfully
+ */
+SP_SKIP_LIST_MSG spSkipListRemoveLast(SPSkipList list);
+
+/**
+ * Removes the element pointed by the internal iterator. The state of the
+ * internal iterator will not be defined afterwards.
+ *
+ * @param list The target list
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if list is NULL
+ * SP_SKIP_LIST_INVALID_CURRENT if the internal iterator is invalid
+ * SP_SKIP_LIST_SUCCESS the element has been removed successfully
+ */
+SP_SKIP_LIST_MSG spSkipListRemoveCurrent(SPSkipList list);
+
+/**
+ * Returns the lowest element of the list in O(1). The list is not modified,
+ * so this may be called concurrently by many readers.
+ *
+ * @param list The target list
+ * @return
+ * NULL if a NULL pointer was sent or the list is empty.
+ * The lowest element otherwise.
+ */
+SPListElement spSkipListMin(SPSkipList list);
+
+/**
+ * Returns the highest element of the list in O(1). The list is not modified,
+ * so this may be called concurrently by many readers.
+ *
+ * @param list The target list
+ * @return
+ * NULL if a NULL pointer was sent or the list is empty.
+ * The highest element otherwise.
+ */
+SPListElement spSkipListMax(SPSkipList list);
+
+/**
+ * Copies the indices and values of all the elements of the list, in ascending
+ * order, to two arrays, as spListToArray does. The internal iterator will not
+ * change, so this may be called concurrently by many readers.
+ *
+ * @param list The source list
+ * @param indices An array of at least spSkipListGetSize(list) ints, which
+ * receives the indices
+ * @param values An array of at least spSkipListGetSize(list) doubles, which
+ * receives the values
+ * @return
+ * -1 if a NULL pointer was sent
+ * The number of elements copied otherwise
+ */
+int spSkipListToArray(SPSkipList list, int* indices, double* values);
+
+/**
+ * Sets the internal iterator to the lowest element and retrieves it.
+ *
+ * @param list The target list
+ * @return
+ * NULL if a NULL pointer was sent or the list is empty.
+ * The lowest element otherwise.
+ */
+SPListElement spSkipListGetFirst(SPSkipList list);
+
+/**
+ * Sets the internal iterator to the highest element and retrieves it.
+ *
+ * @param list The target list
+ * @return
+ * NULL if a NULL pointer was sent or the list is empty.
+ * The highest element otherwise.
+ */
+SPListElement spSkipListGetLast(SPSkipList list);
+
+/**
+ * Advances the internal iterator to the next element and returns it. In case
+ * the return value is NULL, the state of the iterator will not be defined.
+ *
+ * @param list The target list
+ * @return
+ * NULL if reached the end of the list, the iterator is at an invalid state or
+ * a NULL sent as argument
+ * The next element otherwise
+ */
+SPListElement spSkipListGetNext(SPSkipList list);
+
+/**
+ * Moves the internal iterator to the previous element and returns it. In case
+ * the return value is NULL, the state of the iterator will not be defined.
+ *
+ * @param list The target list
+ * @return
+ * NULL if reached the start of the list, the iterator is at an invalid state
+ * or a NULL sent as argument
+ * The previous element otherwise
+ */
+SPListElement spSkipListGetPrevious(SPSkipList list);
+
+/**
+ * Returns the current element (pointed by the internal iterator)
+ *
+ * @param list The target list
+ * @return
+ * NULL if the iterator is at an invalid state or a NULL sent as argument
+ * The current element otherwise
+ */
+SPListElement spSkipListGetCurrent(SPSkipList list);
+
+/**
+ * Removes all the elements of a skip list. The nodes are kept by the pool of
+ * the list for reuse. The state of the internal iterator will not be defined
+ * afterwards.
+ *
+ * @param list Target list
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if a NULL pointer was sent.
+ * SP_SKIP_LIST_SUCCESS otherwise.
+ */
+SP_SKIP_LIST_MSG spSkipListClear(SPSkipList list);
+
+/**
+ * Macro for iterating over a skip list in ascending order, using the internal
+ * iterator. See SP_LIST_FOREACH in SPList.h.
+ *
+ * @param type The type of the elements in the list
+ * @param iterator The name of the variable to hold the next list element
+ * @param list the list to iterate over
+ */
+#define SP_SKIP_LIST_FOREACH(type,iterator,list) \
+	for(type iterator = spSkipListGetFirst(list) ; \
+		iterator ;\
+		iterator = spSkipListGetNext(list))
+
+#endif /* SPSKIPLIST_H_ */
@@ -0,0 +1,277 @@
+#ifndef SPSMALLBPQUEUE_H_
+#define SPSMALLBPQUEUE_H_
+#include "SPBPriorityQueue.h"
+#include "SPListElement.h"
+#include "SPListElementInternal.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+/**
+ * SP Small Bounded Priority Queue summary
+ *
+ * A bounded priority queue specialized for small size bounds
+ * (maxSize <= SP_SMALL_BPQUEUE_CAPACITY). It has the same ordering and the
+ * same enqueue/dequeue/peek semantics as SPBPQueue, see SPBPriorityQueue.h.
+ *
+ * The queue is a plain struct holding a fixed inline sorted array, so it can
+ * live on the stack or inside another struct, and needs no allocation at all.
+ * All functions are static inline so the compiler can specialize them.
+ *
+ * Insertion is a branch-free compare-and-shift over the array: every slot
+ * is computed with conditional selects instead of a data dependent search,
+ * which avoids branch mispredictions on random inputs. Values are compared
+ * through their bit patterns, which preserve the order of non-negative
+ * doubles, so all comparisons are integer comparisons.
+ *
+ * The struct fields are private, use the functions below only:
+ *
+ *   spSmallBPQueueInit        - Initializes an empty queue with a size bound
+ *   spSmallBPQueueClear       - Removes all elements from the queue
+ *   spSmallBPQueueSize        - Returns the number of elements
+ *   spSmallBPQueueGetMaxSize  - Returns the size bound
+ *   spSmallBPQueueOffer       - Inserts an (index, value) pair
+ *   spSmallBPQueueEnqueue     - Inserts a copy of an SPListElement
+ *   spSmallBPQueueDequeue     - Removes the lowest priority element
+ *   spSmallBPQueuePeek        - Returns a copy of the lowest priority element
+ *   spSmallBPQueuePeekLast    - Returns a copy of the highest priority element
+ *   spSmallBPQueueMinValue    - Returns the minimal value in the queue
+ *   spSmallBPQueueMaxValue    - Returns the maximal value in the queue
+ *   spSmallBPQueueIndexAt     - Returns the index of the i-th lowest element
+ *   spSmallBPQueueValueAt     - Returns the value of the i-th lowest element
+ *   spSmallBPQueueIsEmpty     - Returns true if the queue is empty
+ *   spSmallBPQueueIsFull      - Returns true if the queue is full
+ */
+
+/** The largest size bound supported by SPSmallBPQueue **/
+#define SP_SMALL_BPQUEUE_CAPACITY 32
+
+/** type used to define a small bounded priority queue, fields are private **/
+typedef struct sp_small_bp_queue_t {
+	uint64_t keys[SP_SMALL_BPQUEUE_CAPACITY]; // Value bit patterns, sorted ascending
+	int indices[SP_SMALL_BPQUEUE_CAPACITY];
+	int size;
+	int maxSize;
+} SPSmallBPQueue;
+
+static inline double spSmallBPQueueValueOf(uint64_t key) {
+	double value;
+	memcpy(&value, &key, sizeof(value));
+	return value;
+}
+
+/**
+ * Initializes an empty small queue.
+ *
+ * @param queue   - The queue to initialize.
+ * @param maxSize - The maximal number of elements allowed in the queue.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if queue is NULL, maxSize < 0 or
+ * maxSize > SP_SMALL_BPQUEUE_CAPACITY.
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+static inline SP_BPQUEUE_MSG spSmallBPQueueInit(SPSmallBPQueue* queue, int maxSize) {
+	if (queue == NULL || maxSize < 0 || maxSize > SP_SMALL_BPQUEUE_CAPACITY) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	queue->size = 0;
+	queue->maxSize = maxSize;
+	return SP_BPQUEUE_SUCCESS;
+}
+
+/**
+ * Removes all elements from the queue.
+ * @param queue - The queue to clear. If queue is NULL nothing is done.
+ */
+static inline void spSmallBPQueueClear(SPSmallBPQueue* queue) {
+	if (queue != NULL) {
+		queue->size = 0;
+	}
+}
+
+/**
+ * @return -1 if queue is NULL, otherwise the number of elements in the queue.
+ */
+static inline int spSmallBPQueueSize(const SPSmallBPQueue* queue) {
+	return queue == NULL ? -1 : queue->size;
+}
+
+/**
+ * @return -1 if queue is NULL, otherwise the size bound of the queue.
+ */
+static inline int spSmallBPQueueGetMaxSize(const SPSmallBPQueue* queue) {
+	return queue == NULL ? -1 : queue->maxSize;
+}
+
+/**
+ * Inserts an element given by its index and value into the queue.
+ * Same semantics as spBPQueueEnqueue.
+ *
+ * @param queue - The queue into which the element is inserted.
+ * @param index - The index of the element (index >= 0).
+ * @param value - The value of the element (value >= 0.0).
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if queue is NULL, index < 0 or value < 0.
+ * SP_BPQUEUE_FULL if the queue was full, so the highest priority element
+ * (possibly the new one) is not in the queue afterwards.
+ * SP_BPQUEUE_SUCCESS if the element has been inserted successfully.
+ */
+static inline SP_BPQUEUE_MSG spSmallBPQueueOffer(SPSmallBPQueue* queue, int index, double value) {
+	uint64_t key;
+	int last, j, move, keep;
+	bool wasFull;
+	if (queue == NULL || index < 0 || !(value >= 0.0)) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	key = spListElementValueKey(value);
+	wasFull = queue->size == queue->maxSize;
+	if (wasFull) {
+		last = queue->size - 1;
+		if (last < 0 || key > queue->keys[last]
+				|| (key == queue->keys[last] && index >= queue->indices[last])) {
+			return SP_BPQUEUE_FULL; // Not better than the highest priority element
+		}
+	} else {
+		last = queue->size;
+	}
+	// Every slot from last down to 0 either takes its lower neighbour (the new
+	// element belongs below it), the new element, or keeps its content. Slot
+	// last is free or holds the dropped element, so it never keeps it, and the
+	// keep of each lower slot is found before that slot is written.
+	keep = 0;
+	for (j = last; j > 0; j--) {
+		move = (key < queue->keys[j-1])
+				| ((key == queue->keys[j-1]) & (index < queue->indices[j-1]));
+		queue->keys[j] = move ? queue->keys[j-1] : (keep ? queue->keys[j] : key);
+		queue->indices[j] = move ? queue->indices[j-1] : (keep ? queue->indices[j] : index);
+		keep = (key > queue->keys[j-1])
+				| ((key == queue->keys[j-1]) & (index > queue->indices[j-1]));
+	}
+	queue->keys[0] = keep ? queue->keys[0] : key;
+	queue->indices[0] = keep ? queue->indices[0] : index;
+	if (wasFull) {
+		return SP_BPQUEUE_FULL;
+	}
+	queue->size++;
+	return SP_BPQUEUE_SUCCESS;
+}
+
+/**
+ * Inserts a copy of element into the queue, same as spSmallBPQueueOffer.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if queue or element are NULL.
+ * Otherwise same as spSmallBPQueueOffer.
+ */
+static inline SP_BPQUEUE_MSG spSmallBPQueueEnqueue(SPSmallBPQueue* queue, SPListElement element) {
+	if (element == NULL) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	return spSmallBPQueueOffer(queue, spListElementGetIndex(element), spListElementGetValue(element));
+}
+
+/**
+ * Removes the lowest priority element of the queue.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if queue is NULL.
+ * SP_BPQUEUE_EMPTY if the queue is empty.
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+static inline SP_BPQUEUE_MSG spSmallBPQueueDequeue(SPSmallBPQueue* queue) {
+	if (queue == NULL) {
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (queue->size == 0) {
+		return SP_BPQUEUE_EMPTY;
+	}
+	queue->size--;
+	memmove(queue->keys, queue->keys + 1, sizeof(uint64_t)*queue->size);
+	memmove(queue->indices, queue->indices + 1, sizeof(int)*queue->size);
+	return SP_BPQUEUE_SUCCESS;
+}
+
+/**
+ * @return
+ * NULL if queue is NULL, empty or allocation failed.
+ * Otherwise a new copy of the lowest priority element in the queue.
+ */
+static inline SPListElement spSmallBPQueuePeek(const SPSmallBPQueue* queue) {
+	if (queue == NULL || queue->size == 0) {
+		return NULL;
+	}
+	return spListElementCreate(queue->indices[0], spSmallBPQueueValueOf(queue->keys[0]));
+}
+
+/**
+ * @return
+ * NULL if queue is NULL, empty or allocation failed.
+ * Otherwise a new copy of the highest priority element in the queue.
+ */
+static inline SPListElement spSmallBPQueuePeekLast(const SPSmallBPQueue* queue) {
+	if (queue == NULL || queue->size == 0) {
+		return NULL;
+	}
+	return spListElementCreate(queue->indices[queue->size-1],
+			spSmallBPQueueValueOf(queue->keys[queue->size-1]));
+}
+
+/**
+ * @return -1.0 if queue is NULL or empty, otherwise the minimal value.
+ */
+static inline double spSmallBPQueueMinValue(const SPSmallBPQueue* queue) {
+	if (queue == NULL || queue->size == 0) {
+		return -1.0;
+	}
+	return spSmallBPQueueValueOf(queue->keys[0]);
+}
+
+/**
+ * @return -1.0 if queue is NULL or empty, otherwise the maximal value.
+ */
+static inline double spSmallBPQueueMaxValue(const SPSmallBPQueue* queue) {
+	if (queue == NULL || queue->size == 0) {
+		return -1.0;
+	}
+	return spSmallBPQueueValueOf(queue->keys[queue->size-1]);
+}
+
+/**
+ * @return -1 if queue is NULL or i is out of range, otherwise the index of
+ * the i-th lowest priority element (starting from 0).
+ */
+static inline int spSmallBPQueueIndexAt(const SPSmallBPQueue* queue, int i) {
+	if (queue == NULL || i < 0 || i >= queue->size) {
+		return -1;
+	}
+	return queue->indices[i];
+}
+
+/**
+ * @return -1.0 if queue is NULL or i is out of range, otherwise the value of
+ * the i-th lowest priority element (starting from 0).
+ */
+static inline double spSmallBPQueueValueAt(const SPSmallBPQueue* queue, int i) {
+	if (queue == NULL || i < 0 || i >= queue->size) {
+		return -1.0;
+	}
+	return spSmallBPQueueValueOf(queue->keys[i]);
+}
+
+/**
+ * @assert queue!=NULL.
+ * @return True if the queue is empty, false otherwise.
+ */
+static inline bool spSmallBPQueueIsEmpty(const SPSmallBPQueue* queue) {
+	assert(queue != NULL);
+	return queue->size == 0;
+}
+
+/**
+ * @assert queue!=NULL.
+ * @return True if the queue is full, false otherwise.
+ */
+static inline bool spSmallBPQueueIsFull(const SPSmallBPQueue* queue) {
+	assert(queue != NULL);
+	return queue->size == queue->maxSize;
+}
+
+#endif
@@ -0,0 +1,179 @@
+#include "SPTopKSelect.h"
+#include <stdlib.h> // malloc, free, NULL
+#include <math.h> // HUGE_VAL
+
+#define SP_TOPK_INSERTION_THRESHOLD 16 // Ranges at most this long are sorted directly
+
+typedef struct sp_topk_entry_t {
+	double value;
+	int index;
+} SPTopKEntry;
+
+// Helper functions
+static int entryLess(const SPTopKEntry* e1, const SPTopKEntry* e2) {
+	return (e1->value < e2->value) | ((e1->value == e2->value) & (e1->index < e2->index));
+}
+
+static void entrySwap(SPTopKEntry* entries, int i, int j) {
+	SPTopKEntry temp = entries[i];
+	entries[i] = entries[j];
+	entries[j] = temp;
+}
+
+static void insertionSort(SPTopKEntry* entries, int left, int right) {
+	SPTopKEntry temp;
+	int i, j;
+	for (i = left + 1; i <= right; i++) {
+		temp = entries[i];
+		for (j = i; j > left && entryLess(&temp, &entries[j-1]); j--) {
+			entries[j] = entries[j-1];
+		}
+		entries[j] = temp;
+	}
+}
+
+// Restores a max-heap rooted at root, for entries[base..base+size)
+static void siftDown(SPTopKEntry* entries, int base, int size, int root) {
+	int child;
+	while ((child = 2 * root + 1) < size) {
+		if (child + 1 < size && entryLess(&entries[base+child], &entries[base+child+1])) {
+			child++;
+		}
+		if (!entryLess(&entries[base+root], &entries[base+child])) {
+			return;
+		}
+		entrySwap(entries, base + root, base + child);
+		root = child;
+	}
+}
+
+// Moves the k lowest entries of entries[left..right] to entries[left..left+k)
+static void heapSelect(SPTopKEntry* entries, int left, int right, int k) {
+	int i;
+	for (i = k / 2 - 1; i >= 0; i--) {
+		siftDown(entries, left, k, i);
+	}
+	for (i = left + k; i <= right; i++) {
+		if (entryLess(&entries[i], &entries[left])) {
+			entrySwap(entries, i, left);
+			siftDown(entries, left, k, 0);
+		}
+	}
+}
+
+static void heapSort(SPTopKEntry* entries, int size) {
+	int i;
+	for (i = size / 2 - 1; i >= 0; i--) {
+		siftDown(entries, 0, size, i);
+	}
+	for (i = size - 1; i > 0; i--) {
+		entrySwap(entries, 0, i);
+		siftDown(entries, 0, i, 0);
+	}
+}
+
+// Partitions entries[left..right] around a median of three, returns the pivot position
+static int partition(SPTopKEntry* entries, int left, int right) {
+	int middle = left + (right - left) / 2;
+	int i, store;
+	if (entryLess(&entries[middle], &entries[left])) {
+		entrySwap(entries, middle, left);
+	}
+	if (entryLess(&entries[right], &entries[left])) {
+		entrySwap(entries, right, left);
+	}
+	if (entryLess(&entries[right], &entries[middle])) {
+		entrySwap(entries, right, middle);
+	}
+	entrySwap(entries, middle, right); // The median is the pivot
+	store = left;
+	for (i = left; i < right; i++) {
+		if (entryLess(&entries[i], &entries[right])) {
+			entrySwap(entries, i, store);
+			store++;
+		}
+	}
+	entrySwap(entries, store, right);
+	return store;
+}
+
+// Moves the k lowest entries of entries[0..n) to entries[0..k), in any order
+static void introSelect(SPTopKEntry* entries, int n, int k) {
+	int left = 0, right = n - 1;
+	int depthLimit = 0;
+	int pivot, size;
+	for (size = n; size > 0; size >>= 1) {
+		depthLimit += 2;
+	}
+	while (right - left + 1 > SP_TOPK_INSERTION_THRESHOLD) {
+		if (depthLimit-- == 0) { // Bad pivots, guarantee O(n log k)
+			heapSelect(entries, left, right, k - left);
+			return;
+		}
+		pivot = partition(entries, left, right);
+		if (pivot == k - 1 || pivot == k) {
+			return;
+		} else if (pivot < k) {
+			left = pivot + 1;
+		} else {
+			right = pivot - 1;
+		}
+	}
+	insertionSort(entries, left, right);
+}
+
+static int topKSelect(const double* values, const int* indices, int n, int k,
+		double threshold, int* outIdx, double* outVal) {
+	// Function variables
+	SPTopKEntry* entries;
+	int count = 0;
+	int i, j; // Generic loop variables
+	// Function code
+	if (values == NULL || outIdx == NULL || outVal == NULL || n < 0 || k < 0) {
+		return -1; // Invalid parameters
+	}
+	if (threshold == HUGE_VAL) { // spTopKSelect, every candidate passes
+		count = n;
+	} else {
+		for (i = 0; i < n; i++) { // Counting pass, a reduction over values only, so it vectorizes
+			count += values[i] <= threshold;
+		}
+	}
+	if (count == 0 || k == 0) {
+		return 0;
+	}
+	entries = (SPTopKEntry*) malloc(sizeof(SPTopKEntry)*count);
+	if (entries == NULL) { // Allocation Fails
+		return -1;
+	}
+	for (i = 0, j = 0; j < count; i++) { // Compaction, only the count candidates are written
+		if (threshold == HUGE_VAL || values[i] <= threshold) {
+			entries[j].value = values[i];
+			entries[j].index = indices == NULL ? i : indices[i];
+			j++;
+		}
+	}
+	if (k > count) {
+		k = count;
+	}
+	if (k > 0 && k < count) {
+		introSelect(entries, count, k);
+	}
+	heapSort(entries, k);
+	for (i = 0; i < k; i++) {
+		outIdx[i] = entries[i].index;
+		outVal[i] = entries[i].value;
+	}
+	free(entries);
+	return k;
+}
+
+int spTopKSelect(const double* values, const int* indices, int n, int k,
+		int* outIdx, double* outVal) {
+	return topKSelect(values, indices, n, k, HUGE_VAL, outIdx, outVal);
+}
+
+int spTopKSelectBelow(const double* values, const int* indices, int n, int k,
+		double threshold, int* outIdx, double* outVal) {
+	return topKSelect(values, indices, n, k, threshold, outIdx, outVal);
+}
@@ -0,0 +1,61 @@
+#ifndef SPTOPKSELECT_H_
+#define SPTOPKSELECT_H_
+/**
+ * SP Top K Select summary
+ *
+ * Selects the k lowest priority (value, index) pairs out of a buffer of n
+ * values, using the SPListElement ordering:
+ *
+ * Element e1 is lower priority than element e2 iff:
+ * 		(e1.value < e2.value)   OR (e1.value == e2.value AND e1.index < e2.index)
+ *
+ * This is meant for brute force scans which compute all the distances first.
+ * Selection is done by introselect (quickselect with a median of three pivot,
+ * falling back to heap selection if the recursion gets too deep), which is
+ * expected O(n). Only the k selected pairs are sorted afterwards.
+ *
+ * The output is sorted in ascending order, so it can be loaded into a queue
+ * using spBPQueueEnqueueSorted (see SPBPriorityQueue.h).
+ *
+ * The following functions are available:
+ *
+ *   spTopKSelect          - Selects the k lowest priority pairs
+ *   spTopKSelectBelow     - Same as spTopKSelect, but only considers values
+ *                           which are less than or equal to a threshold
+ */
+
+/**
+ * Selects the k lowest priority (value, index) pairs and returns them in
+ * ascending order. The input buffers are not modified.
+ *
+ * @param values  - The values of the candidates (values[i] >= 0.0).
+ * @param indices - The indices of the candidates. If NULL, the index of
+ *                  values[i] is i.
+ * @param n       - The number of candidates.
+ * @param k       - The number of pairs to select.
+ * @param outIdx  - An array of at least k ints which receives the indices.
+ * @param outVal  - An array of at least k doubles which receives the values.
+ * @return
+ * -1 if values, outIdx or outVal are NULL, n < 0, k < 0 or allocation failed.
+ * Otherwise the number of selected pairs, which is min(n, k).
+ */
+int spTopKSelect(const double* values, const int* indices, int n, int k,
+		int* outIdx, double* outVal);
+
+/**
+ * Same as spTopKSelect, but candidates whose value is greater than threshold
+ * are filtered out first. A first pass only counts the candidates which pass
+ * the threshold, in a loop which compilers vectorize on targets with vector
+ * double comparisons (gcc -O3 with AVX2 or AVX-512), and only these candidates
+ * are then copied and selected. A good threshold (for example the current bound
+ * of a bounded queue) therefore avoids most of the copying and selection work.
+ *
+ * @param threshold - Candidates with values[i] > threshold are ignored.
+ * @return
+ * -1 if values, outIdx or outVal are NULL, n < 0, k < 0 or allocation failed.
+ * Otherwise the number of selected pairs, which is at most min(n, k).
+ */
+int spTopKSelectBelow(const double* values, const int* indices, int n, int k,
+		double threshold, int* outIdx, double* outVal);
+
+#endif /* SPTOPKSELECT_H_ */
@@ -0,0 +1,35 @@
+#ifndef BENCH_UTIL_H_
+#define BENCH_UTIL_H_
+
+#include <time.h>
+#include <stdint.h>
+
+/**
+ * Returns a monotonic time stamp in seconds.
+ * Requires _POSIX_C_SOURCE >= 199309L to be defined before any include.
+ */
+static inline double benchNow(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * A small deterministic pseudo random generator (xorshift64), so benchmark
+ * inputs are identical between runs and between implementations.
+ */
+static inline uint64_t benchRandom(uint64_t* state) {
+	uint64_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+	return x;
+}
+
+/** Returns a pseudo random double in [0, 1) */
+static inline double benchRandomDouble(uint64_t* state) {
+	return (double) (benchRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif /* BENCH_UTIL_H_ */
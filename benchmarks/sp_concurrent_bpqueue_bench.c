@@ -0,0 +1,74 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../SPConcurrentBPQueue.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#define TOTAL_CANDIDATES 8000000
+#define QUEUE_MAX_SIZE 16
+#define STAGE_CAPACITY 64
+#define MAX_THREADS 64
+
+typedef struct worker_args_t {
+	SPConcurrentBPQueue queue;
+	int first; // First candidate index of the worker
+	int count; // Number of candidates offered by the worker
+	int useStage;
+} WorkerArgs;
+
+static void* worker(void* arg) {
+	WorkerArgs* args = (WorkerArgs*) arg;
+	SPConcurrentBPQueueStage stage = NULL;
+	uint64_t state = 88172645463325252ULL + (uint64_t) args->first;
+	int i; // Generic loop variable
+	if (args->useStage) {
+		stage = spConcurrentBPQueueStageCreate(args->queue, STAGE_CAPACITY);
+	}
+	for (i = args->first; i < args->first + args->count; i++) {
+		double value = benchRandomDouble(&state);
+		if (stage != NULL) {
+			spConcurrentBPQueueStageOffer(stage, i, value);
+		} else {
+			spConcurrentBPQueueOffer(args->queue, i, value);
+		}
+	}
+	spConcurrentBPQueueStageDestroy(stage);
+	return NULL;
+}
+
+static double run(int threadsNum, int useStage) {
+	pthread_t threads[MAX_THREADS];
+	WorkerArgs args[MAX_THREADS];
+	SPConcurrentBPQueue queue = spConcurrentBPQueueCreate(QUEUE_MAX_SIZE);
+	int perThread = TOTAL_CANDIDATES / threadsNum;
+	double start, end;
+	int i; // Generic loop variable
+	start = benchNow();
+	for (i = 0; i < threadsNum; i++) {
+		args[i].queue = queue;
+		args[i].first = i * perThread;
+		args[i].count = perThread;
+		args[i].useStage = useStage;
+		pthread_create(&threads[i], NULL, worker, &args[i]);
+	}
+	for (i = 0; i < threadsNum; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	end = benchNow();
+	spConcurrentBPQueueDestroy(queue);
+	return (double) perThread * threadsNum / (end - start) / 1e6;
+}
+
+int main() {
+	int threadsNum;
+	printf("Concurrent SPBPQueue scaling, %d candidates, k=%d\n", TOTAL_CANDIDATES, QUEUE_MAX_SIZE);
+	printf("%8s %16s %16s\n", "threads", "offer Mops/s", "staged Mops/s");
+	for (threadsNum = 1; threadsNum <= MAX_THREADS; threadsNum *= 2) {
+		double direct = run(threadsNum, 0);
+		double staged = run(threadsNum, 1);
+		printf("%8d %16.2f %16.2f\n", threadsNum, direct, staged);
+		fflush(stdout);
+	}
+	return 0;
+}
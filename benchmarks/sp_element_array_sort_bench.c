@@ -0,0 +1,70 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../SPElementArray.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ELEMENTS_NUM 4000000
+
+// Same relation as spListElementCompare
+static int elementCompare(const void* p1, const void* p2) {
+	const SPElement* e1 = (const SPElement*) p1;
+	const SPElement* e2 = (const SPElement*) p2;
+	if (e1->value != e2->value) {
+		return e1->value < e2->value ? -1 : 1;
+	}
+	return (e1->index > e2->index) - (e1->index < e2->index);
+}
+
+// Returns the throughput of one sort in millions of elements per second, 0 for a wrong order
+static double run(SPElementArray input, int threads) {
+	SPElementArray array = spElementArrayCopy(input);
+	SPElement* data = spElementArrayGetData(array);
+	double start, end;
+	int i; // Generic loop variable
+	start = benchNow();
+	if (threads == 0) {
+		qsort(data, ELEMENTS_NUM, sizeof(SPElement), elementCompare);
+	} else if (threads == 1) {
+		spElementArraySort(array);
+	} else {
+		spElementArraySortParallel(array, threads);
+	}
+	end = benchNow();
+	for (i = 1; i < ELEMENTS_NUM; i++) {
+		if (elementCompare(&data[i-1], &data[i]) > 0) {
+			spElementArrayDestroy(array);
+			return 0.0;
+		}
+	}
+	spElementArrayDestroy(array);
+	return ELEMENTS_NUM / (end - start) / 1e6;
+}
+
+int main() {
+	static const int threads[] = {2, 4, 8};
+	uint64_t state = 88172645463325252ULL;
+	SPElementArray distances = spElementArrayCreate(ELEMENTS_NUM);
+	SPElementArray ties = spElementArrayCreate(ELEMENTS_NUM);
+	SPElement element;
+	unsigned int i; // Generic loop variable
+	for (i = 0; i < ELEMENTS_NUM; i++) {
+		element.index = (int) i;
+		element.value = benchRandomDouble(&state) * 1000.0;
+		spElementArrayAppend(distances, element);
+		element.index = (int) (benchRandom(&state) % ELEMENTS_NUM);
+		element.value = (double) (benchRandom(&state) % 256); // Integer distances
+		spElementArrayAppend(ties, element);
+	}
+	printf("Sorting %d elements (M elements/s)\n", ELEMENTS_NUM);
+	printf("%-16s %12s %12s\n", "sort", "distances", "ties");
+	printf("%-16s %12.2f %12.2f\n", "qsort", run(distances, 0), run(ties, 0));
+	printf("%-16s %12.2f %12.2f\n", "radix", run(distances, 1), run(ties, 1));
+	for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+		printf("radix %2d threads %12.2f %12.2f\n", threads[i],
+				run(distances, threads[i]), run(ties, threads[i]));
+	}
+	spElementArrayDestroy(distances);
+	spElementArrayDestroy(ties);
+	return 0;
+}
@@ -0,0 +1,128 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../SPList.h"
+#include "../SPListElement.h"
+#include "../SPBPriorityQueue.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LIST_SIZE 1000000
+#define TRAVERSALS 20
+#define QUEUE_MAX_SIZE 256
+#define QUEUE_CANDIDATES 200000
+#define QUEUE_COPIES 20000
+
+// Builds a list in random insertion order, so consecutive elements are not adjacent in memory.
+// A vector list is built by appending, which is the workload it is meant for.
+static SPList buildList(int size, SP_LIST_BACKEND backend) {
+	SPList list = spListCreateWithBackend(backend);
+	SPListElement element = spListElementCreate(0, 0.0);
+	uint64_t state = 88172645463325252ULL;
+	int i; // Generic loop variable
+	for (i = 0; i < size; i++) {
+		spListElementSetIndex(element, i);
+		spListElementSetValue(element, benchRandomDouble(&state));
+		if (backend != SP_LIST_VECTOR_BACKEND && spListGetFirst(list) != NULL
+				&& (benchRandom(&state) & 1)) {
+			spListInsertAfterCurrent(list, element);
+		} else {
+			spListInsertLast(list, element);
+		}
+	}
+	spListElementDestroy(element);
+	return list;
+}
+
+static double traverse(SPList list, double* checksum) {
+	double start, end, sum = 0.0;
+	int i; // Generic loop variable
+	start = benchNow();
+	for (i = 0; i < TRAVERSALS; i++) {
+		SP_LIST_FOREACH(SPListElement, e, list) {
+			sum += spListElementGetValue(e);
+		}
+	}
+	end = benchNow();
+	*checksum = sum;
+	return (end - start) * 1e9 / ((double) TRAVERSALS * spListGetSize(list));
+}
+
+// Measures spBPQueueCopy of a full list backed queue, returns ns per copy
+static double queueCopy(double* checksum) {
+	SPBPQueue queue = spBPQueueCreate(QUEUE_MAX_SIZE);
+	SPBPQueue copy;
+	SPListElement element = spListElementCreate(0, 0.0);
+	uint64_t state = 88172645463325252ULL;
+	double start, end, sum = 0.0;
+	int i; // Generic loop variable
+	for (i = 0; i < QUEUE_MAX_SIZE; i++) {
+		spListElementSetIndex(element, i);
+		spListElementSetValue(element, benchRandomDouble(&state));
+		spBPQueueEnqueue(queue, element);
+	}
+	start = benchNow();
+	for (i = 0; i < QUEUE_COPIES; i++) {
+		copy = spBPQueueCopy(queue);
+		sum += spBPQueueMaxValue(copy);
+		spBPQueueDestroy(copy);
+	}
+	end = benchNow();
+	*checksum = sum;
+	spListElementDestroy(element);
+	spBPQueueDestroy(queue);
+	return (end - start) * 1e9 / QUEUE_COPIES;
+}
+
+static double enqueue(double* checksum) {
+	SPBPQueue queue = spBPQueueCreate(QUEUE_MAX_SIZE);
+	SPListElement element = spListElementCreate(0, 0.0);
+	uint64_t state = 88172645463325252ULL;
+	double start, end;
+	int i; // Generic loop variable
+	start = benchNow();
+	for (i = 0; i < QUEUE_CANDIDATES; i++) {
+		spListElementSetIndex(element, i);
+		spListElementSetValue(element, benchRandomDouble(&state));
+		spBPQueueEnqueue(queue, element);
+	}
+	end = benchNow();
+	*checksum = spBPQueueMaxValue(queue);
+	spListElementDestroy(element);
+	spBPQueueDestroy(queue);
+	return (end - start) * 1e9 / QUEUE_CANDIDATES;
+}
+
+static void run(const char* name, SP_LIST_BACKEND backend) {
+	SPList list, copy;
+	double copyStart, copyEnd, sortStart, sortEnd, traversal, checksum;
+	list = buildList(LIST_SIZE, backend);
+	traversal = traverse(list, &checksum);
+	copyStart = benchNow();
+	copy = spListCopy(list);
+	copyEnd = benchNow();
+	sortStart = benchNow();
+	spListSort(copy, NULL);
+	sortEnd = benchNow();
+	printf("%s\n", name);
+	printf("  %-30s %10.2f ns/element\n", "SP_LIST_FOREACH", traversal);
+	printf("  %-30s %10.2f ns/element\n", "spListCopy", (copyEnd - copyStart) * 1e9 / LIST_SIZE);
+	printf("  %-30s %10.2f ns/element\n", "spListSort", (sortEnd - sortStart) * 1e9 / LIST_SIZE);
+	printf("  checksum %f\n", checksum);
+	spListDestroy(copy);
+	spListDestroy(list);
+}
+
+int main() {
+	double queueCost, checksum;
+	printf("SPList traversal, %d elements\n", LIST_SIZE);
+	run("SP_LIST_LINKED_BACKEND", SP_LIST_LINKED_BACKEND);
+	run("SP_LIST_UNROLLED_BACKEND", SP_LIST_UNROLLED_BACKEND);
+	run("SP_LIST_VECTOR_BACKEND", SP_LIST_VECTOR_BACKEND);
+	queueCost = enqueue(&checksum);
+	printf("%-32s %10.2f ns/candidate\n", "spBPQueueEnqueue (list, k=256)", queueCost);
+	printf("checksum %f\n", checksum);
+	queueCost = queueCopy(&checksum);
+	printf("%-32s %10.2f ns/copy\n", "spBPQueueCopy (list, k=256)", queueCost);
+	printf("checksum %f\n", checksum);
+	return 0;
+}
@@ -0,0 +1,118 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../SPLogger.h"
+#include "bench_util.h"
+#include <stdio.h>
+
+#define MESSAGES_NUM 200000
+#define BENCH_LOG_FILE "sp_logger_bench.log"
+
+// Returns the mean time in nanoseconds of a debug print call, on the caller's thread
+static double run(const SPLoggerOptions* options, long long* dropped) {
+	double start, end;
+	int i; // Generic loop variable
+	if (spLoggerCreateWithOptions(BENCH_LOG_FILE, SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,
+			options) != SP_LOGGER_SUCCESS) {
+		return 0.0;
+	}
+	start = benchNow();
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		spLoggerPrintDebug("candidate rejected", "sp_logger_bench.c", __func__, __LINE__);
+	}
+	end = benchNow();
+	*dropped = spLoggerGetDroppedCount();
+	spLoggerDestroy();
+	return (end - start) / MESSAGES_NUM * 1e9;
+}
+
+// Returns the mean time in nanoseconds of a formatted debug message, on the caller's thread
+static double runMacro(const SPLoggerOptions* options) {
+	double start, end;
+	int i; // Generic loop variable
+	if (spLoggerCreateWithOptions(BENCH_LOG_FILE, SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,
+			options) != SP_LOGGER_SUCCESS) {
+		return 0.0;
+	}
+	start = benchNow();
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		SP_LOG_DEBUG("candidate %d rejected at distance %f", i, i * 0.25);
+	}
+	end = benchNow();
+	spLoggerDestroy();
+	return (end - start) / MESSAGES_NUM * 1e9;
+}
+
+// Returns the mean time in nanoseconds of a debug print call filtered out by an error level logger
+static double runFiltered(bool macro) {
+	double start, end;
+	int i; // Generic loop variable
+	if (spLoggerCreate(BENCH_LOG_FILE, SP_LOGGER_ERROR_LEVEL) != SP_LOGGER_SUCCESS) {
+		return 0.0;
+	}
+	start = benchNow();
+	if (macro) {
+		for (i = 0; i < MESSAGES_NUM; i++) {
+			SP_LOG_DEBUG("candidate %d rejected", i);
+		}
+	} else {
+		for (i = 0; i < MESSAGES_NUM; i++) {
+			spLoggerPrintDebug("candidate rejected", "sp_logger_bench.c", __func__, __LINE__);
+		}
+	}
+	end = benchNow();
+	spLoggerDestroy();
+	return (end - start) / MESSAGES_NUM * 1e9;
+}
+
+// Returns the mean time in nanoseconds of a sampled or rate limited debug message, most of which are suppressed
+static double runLimited(bool rate) {
+	double start, end;
+	int i; // Generic loop variable
+	if (spLoggerCreate(BENCH_LOG_FILE, SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) != SP_LOGGER_SUCCESS) {
+		return 0.0;
+	}
+	start = benchNow();
+	if (rate) {
+		for (i = 0; i < MESSAGES_NUM; i++) {
+			SP_LOG_RATE_LIMITED(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, 100.0, 10,
+					"candidate %d rejected", i);
+		}
+	} else {
+		for (i = 0; i < MESSAGES_NUM; i++) {
+			SP_LOG_EVERY_N(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, 1000, "candidate %d rejected", i);
+		}
+	}
+	end = benchNow();
+	spLoggerDestroy();
+	return (end - start) / MESSAGES_NUM * 1e9;
+}
+
+int main() {
+	SPLoggerOptions sync = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	SPLoggerOptions block = {true, 4096, 256, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	SPLoggerOptions drop = {true, 4096, 256, SP_LOGGER_OVERFLOW_DROP, false, 0, 0, 0};
+	SPLoggerOptions binary = {true, 4096, 256, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	SPLoggerOptions staged = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 65536, 0, 0};
+	SPLoggerOptions segments = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 1 << 22, 2};
+	long long dropped;
+	double ns;
+	printf("%d debug messages to a file (ns/call on the caller's thread)\n", MESSAGES_NUM);
+	ns = run(&sync, &dropped);
+	printf("%-16s %10.1f\n", "sync", ns);
+	ns = run(&staged, &dropped);
+	printf("%-16s %10.1f\n", "sync staged", ns);
+	ns = run(&segments, &dropped);
+	printf("%-16s %10.1f\n", "sync segments", ns);
+	ns = run(&block, &dropped);
+	printf("%-16s %10.1f\n", "async block", ns);
+	ns = run(&drop, &dropped);
+	printf("%-16s %10.1f   (%lld dropped)\n", "async drop", ns, dropped);
+	printf("%-16s %10.1f\n", "macro async", runMacro(&block));
+	printf("%-16s %10.1f\n", "macro binary", runMacro(&binary));
+	printf("%-16s %10.1f\n", "filtered call", runFiltered(false));
+	printf("%-16s %10.1f\n", "filtered macro", runFiltered(true));
+	printf("%-16s %10.1f\n", "sampled 1/1000", runLimited(false));
+	printf("%-16s %10.1f\n", "rate limited", runLimited(true));
+	remove(BENCH_LOG_FILE);
+	remove(BENCH_LOG_FILE ".1");
+	return 0;
+}
@@ -0,0 +1,68 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../SPSmallBPQueue.h"
+#include "../SPBPriorityQueue.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CANDIDATES_NUM 2000000
+
+static double values[CANDIDATES_NUM];
+
+static double runSmall(int k, double* checksum) {
+	SPSmallBPQueue queue;
+	double start, end;
+	int i; // Generic loop variable
+	if (spSmallBPQueueInit(&queue, k) != SP_BPQUEUE_SUCCESS) {
+		return 0.0;
+	}
+	start = benchNow();
+	for (i = 0; i < CANDIDATES_NUM; i++) {
+		spSmallBPQueueOffer(&queue, i, values[i]);
+	}
+	end = benchNow();
+	*checksum = spSmallBPQueueMaxValue(&queue);
+	return CANDIDATES_NUM / (end - start) / 1e6;
+}
+
+static double runQueue(int k, SP_BPQUEUE_BACKEND backend, double* checksum) {
+	SPBPQueue queue = spBPQueueCreateWithBackend(k, backend);
+	SPListElement element = spListElementCreate(0, 0.0);
+	double start, end;
+	int i; // Generic loop variable
+	start = benchNow();
+	for (i = 0; i < CANDIDATES_NUM; i++) {
+		spListElementSetIndex(element, i);
+		spListElementSetValue(element, values[i]);
+		spBPQueueEnqueue(queue, element);
+	}
+	end = benchNow();
+	*checksum = spBPQueueMaxValue(queue);
+	spListElementDestroy(element);
+	spBPQueueDestroy(queue);
+	return CANDIDATES_NUM / (end - start) / 1e6;
+}
+
+int main() {
+	static const int sizes[] = {1, 2, 4, 8, 16, 32};
+	uint64_t state = 88172645463325252ULL;
+	double small, list, heap, skipList, c1, c2, c3, c4;
+	unsigned int i; // Generic loop variable
+	for (i = 0; i < CANDIDATES_NUM; i++) {
+		values[i] = benchRandomDouble(&state);
+	}
+	printf("Small-k bounded queue, %d random candidates (Mops/s)\n", CANDIDATES_NUM);
+	printf("%4s %12s %12s %12s %12s\n", "k", "small", "list", "heap", "skiplist");
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		small = runSmall(sizes[i], &c1);
+		list = runQueue(sizes[i], SP_BPQUEUE_LIST_BACKEND, &c2);
+		heap = runQueue(sizes[i], SP_BPQUEUE_HEAP_BACKEND, &c3);
+		skipList = runQueue(sizes[i], SP_BPQUEUE_SKIPLIST_BACKEND, &c4);
+		if (c1 != c2 || c1 != c3 || c1 != c4) {
+			fprintf(stderr, "k=%d: results differ\n", sizes[i]);
+			return 1;
+		}
+		printf("%4d %12.2f %12.2f %12.2f %12.2f\n", sizes[i], small, list, heap, skipList);
+	}
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include "../SPLoggerBinary.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * splog-decode - prints the text of a binary SP Logger log.
+ *
+ * Usage: splog-decode [-t] <binary log> [<output file>]
+ *
+ * The text is written to the output file, or to stdout if none is given. With
+ * -t every message is preceded by a line holding its timestamp.
+ */
+int main(int argc, char* argv[]) {
+	// Function variables
+	FILE* input;
+	FILE* output = stdout;
+	bool timestamps = false;
+	int first = 1;
+	SP_LOGGER_MSG status;
+	// Function code
+	if (argc > 1 && strcmp(argv[1], "-t") == 0) {
+		timestamps = true;
+		first = 2;
+	}
+	if (argc - first < 1 || argc - first > 2) {
+		fprintf(stderr, "Usage: %s [-t] <binary log> [<output file>]\n", argv[0]);
+		return 2;
+	}
+	input = fopen(argv[first], "rb");
+	if (input == NULL) {
+		fprintf(stderr, "Cannot open %s\n", argv[first]);
+		return 1;
+	}
+	if (argc - first == 2) {
+		output = fopen(argv[first + 1], "w");
+		if (output == NULL) {
+			fprintf(stderr, "Cannot open %s\n", argv[first + 1]);
+			fclose(input);
+			return 1;
+		}
+	}
+	status = spLoggerBinaryDecode(input, output, timestamps);
+	fclose(input);
+	if (output != stdout && fclose(output) != 0 && status == SP_LOGGER_SUCCESS) {
+		status = SP_LOGGER_WRITE_FAIL;
+	}
+	if (status == SP_LOGGER_INVAlID_ARGUMENT) {
+		fprintf(stderr, "%s is not a valid binary log\n", argv[first]);
+	} else if (status == SP_LOGGER_OUT_OF_MEMORY) {
+		fprintf(stderr, "Out of memory\n");
+	} else if (status == SP_LOGGER_WRITE_FAIL) {
+		fprintf(stderr, "Cannot write the output\n");
+	}
+	return status == SP_LOGGER_SUCCESS ? 0 : 1;
+}
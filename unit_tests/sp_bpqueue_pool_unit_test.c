@@ -0,0 +1,100 @@
+#include "../SPBPQueuePool.h"
+#include "../SPBPriorityQueue.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <pthread.h>
+
+bool poolAcquireTest(){
+	// SPBPQueue variables
+	SPBPQueue q1 = spBPQueueAcquire(2, SP_BPQUEUE_LIST_BACKEND);
+	SPBPQueue q2 = spBPQueueAcquire(-1, SP_BPQUEUE_LIST_BACKEND);
+	SPBPQueue q3 = spBPQueueAcquire(3, SP_BPQUEUE_HEAP_BACKEND);
+	// Assertions
+	ASSERT_TRUE(q1 != NULL);
+	ASSERT_TRUE(q2 == NULL);
+	ASSERT_TRUE(q3 != NULL);
+	ASSERT_TRUE(spBPQueueGetMaxSize(q1) == 2);
+	ASSERT_TRUE(spBPQueueGetBackend(q3) == SP_BPQUEUE_HEAP_BACKEND);
+	ASSERT_TRUE(spBPQueuePoolSize() == 0);
+	// Deallocation
+	spBPQueueRelease(q1);
+	spBPQueueRelease(q2);
+	spBPQueueRelease(q3);
+	ASSERT_TRUE(spBPQueuePoolSize() == 2);
+	spBPQueuePoolDrain();
+	ASSERT_TRUE(spBPQueuePoolSize() == 0);
+	return true;
+}
+
+bool poolReuseTest(){
+	// SPBPQueue variables
+	SPBPQueue q1 = spBPQueueAcquire(2, SP_BPQUEUE_HEAP_BACKEND);
+	SPBPQueue q2;
+	SPBPQueue q3;
+	SPListElement e1 = spListElementCreate(1,1);
+	// Assertions
+	spBPQueueEnqueue(q1,e1);
+	spBPQueueRelease(q1);
+	q2 = spBPQueueAcquire(5, SP_BPQUEUE_LIST_BACKEND); // Different backend, new queue
+	ASSERT_TRUE(q2 != q1);
+	q3 = spBPQueueAcquire(5, SP_BPQUEUE_HEAP_BACKEND);
+	ASSERT_TRUE(q3 == q1); // Reused
+	ASSERT_TRUE(spBPQueueIsEmpty(q3));
+	ASSERT_TRUE(spBPQueueGetMaxSize(q3) == 5);
+	ASSERT_TRUE(spBPQueuePoolSize() == 0);
+	// Deallocation
+	spBPQueueRelease(q2);
+	spBPQueueRelease(q3);
+	spBPQueuePoolDrain();
+	spListElementDestroy(e1);
+	return true;
+}
+
+bool poolCapacityTest(){
+	// Function variables
+	SPBPQueue queues[SP_BPQUEUE_POOL_CAPACITY + 1];
+	int i; // Generic loop variable
+	// Assertions
+	for (i = 0; i <= SP_BPQUEUE_POOL_CAPACITY; i++) {
+		queues[i] = spBPQueueAcquire(1, SP_BPQUEUE_LIST_BACKEND);
+		ASSERT_TRUE(queues[i] != NULL);
+	}
+	for (i = 0; i <= SP_BPQUEUE_POOL_CAPACITY; i++) {
+		spBPQueueRelease(queues[i]); // The last one is destroyed
+	}
+	ASSERT_TRUE(spBPQueuePoolSize() == SP_BPQUEUE_POOL_CAPACITY);
+	// Deallocation
+	spBPQueuePoolDrain();
+	return true;
+}
+
+static void* poolThread(void* arg) {
+	int i; // Generic loop variable
+	(void) arg;
+	for (i = 0; i < 4; i++) {
+		spBPQueueRelease(spBPQueueAcquire(i + 1, i % 2 == 0 ? SP_BPQUEUE_LIST_BACKEND
+				: SP_BPQUEUE_HEAP_BACKEND));
+	}
+	spBPQueueRelease(spBPQueueAcquire(1, SP_BPQUEUE_HEAP_BACKEND));
+	return (void*) (long) spBPQueuePoolSize(); // Exits without draining
+}
+
+bool poolThreadExitTest(){
+	// Function variables
+	pthread_t thread;
+	void* size;
+	// Assertions, the queues of the exited thread are freed (checked by leak sanitizers)
+	ASSERT_TRUE(pthread_create(&thread, NULL, poolThread, NULL) == 0);
+	ASSERT_TRUE(pthread_join(thread, &size) == 0);
+	ASSERT_TRUE((long) size > 0);
+	ASSERT_TRUE(spBPQueuePoolSize() == 0); // Each thread has its own pool
+	return true;
+}
+
+int main() {
+	RUN_TEST(poolAcquireTest);
+	RUN_TEST(poolReuseTest);
+	RUN_TEST(poolCapacityTest);
+	RUN_TEST(poolThreadExitTest);
+	return 0;
+}
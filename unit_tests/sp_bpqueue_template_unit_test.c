@@ -0,0 +1,124 @@
+#include "../SPBPQueueTemplate.h"
+#include "../SPBPriorityQueue.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// A key with the SPBPQueue ordering, to compare against it
+typedef struct element_key_t {
+	double value;
+	int index;
+} ElementKey;
+
+static int compareElementKeys(ElementKey k1, ElementKey k2) {
+	int valueCompare = SP_BPQUEUE_COMPARE_NUMBERS(k1.value, k2.value);
+	return valueCompare != 0 ? valueCompare : SP_BPQUEUE_COMPARE_NUMBERS(k1.index, k2.index);
+}
+
+SP_DEFINE_BPQUEUE(FloatIdQueue, float, uint64_t, SP_BPQUEUE_COMPARE_NUMBERS)
+SP_DEFINE_BPQUEUE(HammingQueue, uint32_t, uint64_t, SP_BPQUEUE_COMPARE_NUMBERS)
+SP_DEFINE_BPQUEUE(ElementQueue, ElementKey, int, compareElementKeys)
+
+bool templateQueueInitTest(){
+	// Queue variables
+	FloatIdQueue q1;
+	// Assertions
+	ASSERT_TRUE(FloatIdQueueInit(NULL, 2) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(FloatIdQueueInit(&q1, -1) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(FloatIdQueueInit(&q1, 0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(FloatIdQueueIsEmpty(&q1));
+	ASSERT_TRUE(FloatIdQueueIsFull(&q1));
+	ASSERT_TRUE(FloatIdQueueEnqueue(&q1, 1.0f, 1) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(FloatIdQueueSize(&q1) == 0);
+	ASSERT_TRUE(FloatIdQueueSize(NULL) == -1);
+	ASSERT_TRUE(FloatIdQueueGetMaxSize(&q1) == 0);
+	ASSERT_TRUE(!FloatIdQueuePeek(&q1, NULL, NULL));
+	ASSERT_TRUE(!FloatIdQueuePeekLast(&q1, NULL, NULL));
+	ASSERT_TRUE(FloatIdQueueDequeue(&q1) == SP_BPQUEUE_EMPTY);
+	ASSERT_TRUE(FloatIdQueueDequeue(NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	// Deallocation
+	FloatIdQueueDestroy(&q1);
+	return true;
+}
+
+bool templateQueueEnqueueTest(){
+	// Function variables
+	uint32_t key;
+	uint64_t id;
+	// Queue variables
+	HammingQueue q1;
+	HammingQueueInit(&q1, 3);
+	// Assertions
+	ASSERT_TRUE(HammingQueueEnqueue(&q1, 7, 70) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(HammingQueueEnqueue(&q1, 3, 30) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(HammingQueueEnqueue(&q1, 3, 31) == SP_BPQUEUE_SUCCESS); // Tie, after (3,30)
+	ASSERT_TRUE(HammingQueueIsFull(&q1));
+	ASSERT_TRUE(HammingQueueEnqueue(&q1, 7, 71) == SP_BPQUEUE_FULL); // Equal to the highest, rejected
+	ASSERT_TRUE(HammingQueuePeekLast(&q1, &key, &id) && key == 7 && id == 70);
+	ASSERT_TRUE(HammingQueueEnqueue(&q1, 1, 10) == SP_BPQUEUE_FULL); // Evicts (7,70)
+	ASSERT_TRUE(HammingQueuePeek(&q1, &key, &id) && key == 1 && id == 10);
+	ASSERT_TRUE(HammingQueueAt(&q1, 1, &key, &id) && key == 3 && id == 30);
+	ASSERT_TRUE(HammingQueuePeekLast(&q1, &key, &id) && key == 3 && id == 31);
+	ASSERT_TRUE(HammingQueueDequeue(&q1) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(HammingQueueEnqueue(&q1, 2, 20) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(HammingQueuePeek(&q1, &key, &id) && key == 2 && id == 20);
+	ASSERT_TRUE(HammingQueueReset(&q1, 5) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(HammingQueueIsEmpty(&q1));
+	ASSERT_TRUE(HammingQueueGetMaxSize(&q1) == 5);
+	HammingQueueClear(&q1);
+	ASSERT_TRUE(HammingQueueSize(&q1) == 0);
+	// Deallocation
+	HammingQueueDestroy(&q1);
+	return true;
+}
+
+// Interleaves enqueues and dequeues and compares with a list backed SPBPQueue
+bool templateQueueRandomTest(){
+	// Function variables
+	int maxSize, i, j, payload;
+	ElementKey key;
+	// Queue variables
+	ElementQueue q;
+	SPBPQueue reference;
+	SPBPQueue copy;
+	SPListElement e;
+	srand(2016);
+	for (maxSize = 1; maxSize <= 40; maxSize += 3) {
+		ElementQueueInit(&q, maxSize);
+		reference = spBPQueueCreate(maxSize);
+		for (i = 0; i < 600; i++) {
+			if (rand() % 5 == 0) {
+				ASSERT_TRUE(ElementQueueDequeue(&q) == spBPQueueDequeue(reference));
+			} else {
+				key.index = rand() % 1000;
+				key.value = (double) (rand() % 30);
+				e = spListElementCreate(key.index, key.value);
+				spBPQueueEnqueue(reference, e);
+				ElementQueueEnqueue(&q, key, key.index);
+				spListElementDestroy(e);
+			}
+			ASSERT_TRUE(ElementQueueSize(&q) == spBPQueueSize(reference));
+			copy = spBPQueueCopy(reference);
+			for (j = 0; j < ElementQueueSize(&q); j++) {
+				e = spBPQueuePeek(copy);
+				ASSERT_TRUE(ElementQueueAt(&q, j, &key, &payload));
+				ASSERT_TRUE(key.index == spListElementGetIndex(e) && payload == key.index);
+				ASSERT_TRUE(key.value == spListElementGetValue(e));
+				spListElementDestroy(e);
+				spBPQueueDequeue(copy);
+			}
+			spBPQueueDestroy(copy);
+		}
+		ElementQueueDestroy(&q);
+		spBPQueueDestroy(reference);
+	}
+	return true;
+}
+
+int main() {
+	RUN_TEST(templateQueueInitTest);
+	RUN_TEST(templateQueueEnqueueTest);
+	RUN_TEST(templateQueueRandomTest);
+	return 0;
+}
@@ -1,6 +1,7 @@
 #include "../SPBPriorityQueue.h"
 #include "unit_test_util.h"
 #include <stdbool.h>
+#include <stdlib.h>
 
 
 bool queueCreateInputTest(){
@@ -367,6 +368,258 @@ bool queueDequeueTest(){
 	spListElementDestroy(e3);
 	return true;
 }
+bool queueBackendTest(){
+	// SPBPQueue variables
+	SPBPQueue q1 = spBPQueueCreateWithBackend(2, SP_BPQUEUE_HEAP_BACKEND);
+	SPBPQueue q2 = spBPQueueCreateWithBackend(-1, SP_BPQUEUE_HEAP_BACKEND);
+	SPBPQueue q3 = spBPQueueCreateWithBackend(0, SP_BPQUEUE_HEAP_BACKEND);
+	SPBPQueue q4 = spBPQueueCreate(2);
+	SPBPQueue q5;
+	SPListElement e1 = spListElementCreate(1,1);
+	SPListElement e2 = spListElementCreate(2,3);
+	SPListElement e3 = spListElementCreate(3,2);
+	SPListElement temp; // temporary variable to hold peek's return element
+	// Assertions
+	ASSERT_TRUE(q1 != NULL);
+	ASSERT_TRUE(q2 == NULL);
+	ASSERT_TRUE(q3 != NULL);
+	ASSERT_TRUE(spBPQueueGetBackend(q1) == SP_BPQUEUE_HEAP_BACKEND);
+	ASSERT_TRUE(spBPQueueGetBackend(q4) == SP_BPQUEUE_LIST_BACKEND);
+	ASSERT_TRUE(spBPQueueEnqueue(q3,e1) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spBPQueueSize(q3) == 0);
+	ASSERT_TRUE(spBPQueueEnqueue(q1,e2) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spBPQueueEnqueue(q1,e1) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spBPQueueIsFull(q1));
+	ASSERT_TRUE(spBPQueueMinValue(q1) == 1);
+	ASSERT_TRUE(spBPQueueMaxValue(q1) == 3);
+	ASSERT_TRUE(spBPQueueEnqueue(q1,e3) == SP_BPQUEUE_FULL); // Evicts (2,3)
+	ASSERT_TRUE(spBPQueueMaxValue(q1) == 2);
+	q5 = spBPQueueCopy(q1);
+	ASSERT_TRUE(spBPQueueGetBackend(q5) == SP_BPQUEUE_HEAP_BACKEND);
+	spBPQueueDequeue(q1);
+	temp = spBPQueuePeek(q1);
+	ASSERT_TRUE(spListElementCompare(temp,e3) == 0);
+	spListElementDestroy(temp);
+	temp = spBPQueuePeek(q5); // The copy is not affected
+	ASSERT_TRUE(spListElementCompare(temp,e1) == 0);
+	spListElementDestroy(temp);
+	temp = spBPQueuePeekLast(q5);
+	ASSERT_TRUE(spListElementCompare(temp,e3) == 0);
+	spListElementDestroy(temp);
+	spBPQueueClear(q5);
+	ASSERT_TRUE(spBPQueueIsEmpty(q5));
+	// Deallocation
+	spBPQueueDestroy(q1);
+	spBPQueueDestroy(q3);
+	spBPQueueDestroy(q4);
+	spBPQueueDestroy(q5);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	spListElementDestroy(e3);
+	return true;
+}
+
+// Checks that both ends of a queue match those of a reference list backed queue
+static bool sameEnds(SPBPQueue q, SPBPQueue reference) {
+	SPListElement temp1;
+	SPListElement temp2;
+	bool same;
+	ASSERT_TRUE(spBPQueueSize(q) == spBPQueueSize(reference));
+	if (spBPQueueIsEmpty(q)) {
+		return true;
+	}
+	temp1 = spBPQueuePeek(q);
+	temp2 = spBPQueuePeek(reference);
+	same = spListElementCompare(temp1,temp2) == 0;
+	spListElementDestroy(temp1);
+	spListElementDestroy(temp2);
+	temp1 = spBPQueuePeekLast(q);
+	temp2 = spBPQueuePeekLast(reference);
+	same = same && spListElementCompare(temp1,temp2) == 0;
+	spListElementDestroy(temp1);
+	spListElementDestroy(temp2);
+	return same;
+}
+
+// Interleaves enqueues and dequeues on the heap and skip list backends and compares with the list backend
+bool queueHeapBackendRandomTest(){
+	// Function variables
+	int maxSize;
+	int i; // Generic loop variable
+	// SPBPQueue variables
+	SPBPQueue q;
+	SPBPQueue reference;
+	SPListElement e;
+	srand(2016);
+	for (maxSize = 1; maxSize <= 33; maxSize += 4) {
+		q = spBPQueueCreateWithBackend(maxSize, maxSize % 8 == 1 ? SP_BPQUEUE_HEAP_BACKEND
+				: SP_BPQUEUE_SKIPLIST_BACKEND);
+		reference = spBPQueueCreate(maxSize);
+		for (i = 0; i < 2000; i++) {
+			if (rand() % 4 == 0) {
+				ASSERT_TRUE(spBPQueueDequeue(q) == spBPQueueDequeue(reference));
+			} else {
+				e = spListElementCreate(rand() % 50, (double) (rand() % 20));
+				ASSERT_TRUE(spBPQueueEnqueue(q,e) == spBPQueueEnqueue(reference,e));
+				spListElementDestroy(e);
+			}
+			ASSERT_TRUE(sameEnds(q,reference));
+		}
+		while (!spBPQueueIsEmpty(reference)) { // Drain in order
+			spBPQueueDequeue(q);
+			spBPQueueDequeue(reference);
+			ASSERT_TRUE(sameEnds(q,reference));
+		}
+		spBPQueueDestroy(q);
+		spBPQueueDestroy(reference);
+	}
+	return true;
+}
+
+bool queueEnqueueSortedTest(){
+	// Function variables
+	int indices[4] = {4,1,2,3};
+	double values[4] = {1,2,2,5};
+	int badIndices[2] = {2,1};
+	double badValues[2] = {1,1};
+	SP_BPQUEUE_BACKEND backends[3] = {SP_BPQUEUE_LIST_BACKEND, SP_BPQUEUE_HEAP_BACKEND,
+			SP_BPQUEUE_SKIPLIST_BACKEND};
+	int i; // Generic loop variable
+	// SPBPQueue variables
+	SPBPQueue q1;
+	SPListElement e1 = spListElementCreate(9,0);
+	SPListElement e2 = spListElementCreate(0,2);
+	SPListElement temp; // temporary variable to hold peek's return element
+	for (i = 0; i < 3; i++) {
+		q1 = spBPQueueCreateWithBackend(4, backends[i]);
+		// Assertions
+		ASSERT_TRUE(spBPQueueEnqueueSorted(NULL,indices,values,4) == SP_BPQUEUE_INVALID_ARGUMENT);
+		ASSERT_TRUE(spBPQueueEnqueueSorted(q1,NULL,values,4) == SP_BPQUEUE_INVALID_ARGUMENT);
+		ASSERT_TRUE(spBPQueueEnqueueSorted(q1,badIndices,badValues,2) == SP_BPQUEUE_INVALID_ARGUMENT);
+		ASSERT_TRUE(spBPQueueSize(q1) == 0);
+		ASSERT_TRUE(spBPQueueEnqueueSorted(q1,indices,values,4) == SP_BPQUEUE_SUCCESS);
+		ASSERT_TRUE(spBPQueueIsFull(q1));
+		spBPQueueDequeue(q1);
+		spBPQueueEnqueue(q1,e1);
+		ASSERT_TRUE(spBPQueueEnqueueSorted(q1,indices,values,4) == SP_BPQUEUE_FULL);
+		ASSERT_TRUE(spBPQueueSize(q1) == 4);
+		temp = spBPQueuePeek(q1); // (9,0),(4,1),(1,2),(1,2)
+		ASSERT_TRUE(spListElementCompare(temp,e1) == 0);
+		spListElementDestroy(temp);
+		ASSERT_TRUE(spBPQueueMaxValue(q1) == 2);
+		spBPQueueClear(q1);
+		spBPQueueEnqueue(q1,e2);
+		ASSERT_TRUE(spBPQueueEnqueueSorted(q1,indices,values,4) == SP_BPQUEUE_FULL);
+		spBPQueueDequeue(q1);
+		temp = spBPQueuePeek(q1); // (0,2) goes before (1,2)
+		ASSERT_TRUE(spListElementCompare(temp,e2) == 0);
+		spListElementDestroy(temp);
+		spBPQueueDestroy(q1);
+	}
+	// Deallocation
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+
+bool queueResetTest(){
+	// Function variables
+	SP_BPQUEUE_BACKEND backends[3] = {SP_BPQUEUE_LIST_BACKEND, SP_BPQUEUE_HEAP_BACKEND,
+			SP_BPQUEUE_SKIPLIST_BACKEND};
+	int i, j; // Generic loop variables
+	// SPBPQueue variables
+	SPBPQueue q1;
+	SPListElement e1 = spListElementCreate(1,1);
+	SPListElement e2 = spListElementCreate(2,2);
+	for (i = 0; i < 3; i++) {
+		q1 = spBPQueueCreateWithBackend(2, backends[i]);
+		// Assertions
+		ASSERT_TRUE(spBPQueueReset(NULL,1) == SP_BPQUEUE_INVALID_ARGUMENT);
+		ASSERT_TRUE(spBPQueueReset(q1,-1) == SP_BPQUEUE_INVALID_ARGUMENT);
+		spBPQueueEnqueue(q1,e1);
+		spBPQueueEnqueue(q1,e2);
+		ASSERT_TRUE(spBPQueueReset(q1,1) == SP_BPQUEUE_SUCCESS); // Shrink
+		ASSERT_TRUE(spBPQueueIsEmpty(q1));
+		ASSERT_TRUE(spBPQueueGetMaxSize(q1) == 1);
+		ASSERT_TRUE(spBPQueueEnqueue(q1,e2) == SP_BPQUEUE_SUCCESS);
+		ASSERT_TRUE(spBPQueueEnqueue(q1,e1) == SP_BPQUEUE_FULL);
+		ASSERT_TRUE(spBPQueueMaxValue(q1) == 1);
+		ASSERT_TRUE(spBPQueueReset(q1,10) == SP_BPQUEUE_SUCCESS); // Grow
+		ASSERT_TRUE(spBPQueueIsEmpty(q1));
+		for (j = 0; j < 10; j++) {
+			ASSERT_TRUE(spBPQueueEnqueue(q1,e1) == SP_BPQUEUE_SUCCESS);
+		}
+		ASSERT_TRUE(spBPQueueIsFull(q1));
+		spBPQueueDestroy(q1);
+	}
+	// Deallocation
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+
+bool queueToArrayTest(){
+	// Function variables
+	SP_BPQUEUE_BACKEND backends[3] = {SP_BPQUEUE_LIST_BACKEND, SP_BPQUEUE_HEAP_BACKEND,
+			SP_BPQUEUE_SKIPLIST_BACKEND};
+	int indices[5];
+	double values[5];
+	int i, j; // Generic loop variables
+	// SPBPQueue variables
+	SPBPQueue q1;
+	SPListElement e;
+	for (i = 0; i < 3; i++) {
+		q1 = spBPQueueCreateWithBackend(5, backends[i]);
+		// Assertions
+		ASSERT_TRUE(spBPQueueToArray(NULL,indices,values) == -1);
+		ASSERT_TRUE(spBPQueueToArray(q1,NULL,values) == -1);
+		ASSERT_TRUE(spBPQueueToArray(q1,indices,values) == 0);
+		for (j = 0; j < 8; j++) {
+			e = spListElementCreate(j, (double) ((j * 5) % 8));
+			spBPQueueEnqueue(q1,e);
+			spListElementDestroy(e);
+		}
+		ASSERT_TRUE(spBPQueueToArray(q1,indices,values) == 5);
+		for (j = 0; j < 5; j++) { // Values 0..4 with indices 0,5,2,7,4
+			ASSERT_TRUE(values[j] == j && indices[j] == (j * 5) % 8);
+		}
+		ASSERT_TRUE(spBPQueueSize(q1) == 5);
+		spBPQueueDestroy(q1);
+	}
+	return true;
+}
+
+bool queueSharedPoolTest(){
+	// Function variables
+	int i; // Generic loop variable
+	// SPBPQueue variables
+	SPListNodePool pool = spListNodePoolCreate(4);
+	SPBPQueue q1 = spBPQueueCreateWithPool(2, pool);
+	SPBPQueue q2 = spBPQueueCreateWithPool(2, NULL);
+	SPBPQueue q3;
+	SPListElement e1 = spListElementCreate(1,1);
+	SPListElement e2 = spListElementCreate(2,2);
+	// Assertions
+	ASSERT_TRUE(q1 != NULL);
+	ASSERT_TRUE(q2 == NULL);
+	ASSERT_TRUE(spBPQueueCreateWithPool(-1, pool) == NULL);
+	spBPQueueEnqueue(q1,e2);
+	spBPQueueEnqueue(q1,e1);
+	spBPQueueDestroy(q1);
+	for (i = 0; i < 3; i++) { // Queues created one after the other reuse the nodes
+		q3 = spBPQueueCreateWithPool(2, pool);
+		ASSERT_TRUE(spBPQueueEnqueue(q3,e2) == SP_BPQUEUE_SUCCESS);
+		ASSERT_TRUE(spBPQueueEnqueue(q3,e1) == SP_BPQUEUE_SUCCESS);
+		ASSERT_TRUE(spBPQueueMinValue(q3) == 1);
+		spBPQueueDestroy(q3);
+	}
+	// Deallocation
+	spListNodePoolDestroy(pool);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+
 int main() {
 	RUN_TEST(queueCreateInputTest);
 	RUN_TEST(queueCopyInputTest);
@@ -380,5 +633,11 @@ int main() {
 	RUN_TEST(queueFullTest);
 	RUN_TEST(queueEnqueueTest);
 	RUN_TEST(queueDequeueTest);
+	RUN_TEST(queueBackendTest);
+	RUN_TEST(queueHeapBackendRandomTest);
+	RUN_TEST(queueEnqueueSortedTest);
+	RUN_TEST(queueResetTest);
+	RUN_TEST(queueToArrayTest);
+	RUN_TEST(queueSharedPoolTest);
 	return 0;
 }
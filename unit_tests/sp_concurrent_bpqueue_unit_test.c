@@ -0,0 +1,169 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../SPConcurrentBPQueue.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+
+#define THREADS_NUM 8
+#define OFFERS_PER_THREAD 2000
+#define SHARED_MAX_SIZE 16
+
+typedef struct worker_args_t {
+	SPConcurrentBPQueue queue;
+	int first; // First index offered by the worker
+	bool useStage;
+} WorkerArgs;
+
+// Value of the candidate with the given index, the smallest values belong to odd workers
+static double valueOf(int index) {
+	return (double) ((index * 7919) % (THREADS_NUM * OFFERS_PER_THREAD));
+}
+
+static void* worker(void* arg) {
+	WorkerArgs* args = (WorkerArgs*) arg;
+	SPConcurrentBPQueueStage stage = NULL;
+	int i; // Generic loop variable
+	if (args->useStage) {
+		stage = spConcurrentBPQueueStageCreate(args->queue, 32);
+	}
+	for (i = args->first; i < args->first + OFFERS_PER_THREAD; i++) {
+		if (stage != NULL) {
+			spConcurrentBPQueueStageOffer(stage, i, valueOf(i));
+		} else {
+			spConcurrentBPQueueOffer(args->queue, i, valueOf(i));
+		}
+	}
+	spConcurrentBPQueueStageDestroy(stage);
+	return NULL;
+}
+
+static bool runWorkers(bool useStage) {
+	// Function variables
+	pthread_t threads[THREADS_NUM];
+	WorkerArgs args[THREADS_NUM];
+	SPConcurrentBPQueue queue = spConcurrentBPQueueCreate(SHARED_MAX_SIZE);
+	SPBPQueue snapshot;
+	SPListElement temp; // temporary variable to hold peek's return element
+	int i; // Generic loop variable
+	// Assertions
+	ASSERT_TRUE(queue != NULL);
+	for (i = 0; i < THREADS_NUM; i++) {
+		args[i].queue = queue;
+		args[i].first = i * OFFERS_PER_THREAD;
+		args[i].useStage = useStage;
+		ASSERT_TRUE(pthread_create(&threads[i], NULL, worker, &args[i]) == 0);
+	}
+	for (i = 0; i < THREADS_NUM; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	ASSERT_TRUE(spConcurrentBPQueueSize(queue) == SHARED_MAX_SIZE);
+	ASSERT_TRUE(spConcurrentBPQueueBound(queue) == SHARED_MAX_SIZE - 1);
+	snapshot = spConcurrentBPQueueSnapshot(queue);
+	for (i = 0; i < SHARED_MAX_SIZE; i++) { // Values are a permutation, so the k best are 0..k-1
+		temp = spBPQueuePeek(snapshot);
+		ASSERT_TRUE(spListElementGetValue(temp) == i);
+		spListElementDestroy(temp);
+		spBPQueueDequeue(snapshot);
+	}
+	// Deallocation
+	spBPQueueDestroy(snapshot);
+	spConcurrentBPQueueDestroy(queue);
+	return true;
+}
+
+bool concurrentQueueCreateTest(){
+	// SPConcurrentBPQueue variables
+	SPConcurrentBPQueue q1 = spConcurrentBPQueueCreate(2);
+	SPConcurrentBPQueue q2 = spConcurrentBPQueueCreate(-1);
+	SPConcurrentBPQueue q3 = spConcurrentBPQueueCreate(0);
+	// Assertions
+	ASSERT_TRUE(q1 != NULL);
+	ASSERT_TRUE(q2 == NULL);
+	ASSERT_TRUE(q3 != NULL);
+	ASSERT_TRUE(spConcurrentBPQueueSize(q1) == 0);
+	ASSERT_TRUE(spConcurrentBPQueueGetMaxSize(q1) == 2);
+	ASSERT_TRUE(spConcurrentBPQueueSize(NULL) == -1);
+	ASSERT_TRUE(spConcurrentBPQueueGetMaxSize(NULL) == -1);
+	ASSERT_TRUE(spConcurrentBPQueueBound(q1) == HUGE_VAL); // Not full
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q3, 1, 1.0) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spConcurrentBPQueueSize(q3) == 0);
+	// Deallocation
+	spConcurrentBPQueueDestroy(q1);
+	spConcurrentBPQueueDestroy(q2);
+	spConcurrentBPQueueDestroy(q3);
+	return true;
+}
+
+bool concurrentQueueOfferTest(){
+	// SPConcurrentBPQueue variables
+	SPConcurrentBPQueue q1 = spConcurrentBPQueueCreate(2);
+	SPListElement e1 = spListElementCreate(1,3);
+	SPBPQueue snapshot;
+	// Assertions
+	ASSERT_TRUE(spConcurrentBPQueueOffer(NULL, 1, 1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q1, -1, 1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q1, 1, -1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueEnqueue(q1, NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueEnqueue(q1, e1) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q1, 2, 2.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueBound(q1) == 3.0); // Full, bound is the maximal value
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q1, 3, 4.0) == SP_BPQUEUE_FULL); // Rejected by bound
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q1, 0, 3.0) == SP_BPQUEUE_FULL); // Equal value, lower index
+	snapshot = spConcurrentBPQueueSnapshot(q1);
+	ASSERT_TRUE(spBPQueueSize(snapshot) == 2);
+	ASSERT_TRUE(spBPQueueMinValue(snapshot) == 2.0);
+	ASSERT_TRUE(spBPQueueMaxValue(snapshot) == 3.0);
+	spBPQueueDestroy(snapshot);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(q1, 4, 1.0) == SP_BPQUEUE_FULL); // Evicts (0,3)
+	ASSERT_TRUE(spConcurrentBPQueueBound(q1) == 2.0);
+	// Deallocation
+	spConcurrentBPQueueDestroy(q1);
+	spListElementDestroy(e1);
+	return true;
+}
+
+bool concurrentQueueStageTest(){
+	// SPConcurrentBPQueue variables
+	SPConcurrentBPQueue q1 = spConcurrentBPQueueCreate(2);
+	SPConcurrentBPQueueStage stage = spConcurrentBPQueueStageCreate(q1, 4);
+	// Assertions
+	ASSERT_TRUE(spConcurrentBPQueueStageCreate(NULL, 4) == NULL);
+	ASSERT_TRUE(spConcurrentBPQueueStageCreate(q1, 0) == NULL);
+	ASSERT_TRUE(stage != NULL);
+	ASSERT_TRUE(spConcurrentBPQueueStageOffer(NULL, 1, 1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueStageOffer(stage, 1, 5.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueStageOffer(stage, 2, 4.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueStageOffer(stage, 3, 3.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueSize(q1) == 0); // Still buffered
+	ASSERT_TRUE(spConcurrentBPQueueStageFlush(stage) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueSize(q1) == 2);
+	ASSERT_TRUE(spConcurrentBPQueueBound(q1) == 4.0);
+	ASSERT_TRUE(spConcurrentBPQueueStageOffer(stage, 4, 6.0) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spConcurrentBPQueueStageOffer(stage, 5, 1.0) == SP_BPQUEUE_SUCCESS);
+	spConcurrentBPQueueStageDestroy(stage); // Flushes (5,1)
+	ASSERT_TRUE(spConcurrentBPQueueBound(q1) == 3.0);
+	// Deallocation
+	spConcurrentBPQueueDestroy(q1);
+	return true;
+}
+
+bool concurrentQueueThreadsTest(){
+	ASSERT_TRUE(runWorkers(false));
+	return true;
+}
+
+bool concurrentQueueStagedThreadsTest(){
+	ASSERT_TRUE(runWorkers(true));
+	return true;
+}
+
+int main() {
+	RUN_TEST(concurrentQueueCreateTest);
+	RUN_TEST(concurrentQueueOfferTest);
+	RUN_TEST(concurrentQueueStageTest);
+	RUN_TEST(concurrentQueueThreadsTest);
+	RUN_TEST(concurrentQueueStagedThreadsTest);
+	return 0;
+}
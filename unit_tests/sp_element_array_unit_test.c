@@ -0,0 +1,276 @@
+#include "../SPElementArray.h"
+#include "../SPBPriorityQueue.h"
+#include "../SPList.h"
+#include "../SPListElement.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <float.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static SPElement element(int index, double value) {
+	SPElement e;
+	e.index = index;
+	e.value = value;
+	return e;
+}
+
+// Fills an array with n random elements, with many equal values
+static void fillRandom(SPElementArray array, int n) {
+	int i; // Generic loop variable
+	for (i = 0; i < n; i++) {
+		spElementArrayAppend(array, element(rand() % 1000, (double) (rand() % 50)));
+	}
+}
+
+static int elementCompare(const void* p1, const void* p2) {
+	const SPElement* e1 = (const SPElement*) p1;
+	const SPElement* e2 = (const SPElement*) p2;
+	if (e1->value != e2->value) {
+		return e1->value < e2->value ? -1 : 1;
+	}
+	return (e1->index > e2->index) - (e1->index < e2->index);
+}
+
+static bool isSorted(SPElementArray array) {
+	int i; // Generic loop variable
+	SPElement* data = spElementArrayGetData(array);
+	for (i = 1; i < spElementArrayGetSize(array); i++) {
+		ASSERT_TRUE(data[i-1].value < data[i].value
+				|| (data[i-1].value == data[i].value && data[i-1].index <= data[i].index));
+	}
+	return true;
+}
+
+bool elementArrayInputTest(){
+	// Function variables
+	SPElementArray array = spElementArrayCreate(0);
+	// Assertions
+	ASSERT_TRUE(array != NULL);
+	ASSERT_TRUE(spElementArrayCreate(-1) == NULL);
+	ASSERT_TRUE(spElementArrayGetSize(NULL) == -1);
+	ASSERT_TRUE(spElementArrayGetSize(array) == 0);
+	ASSERT_TRUE(spElementArrayGetData(NULL) == NULL);
+	ASSERT_TRUE(spElementArrayGetAt(array, 0) == NULL);
+	ASSERT_TRUE(spElementArrayAppend(NULL, element(1,1.0)) == SP_ELEMENT_ARRAY_INVALID_ARGUMENT);
+	ASSERT_TRUE(spElementArrayAppendListElement(array, NULL) == SP_ELEMENT_ARRAY_INVALID_ARGUMENT);
+	ASSERT_TRUE(spElementArraySort(NULL) == SP_ELEMENT_ARRAY_INVALID_ARGUMENT);
+	ASSERT_TRUE(spElementArraySlice(array, 0, 1) == NULL);
+	ASSERT_TRUE(spElementArraySlice(array, -1, 0) == NULL);
+	ASSERT_TRUE(spElementArrayCopy(NULL) == NULL);
+	ASSERT_TRUE(spElementArrayFromList(NULL) == NULL);
+	ASSERT_TRUE(spElementArrayToList(NULL, SP_LIST_LINKED_BACKEND) == NULL);
+	ASSERT_TRUE(spElementArrayFromBPQueue(NULL) == NULL);
+	ASSERT_TRUE(spElementArrayToBPQueue(array, NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	// Deallocation
+	spElementArrayDestroy(array);
+	spElementArrayDestroy(NULL);
+	spElementArrayClear(NULL);
+	return true;
+}
+
+bool elementArrayAppendTest(){
+	// Function variables
+	int i; // Generic loop variable
+	SPElementArray array = spElementArrayCreate(3);
+	SPElementArray slice, copy;
+	SPListElement e = spListElementCreate(7, 7.5);
+	// Assertions
+	for (i = 0; i < 1000; i++) { // Grows past the initial capacity
+		ASSERT_TRUE(spElementArrayAppend(array, element(i, i / 2.0)) == SP_ELEMENT_ARRAY_SUCCESS);
+		ASSERT_TRUE((uintptr_t) spElementArrayGetData(array) % SP_ELEMENT_ARRAY_ALIGNMENT == 0);
+	}
+	ASSERT_TRUE(spElementArrayAppendListElement(array, e) == SP_ELEMENT_ARRAY_SUCCESS);
+	ASSERT_TRUE(spElementArrayGetSize(array) == 1001);
+	ASSERT_TRUE(spElementArrayGetAt(array, 1000)->index == 7);
+	ASSERT_TRUE(spElementArrayGetAt(array, 1000)->value == 7.5);
+	ASSERT_TRUE(spElementArrayGetAt(array, 500)->index == 500);
+	ASSERT_TRUE(spElementArrayGetAt(array, 1001) == NULL);
+	slice = spElementArraySlice(array, 10, 20);
+	ASSERT_TRUE(spElementArrayGetSize(slice) == 10);
+	ASSERT_TRUE(spElementArrayGetAt(slice, 0)->index == 10 && spElementArrayGetAt(slice, 9)->index == 19);
+	spElementArrayDestroy(slice);
+	slice = spElementArraySlice(array, 5, 5);
+	ASSERT_TRUE(spElementArrayGetSize(slice) == 0);
+	spElementArrayDestroy(slice);
+	copy = spElementArrayCopy(array);
+	spElementArrayGetAt(array, 0)->index = 99; // The copy is independent
+	ASSERT_TRUE(spElementArrayGetSize(copy) == 1001 && spElementArrayGetAt(copy, 0)->index == 0);
+	spElementArrayClear(array);
+	ASSERT_TRUE(spElementArrayGetSize(array) == 0);
+	// Deallocation
+	spElementArrayDestroy(copy);
+	spElementArrayDestroy(array);
+	spListElementDestroy(e);
+	return true;
+}
+
+bool elementArraySortTest(){
+	// Function variables
+	int n, i; // Generic loop variables
+	SPElementArray array;
+	SPList reference;
+	SPListIter iter;
+	srand(2016);
+	for (n = 0; n <= 2000; n = n * 3 + 1) {
+		array = spElementArrayCreate(0);
+		fillRandom(array, n);
+		reference = spElementArrayToList(array, SP_LIST_VECTOR_BACKEND);
+		spListSort(reference, NULL);
+		ASSERT_TRUE(spElementArraySort(array) == SP_ELEMENT_ARRAY_SUCCESS);
+		ASSERT_TRUE(isSorted(array));
+		iter = spListIterBegin(reference);
+		for (i = 0; i < n; i++, spListIterNext(&iter)) { // Same order as spListSort
+			ASSERT_TRUE(spListElementGetIndex(spListIterGet(&iter)) == spElementArrayGetAt(array, i)->index);
+			ASSERT_TRUE(spListElementGetValue(spListIterGet(&iter)) == spElementArrayGetAt(array, i)->value);
+		}
+		spListDestroy(reference);
+		spElementArrayDestroy(array);
+	}
+	return true;
+}
+
+// Values and indices at the edges of their ranges
+bool elementArraySortKeyTest(){
+	// Function variables
+	double values[6] = {DBL_MAX, 0.0, 1e-310, 1.0, -0.0, 0.5};
+	int indices[4] = {INT_MAX, 0, 65536, 255};
+	int i, j; // Generic loop variables
+	SPElementArray array = spElementArrayCreate(0);
+	SPElementArray copy;
+	SPListElement e1 = spListElementCreate(0, 0.0);
+	SPListElement e2 = spListElementCreate(0, 0.0);
+	for (i = 0; i < 100; i++) { // More than the insertion sort threshold
+		for (j = 0; j < 6; j++) {
+			spElementArrayAppend(array, element(indices[(i + j) % 4], values[j]));
+		}
+	}
+	copy = spElementArrayCopy(array);
+	spElementArraySort(array);
+	qsort(spElementArrayGetData(copy), spElementArrayGetSize(copy), sizeof(SPElement), elementCompare);
+	for (i = 0; i < spElementArrayGetSize(array); i++) {
+		spListElementSetIndex(e1, spElementArrayGetAt(array, i)->index);
+		spListElementSetValue(e1, spElementArrayGetAt(array, i)->value);
+		spListElementSetIndex(e2, spElementArrayGetAt(copy, i)->index);
+		spListElementSetValue(e2, spElementArrayGetAt(copy, i)->value);
+		ASSERT_TRUE(spListElementCompare(e1, e2) == 0);
+	}
+	// Deallocation
+	spElementArrayDestroy(copy);
+	spElementArrayDestroy(array);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+
+bool elementArraySortParallelTest(){
+	// Function variables
+	int threads[5] = {1, 2, 3, 4, 64};
+	int i, j; // Generic loop variables
+	SPElementArray array = spElementArrayCreate(0);
+	SPElementArray sorted, copy;
+	srand(2016);
+	fillRandom(array, 300000);
+	sorted = spElementArrayCopy(array);
+	spElementArraySort(sorted);
+	ASSERT_TRUE(spElementArraySortParallel(NULL, 2) == SP_ELEMENT_ARRAY_INVALID_ARGUMENT);
+	ASSERT_TRUE(spElementArraySortParallel(array, 0) == SP_ELEMENT_ARRAY_INVALID_ARGUMENT);
+	for (i = 0; i < 5; i++) {
+		copy = spElementArrayCopy(array);
+		ASSERT_TRUE(spElementArraySortParallel(copy, threads[i]) == SP_ELEMENT_ARRAY_SUCCESS);
+		for (j = 0; j < spElementArrayGetSize(copy); j++) {
+			ASSERT_TRUE(spElementArrayGetAt(copy, j)->index == spElementArrayGetAt(sorted, j)->index);
+			ASSERT_TRUE(spElementArrayGetAt(copy, j)->value == spElementArrayGetAt(sorted, j)->value);
+		}
+		spElementArrayDestroy(copy);
+	}
+	// Deallocation
+	spElementArrayDestroy(sorted);
+	spElementArrayDestroy(array);
+	return true;
+}
+
+bool elementArrayListTest(){
+	// Function variables
+	SP_LIST_BACKEND backends[3] = {SP_LIST_LINKED_BACKEND, SP_LIST_UNROLLED_BACKEND,
+			SP_LIST_VECTOR_BACKEND};
+	int i, j; // Generic loop variables
+	SPElementArray array = spElementArrayCreate(0);
+	SPElementArray back;
+	SPList list;
+	fillRandom(array, 100);
+	for (i = 0; i < 3; i++) {
+		list = spElementArrayToList(array, backends[i]);
+		ASSERT_TRUE(spListGetBackend(list) == backends[i]);
+		ASSERT_TRUE(spListGetSize(list) == 100);
+		spListGetAt(list, 40);
+		back = spElementArrayFromList(list);
+		ASSERT_TRUE(spListElementGetIndex(spListGetCurrent(list))
+				== spElementArrayGetAt(array, 40)->index); // The internal iterator did not move
+		ASSERT_TRUE(spElementArrayGetSize(back) == 100);
+		for (j = 0; j < 100; j++) {
+			ASSERT_TRUE(spElementArrayGetAt(back, j)->index == spElementArrayGetAt(array, j)->index);
+			ASSERT_TRUE(spElementArrayGetAt(back, j)->value == spElementArrayGetAt(array, j)->value);
+		}
+		spElementArrayDestroy(back);
+		spListDestroy(list);
+	}
+	// Deallocation
+	spElementArrayDestroy(array);
+	return true;
+}
+
+bool elementArrayQueueTest(){
+	// Function variables
+	SP_BPQUEUE_BACKEND backends[3] = {SP_BPQUEUE_LIST_BACKEND, SP_BPQUEUE_HEAP_BACKEND,
+			SP_BPQUEUE_SKIPLIST_BACKEND};
+	int i, j; // Generic loop variables
+	SPElementArray array = spElementArrayCreate(0);
+	SPElementArray sorted, fromQueue;
+	SPBPQueue q1, q2;
+	fillRandom(array, 300);
+	sorted = spElementArrayCopy(array);
+	spElementArraySort(sorted);
+	for (i = 0; i < 3; i++) {
+		q1 = spBPQueueCreateWithBackend(50, backends[i]);
+		q2 = spBPQueueCreateWithBackend(50, backends[i]);
+		ASSERT_TRUE(spElementArrayToBPQueue(array, q1) == SP_BPQUEUE_FULL);
+		ASSERT_TRUE(spElementArrayToBPQueue(sorted, q2) == SP_BPQUEUE_FULL); // The merge path
+		fromQueue = spElementArrayFromBPQueue(q1);
+		ASSERT_TRUE(spBPQueueSize(q1) == 50); // The queue is not modified
+		ASSERT_TRUE(spElementArrayGetSize(fromQueue) == 50);
+		for (j = 0; j < 50; j++) { // The 50 lowest elements in ascending order
+			ASSERT_TRUE(spElementArrayGetAt(fromQueue, j)->index == spElementArrayGetAt(sorted, j)->index);
+			ASSERT_TRUE(spElementArrayGetAt(fromQueue, j)->value == spElementArrayGetAt(sorted, j)->value);
+		}
+		spElementArrayDestroy(fromQueue);
+		fromQueue = spElementArrayFromBPQueue(q2);
+		for (j = 0; j < 50; j++) {
+			ASSERT_TRUE(spElementArrayGetAt(fromQueue, j)->index == spElementArrayGetAt(sorted, j)->index);
+		}
+		spElementArrayDestroy(fromQueue);
+		spBPQueueDestroy(q1);
+		spBPQueueDestroy(q2);
+	}
+	q1 = spBPQueueCreate(5);
+	spElementArrayAppend(array, element(-1, 1.0));
+	ASSERT_TRUE(spElementArrayToBPQueue(array, q1) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spBPQueueIsEmpty(q1));
+	// Deallocation
+	spBPQueueDestroy(q1);
+	spElementArrayDestroy(sorted);
+	spElementArrayDestroy(array);
+	return true;
+}
+
+int main() {
+	RUN_TEST(elementArrayInputTest);
+	RUN_TEST(elementArrayAppendTest);
+	RUN_TEST(elementArraySortTest);
+	RUN_TEST(elementArraySortKeyTest);
+	RUN_TEST(elementArraySortParallelTest);
+	RUN_TEST(elementArrayListTest);
+	RUN_TEST(elementArrayQueueTest);
+	return 0;
+}
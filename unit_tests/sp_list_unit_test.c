@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdarg.h>
 #include <assert.h>
+#include <limits.h>
+#include <float.h>
 
 static SPList quickList(int size, ...) {
 	va_list items;
@@ -44,6 +46,26 @@ static bool testElementCompare() {
 	return true;
 }
 
+static bool testElementCompareEdges() {
+	SPListElement element1 = spListElementCreate(0, 2.0);
+	SPListElement element2 = spListElementCreate(INT_MAX, 2.0);
+	SPListElement element3 = spListElementCreate(0, -0.0);
+	SPListElement element4 = spListElementCreate(0, 0.0);
+	SPListElement element5 = spListElementCreate(INT_MAX, DBL_MAX);
+	ASSERT_TRUE(spListElementCompare(element1, element2) == -1); // Not an index difference
+	ASSERT_TRUE(spListElementCompare(element2, element1) == 1);
+	ASSERT_TRUE(spListElementCompare(element3, element4) == 0); // -0.0 is equal to 0.0
+	ASSERT_TRUE(spListElementCompare(element4, element1) == -1);
+	ASSERT_TRUE(spListElementCompare(element5, element2) == 1);
+	ASSERT_TRUE(spListElementCompare(element2, element5) == -1);
+	spListElementDestroy(element1);
+	spListElementDestroy(element2);
+	spListElementDestroy(element3);
+	spListElementDestroy(element4);
+	spListElementDestroy(element5);
+	return true;
+}
+
 static bool testElementGetIndex() {
 	SPListElement element1 = spListElementCreate(1, 0.0);
 	SPListElement element2 = spListElementCreate(2, 0.0);
@@ -418,10 +440,429 @@ static bool testListForEach() {
 	spListElementDestroy(e5);
 	return true;
 }
+static bool testListPool() {
+	SPListElement e1 = spListElementCreate(1, 1.0);
+	SPListElement e2 = spListElementCreate(2, 2.0);
+	SPListNodePool pool = spListNodePoolCreate(2);
+	ASSERT_TRUE(spListNodePoolCreate(0) == NULL);
+	ASSERT_TRUE(spListCreateWithPool(NULL) == NULL);
+	ASSERT_TRUE(pool != NULL);
+	SPList list1 = spListCreateWithPool(pool);
+	SPList list2 = spListCreateWithPool(pool);
+	ASSERT_TRUE(list1 != NULL && list2 != NULL);
+	for (int i = 0; i < 10; i++) { // Grows the pool past its first chunk
+		ASSERT_TRUE(spListInsertLast(list1, e1) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListInsertFirst(list2, e2) == SP_LIST_SUCCESS);
+	}
+	SPListElement first = spListGetFirst(list1);
+	ASSERT_TRUE(spListElementCompare(first, e1) == 0);
+	ASSERT_TRUE(first != e1); // A copy is stored
+	spListClear(list1);
+	ASSERT_TRUE(spListGetSize(list1) == 0);
+	ASSERT_TRUE(spListGetSize(list2) == 10);
+	ASSERT_TRUE(spListInsertLast(list1, e1) == SP_LIST_SUCCESS); // Reuses a freed node
+	spListNodePoolDestroy(pool); // The lists still hold the pool
+	SP_LIST_FOREACH(SPListElement, e, list2) {
+		ASSERT_TRUE(spListElementCompare(e, e2) == 0);
+	}
+	spListDestroy(list1);
+	spListDestroy(list2); // Frees the pool
+	spListNodePoolDestroy(NULL);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+// Checks that two lists hold equal elements in the same order
+static bool listsEqual(SPList list1, SPList list2) {
+	SPListElement e2 = spListGetFirst(list2);
+	ASSERT_TRUE(spListGetSize(list1) == spListGetSize(list2));
+	SP_LIST_FOREACH(SPListElement, e1, list1) {
+		ASSERT_TRUE(e2 != NULL && spListElementCompare(e1, e2) == 0);
+		e2 = spListGetNext(list2);
+	}
+	ASSERT_TRUE(e2 == NULL);
+	return true;
+}
+// Applies the same random operations to a list using backend and to a linked list
+static bool checkBackend(SP_LIST_BACKEND backend) {
+	SPList other = spListCreateWithBackend(backend);
+	SPList linked = spListCreateWithBackend(SP_LIST_LINKED_BACKEND);
+	SPListElement e = spListElementCreate(0, 0.0);
+	unsigned int seed = 7;
+	ASSERT_TRUE(spListGetBackend(other) == backend);
+	ASSERT_TRUE(spListGetBackend(linked) == SP_LIST_LINKED_BACKEND);
+	ASSERT_TRUE(spListGetNext(other) == NULL);
+	ASSERT_TRUE(spListInsertBeforeCurrent(other, e) == SP_LIST_INVALID_CURRENT);
+	ASSERT_TRUE(spListRemoveCurrent(other) == SP_LIST_INVALID_CURRENT);
+	for (int i = 0; i < 4000; i++) {
+		// Moves both iterators to the same random position and applies the same operation
+		int size = spListGetSize(linked);
+		int position = size == 0 ? 0 : (int) (seed % size);
+		int operation;
+		seed = seed * 1103515245 + 12345;
+		operation = (int) ((seed >> 16) % 8);
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, (double) i);
+		spListGetFirst(linked);
+		spListGetFirst(other);
+		for (int j = 0; j < position; j++) {
+			spListGetNext(linked);
+			spListGetNext(other);
+		}
+		ASSERT_TRUE(size == 0
+				|| spListElementCompare(spListGetCurrent(linked), spListGetCurrent(other)) == 0);
+		if (operation == 0) {
+			ASSERT_TRUE(spListInsertFirst(other, e) == spListInsertFirst(linked, e));
+		} else if (operation == 1) {
+			ASSERT_TRUE(spListInsertLast(other, e) == spListInsertLast(linked, e));
+		} else if (operation == 2 || operation == 3) {
+			ASSERT_TRUE(spListInsertBeforeCurrent(other, e)
+					== spListInsertBeforeCurrent(linked, e));
+		} else if (operation == 4 || operation == 5) {
+			ASSERT_TRUE(spListInsertAfterCurrent(other, e)
+					== spListInsertAfterCurrent(linked, e));
+		} else if (i < 3000) {
+			ASSERT_TRUE(spListRemoveCurrent(other) == spListRemoveCurrent(linked));
+		} else { // Shrinks the list, so blocks are merged
+			ASSERT_TRUE(spListRemoveCurrent(other) == spListRemoveCurrent(linked));
+			if (spListGetLast(linked) != NULL) {
+				spListGetLast(other);
+				ASSERT_TRUE(spListRemoveCurrent(other) == spListRemoveCurrent(linked));
+			}
+		}
+		if (operation < 6 && size > 0) { // Inserting keeps the iterator on the same element
+			ASSERT_TRUE(spListElementCompare(spListGetCurrent(linked),
+					spListGetCurrent(other)) == 0);
+		}
+	}
+	ASSERT_TRUE(listsEqual(other, linked));
+	ASSERT_TRUE(spListGetLast(other) != NULL);
+	for (SPListElement e1 = spListGetLast(other), e2 = spListGetLast(linked); e2 != NULL;
+			e1 = spListGetPrevious(other), e2 = spListGetPrevious(linked)) {
+		ASSERT_TRUE(e1 != NULL && spListElementCompare(e1, e2) == 0);
+	}
+	SPList copy = spListCopy(other);
+	ASSERT_TRUE(spListGetBackend(copy) == backend);
+	ASSERT_TRUE(listsEqual(copy, linked));
+	ASSERT_TRUE(spListClear(other) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListGetSize(other) == 0 && spListGetFirst(other) == NULL);
+	ASSERT_TRUE(spListInsertLast(other, e) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListElementCompare(spListGetLast(other), e) == 0);
+	spListDestroy(copy);
+	spListDestroy(other);
+	spListDestroy(linked);
+	spListElementDestroy(e);
+	return true;
+}
+static bool testListUnrolled() {
+	return checkBackend(SP_LIST_UNROLLED_BACKEND);
+}
+static bool testListVector() {
+	SP_LIST_BACKEND backends[3] = {SP_LIST_LINKED_BACKEND, SP_LIST_UNROLLED_BACKEND,
+			SP_LIST_VECTOR_BACKEND};
+	SPListElement e = spListElementCreate(0, 0.0);
+	int indices[100];
+	double values[100];
+	ASSERT_TRUE(checkBackend(SP_LIST_VECTOR_BACKEND));
+	ASSERT_TRUE(spListGetAt(NULL, 0) == NULL);
+	ASSERT_TRUE(spListToArray(NULL, indices, values) == -1);
+	for (int b = 0; b < 3; b++) {
+		SPList list = spListCreateWithBackend(backends[b]);
+		ASSERT_TRUE(spListGetAt(list, 0) == NULL);
+		ASSERT_TRUE(spListToArray(list, indices, values) == 0);
+		for (int i = 0; i < 100; i++) {
+			spListElementSetIndex(e, i);
+			spListElementSetValue(e, 100.0 - i);
+			ASSERT_TRUE(spListInsertLast(list, e) == SP_LIST_SUCCESS);
+		}
+		ASSERT_TRUE(spListGetAt(list, 100) == NULL && spListGetAt(list, -1) == NULL);
+		ASSERT_TRUE(spListElementGetIndex(spListGetAt(list, 57)) == 57);
+		ASSERT_TRUE(spListElementGetIndex(spListGetNext(list)) == 58); // GetAt moves the iterator
+		ASSERT_TRUE(spListElementGetIndex(spListGetAt(list, 99)) == 99);
+		ASSERT_TRUE(spListGetNext(list) == NULL);
+		ASSERT_TRUE(spListToArray(list, indices, NULL) == -1);
+		ASSERT_TRUE(spListToArray(list, indices, values) == 100);
+		for (int i = 0; i < 100; i++) {
+			ASSERT_TRUE(indices[i] == i && values[i] == 100.0 - i);
+		}
+		spListDestroy(list);
+	}
+	spListElementDestroy(e);
+	return true;
+}
+// Applies the same random operations through an external iterator of a list
+// using backend, and through the internal iterator of a linked list
+static bool checkIterBackend(SP_LIST_BACKEND backend) {
+	SPList other = spListCreateWithBackend(backend);
+	SPList linked = spListCreateWithBackend(SP_LIST_LINKED_BACKEND);
+	SPListElement e = spListElementCreate(0, 0.0);
+	unsigned int seed = 11;
+	SPListIter iter = spListIterBegin(other);
+	ASSERT_TRUE(spListIterGet(&iter) == NULL && spListIterNext(&iter) == NULL);
+	ASSERT_TRUE(spListIterInsertBefore(&iter, e) == SP_LIST_INVALID_CURRENT);
+	ASSERT_TRUE(spListIterRemove(&iter) == SP_LIST_INVALID_CURRENT);
+	ASSERT_TRUE(spListIterInsertAfter(NULL, e) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListIterInsertAfter(&iter, NULL) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListInsertLast(other, e) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListInsertLast(linked, e) == SP_LIST_SUCCESS);
+	for (int i = 1; i < 3000; i++) {
+		int size = spListGetSize(linked);
+		int position = size == 0 ? 0 : (int) (seed % size);
+		int operation;
+		seed = seed * 1103515245 + 12345;
+		operation = (int) ((seed >> 16) % 5);
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, (double) i);
+		if (size == 0) {
+			ASSERT_TRUE(spListInsertLast(other, e) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListInsertLast(linked, e) == SP_LIST_SUCCESS);
+			continue;
+		}
+		iter = spListIterBegin(other);
+		spListGetFirst(linked);
+		for (int j = 0; j < position; j++) {
+			spListIterNext(&iter);
+			spListGetNext(linked);
+		}
+		if (operation == 0 || operation == 1) {
+			ASSERT_TRUE(spListIterInsertBefore(&iter, e) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListInsertBeforeCurrent(linked, e) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListElementCompare(spListIterGet(&iter), spListGetCurrent(linked)) == 0);
+		} else if (operation == 2 || operation == 3) {
+			ASSERT_TRUE(spListIterInsertAfter(&iter, e) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListInsertAfterCurrent(linked, e) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListElementCompare(spListIterGet(&iter), spListGetCurrent(linked)) == 0);
+		} else {
+			SPListElement next = spListGetNext(linked);
+			ASSERT_TRUE(spListIterRemove(&iter) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(next == NULL ? spListIterGet(&iter) == NULL
+					: spListElementCompare(spListIterGet(&iter), next) == 0);
+			if (next == NULL) {
+				spListGetLast(linked);
+			} else {
+				spListGetPrevious(linked);
+			}
+			ASSERT_TRUE(spListRemoveCurrent(linked) == SP_LIST_SUCCESS);
+		}
+	}
+	ASSERT_TRUE(listsEqual(other, linked));
+	spListDestroy(other);
+	spListDestroy(linked);
+	spListElementDestroy(e);
+	return true;
+}
+static bool testListIter() {
+	SP_LIST_BACKEND backends[3] = {SP_LIST_LINKED_BACKEND, SP_LIST_UNROLLED_BACKEND,
+			SP_LIST_VECTOR_BACKEND};
+	SPListElement e = spListElementCreate(0, 0.0);
+	for (int b = 0; b < 3; b++) {
+		SPList list = spListCreateWithBackend(backends[b]);
+		SPListIter outer, inner;
+		int pairs = 0;
+		for (int i = 0; i < 50; i++) {
+			spListElementSetIndex(e, i);
+			spListElementSetValue(e, (double) i);
+			ASSERT_TRUE(spListInsertLast(list, e) == SP_LIST_SUCCESS);
+		}
+		ASSERT_TRUE(spListElementGetIndex(spListGetAt(list, 10)) == 10);
+		// Nested traversals of the same list
+		for (outer = spListIterBegin(list); spListIterGet(&outer) != NULL; spListIterNext(&outer)) {
+			for (inner = spListIterLast(list); spListIterGet(&inner) != NULL;
+					spListIterPrevious(&inner)) {
+				pairs++;
+			}
+		}
+		ASSERT_TRUE(pairs == 50 * 50);
+		SPList copy = spListCopy(list);
+		ASSERT_TRUE(listsEqual(copy, list));
+		spListGetAt(list, 10);
+		spListDestroy(copy);
+		copy = spListCopy(list);
+		// Neither iterators nor spListCopy move the internal iterator
+		ASSERT_TRUE(spListElementGetIndex(spListGetCurrent(list)) == 10);
+		// Removing through an iterator keeps the internal iterator on its element
+		outer = spListIterBegin(list);
+		ASSERT_TRUE(spListIterRemove(&outer) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListElementGetIndex(spListIterGet(&outer)) == 1);
+		ASSERT_TRUE(spListElementGetIndex(spListGetCurrent(list)) == 10);
+		outer = spListIterLast(list);
+		ASSERT_TRUE(spListIterRemove(&outer) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListIterGet(&outer) == NULL);
+		ASSERT_TRUE(spListGetSize(list) == 48 && spListGetSize(copy) == 50);
+		spListDestroy(copy);
+		spListDestroy(list);
+		ASSERT_TRUE(checkIterBackend(backends[b]));
+	}
+	spListElementDestroy(e);
+	return true;
+}
+// Appends elements with indices [from, to) to list
+static bool appendRange(SPList list, int from, int to) {
+	SPListElement e = spListElementCreate(0, 0.0);
+	for (int i = from; i < to; i++) {
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, (double) i);
+		ASSERT_TRUE(spListInsertLast(list, e) == SP_LIST_SUCCESS);
+	}
+	spListElementDestroy(e);
+	return true;
+}
+// Checks that list holds exactly the elements with indices [from, to) in order
+static bool holdsRange(SPList list, int from, int to) {
+	int i = from;
+	ASSERT_TRUE(spListGetSize(list) == to - from);
+	for (SPListIter iter = spListIterBegin(list); spListIterGet(&iter) != NULL;
+			spListIterNext(&iter)) {
+		ASSERT_TRUE(spListElementGetIndex(spListIterGet(&iter)) == i);
+		i++;
+	}
+	ASSERT_TRUE(i == to);
+	return true;
+}
+static bool testListSplice() {
+	SP_LIST_BACKEND backends[3] = {SP_LIST_LINKED_BACKEND, SP_LIST_UNROLLED_BACKEND,
+			SP_LIST_VECTOR_BACKEND};
+	SPListNodePool pool = spListNodePoolCreate(4);
+	SPList list = spListCreate();
+	ASSERT_TRUE(spListConcat(NULL, list) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListSplice(list, NULL) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListConcat(list, list) == SP_LIST_INVALID_ARGUMENT);
+	ASSERT_TRUE(spListSplitAtCurrent(NULL) == NULL);
+	ASSERT_TRUE(spListSplitAtCurrent(list) == NULL);
+	spListDestroy(list);
+	// Linked lists sharing a pool are relinked without copying
+	SPList target = spListCreateWithPool(pool);
+	SPList source = spListCreateWithPool(pool);
+	ASSERT_TRUE(appendRange(target, 0, 10) && appendRange(source, 10, 20));
+	SPListElement moved = spListGetFirst(source);
+	ASSERT_TRUE(spListConcat(target, source) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(holdsRange(target, 0, 20) && spListGetSize(source) == 0);
+	ASSERT_TRUE(spListGetAt(target, 10) == moved);
+	SPList tail = spListSplitAtCurrent(target);
+	ASSERT_TRUE(holdsRange(target, 0, 10) && holdsRange(tail, 10, 20));
+	ASSERT_TRUE(spListGetFirst(tail) == moved);
+	spListGetAt(target, 0);
+	spListDestroy(tail);
+	tail = spListSplitAtCurrent(target); // Takes the whole list
+	ASSERT_TRUE(holdsRange(tail, 0, 10) && spListGetSize(target) == 0);
+	spListDestroy(tail);
+	spListDestroy(target);
+	spListDestroy(source);
+	for (int t = 0; t < 3; t++) {
+		for (int s = 0; s < 3; s++) {
+			target = spListCreateWithBackend(backends[t]);
+			source = spListCreateWithBackend(backends[s]);
+			ASSERT_TRUE(appendRange(target, 0, 40) && appendRange(source, 40, 80));
+			ASSERT_TRUE(spListSplice(target, source) == SP_LIST_INVALID_CURRENT);
+			ASSERT_TRUE(spListConcat(target, source) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(holdsRange(target, 0, 80) && spListGetSize(source) == 0);
+			// Splits in the middle of a block, and at the first element
+			ASSERT_TRUE(spListElementGetIndex(spListGetAt(target, 21)) == 21);
+			tail = spListSplitAtCurrent(target);
+			ASSERT_TRUE(spListGetBackend(tail) == backends[t]);
+			ASSERT_TRUE(holdsRange(target, 0, 21) && holdsRange(tail, 21, 80));
+			spListGetAt(target, 5);
+			SPList middle = spListSplitAtCurrent(target);
+			ASSERT_TRUE(holdsRange(target, 0, 5) && holdsRange(middle, 5, 21));
+			ASSERT_TRUE(appendRange(source, 100, 103));
+			spListGetFirst(tail);
+			ASSERT_TRUE(spListSplice(tail, middle) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(holdsRange(tail, 5, 80) && spListGetSize(middle) == 0);
+			ASSERT_TRUE(spListElementGetIndex(spListGetCurrent(tail)) == 21);
+			ASSERT_TRUE(spListSplice(target, source) == SP_LIST_INVALID_CURRENT);
+			ASSERT_TRUE(spListElementGetIndex(spListGetLast(target)) == 4);
+			ASSERT_TRUE(spListSplice(target, tail) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListGetSize(target) == 80);
+			ASSERT_TRUE(spListElementGetIndex(spListGetCurrent(target)) == 4);
+			ASSERT_TRUE(spListElementGetIndex(spListGetAt(target, 3)) == 3);
+			ASSERT_TRUE(spListElementGetIndex(spListGetNext(target)) == 5);
+			ASSERT_TRUE(spListElementGetIndex(spListGetLast(target)) == 4);
+			spListDestroy(middle);
+			spListDestroy(tail);
+			spListDestroy(source);
+			spListDestroy(target);
+		}
+	}
+	spListNodePoolDestroy(pool);
+	return true;
+}
+static bool testListConcatPools() {
+	// Default linked lists have private pools, and are still relinked without copying
+	SPList target = spListCreate();
+	SPList source = spListCreate();
+	ASSERT_TRUE(appendRange(target, 0, 10) && appendRange(source, 10, 20));
+	SPListElement moved = spListGetFirst(source);
+	ASSERT_TRUE(spListConcat(target, source) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(holdsRange(target, 0, 20) && spListGetSize(source) == 0);
+	ASSERT_TRUE(spListGetAt(target, 10) == moved);
+	ASSERT_TRUE(appendRange(source, 20, 30)); // The source keeps using its pool
+	moved = spListGetFirst(source);
+	ASSERT_TRUE(spListConcat(target, source) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListGetAt(target, 20) == moved);
+	spListDestroy(source); // The nodes it allocated stay valid in target
+	ASSERT_TRUE(holdsRange(target, 0, 30));
+	SPList tail = spListSplitAtCurrent(target); // Shares the borrowed pools as well
+	ASSERT_TRUE(spListGetFirst(tail) == moved && holdsRange(tail, 20, 30));
+	ASSERT_TRUE(spListRemoveCurrent(tail) == SP_LIST_SUCCESS); // Back to the pool of tail
+	ASSERT_TRUE(appendRange(tail, 30, 31));
+	ASSERT_TRUE(holdsRange(target, 0, 20));
+	spListDestroy(target);
+	ASSERT_TRUE(holdsRange(tail, 21, 31));
+	source = spListCreate();
+	ASSERT_TRUE(appendRange(source, 31, 40));
+	spListGetFirst(tail);
+	ASSERT_TRUE(spListSplice(tail, source) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListGetSize(tail) == 19 && spListGetSize(source) == 0);
+	spListDestroy(source);
+	spListDestroy(tail);
+	return true;
+}
+static int compareValues(SPListElement e1, SPListElement e2) {
+	double v1 = spListElementGetValue(e1), v2 = spListElementGetValue(e2);
+	return (v1 > v2) - (v1 < v2);
+}
+static bool testListSort() {
+	SP_LIST_BACKEND backends[3] = {SP_LIST_LINKED_BACKEND, SP_LIST_UNROLLED_BACKEND,
+			SP_LIST_VECTOR_BACKEND};
+	SPListElement e = spListElementCreate(0, 0.0);
+	ASSERT_TRUE(spListSort(NULL, NULL) == SP_LIST_NULL_ARGUMENT);
+	for (int b = 0; b < 3; b++) {
+		for (int size = 0; size < 300; size += 37) {
+			SPList list = spListCreateWithBackend(backends[b]);
+			unsigned int seed = 3;
+			for (int i = 0; i < size; i++) { // Many equal values, indices in insertion order
+				seed = seed * 1103515245 + 12345;
+				spListElementSetIndex(e, i);
+				spListElementSetValue(e, (double) ((seed >> 16) % 10));
+				ASSERT_TRUE(spListInsertLast(list, e) == SP_LIST_SUCCESS);
+			}
+			SPList copy = spListCopy(list);
+			// Stable: equal values keep their insertion order, so indices increase
+			ASSERT_TRUE(spListSort(list, compareValues) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListGetSize(list) == size);
+			SPListElement previous = NULL;
+			SP_LIST_FOREACH(SPListElement, current, list) {
+				ASSERT_TRUE(previous == NULL || spListElementCompare(previous, current) < 0);
+				previous = current;
+			}
+			ASSERT_TRUE(spListGetLast(list) == previous);
+			// The default order, which is spListElementCompare
+			ASSERT_TRUE(spListSort(copy, spListElementCompare) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(listsEqual(copy, list));
+			ASSERT_TRUE(spListSort(copy, NULL) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(listsEqual(copy, list));
+			spListDestroy(copy);
+			spListDestroy(list);
+		}
+	}
+	spListElementDestroy(e);
+	return true;
+}
 int main() {
 	RUN_TEST(testElementCreate);
 	RUN_TEST(testElementCopy);
 	RUN_TEST(testElementCompare);
+	RUN_TEST(testElementCompareEdges);
 	RUN_TEST(testElementGetIndex);
 	RUN_TEST(testIsElementGetValue);
 	RUN_TEST(testElementSetIndex);
@@ -440,5 +881,12 @@ int main() {
 	RUN_TEST(testListClear);
 	RUN_TEST(testListDestroy);
 	RUN_TEST(testListForEach);
+	RUN_TEST(testListPool);
+	RUN_TEST(testListUnrolled);
+	RUN_TEST(testListVector);
+	RUN_TEST(testListIter);
+	RUN_TEST(testListSplice);
+	RUN_TEST(testListConcatPools);
+	RUN_TEST(testListSort);
 	return 0;
 }
@@ -0,0 +1,176 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "unit_test_util.h"
+#include "../SPLogger.h"
+
+#define THREADS_NUM 4
+#define MESSAGES_NUM 5000
+
+// This is a helper function which checks if two files are identical
+static bool identicalFiles(const char* fname1, const char* fname2) {
+	FILE* fp1 = fopen(fname1, "r");
+	FILE* fp2 = fopen(fname2, "r");
+	int ch1 = EOF, ch2 = EOF;
+	if (fp1 != NULL && fp2 != NULL) {
+		do {
+			ch1 = getc(fp1);
+			ch2 = getc(fp2);
+		} while (ch1 != EOF && ch1 == ch2);
+	}
+	if (fp1 != NULL) {
+		fclose(fp1);
+	}
+	if (fp2 != NULL) {
+		fclose(fp2);
+	}
+	return fp1 != NULL && fp2 != NULL && ch1 == ch2;
+}
+
+// Counts the lines of a file, -1 if it cannot be opened
+static int countLines(const char* fname) {
+	FILE* fp = fopen(fname, "r");
+	int ch, lines = 0;
+	if (fp == NULL) {
+		return -1;
+	}
+	while ((ch = getc(fp)) != EOF) {
+		lines += ch == '\n';
+	}
+	fclose(fp);
+	return lines;
+}
+
+static void printAllLevels() {
+	spLoggerPrintError("MSGA","sp_logger_async_unit_test.c","printAllLevels",1);
+	spLoggerPrintWarning("MSGB","sp_logger_async_unit_test.c","printAllLevels",2);
+	spLoggerPrintInfo("MSGC");
+	spLoggerPrintDebug("MSGD","sp_logger_async_unit_test.c","printAllLevels",3);
+}
+
+static void* printMessages(void* arg) {
+	char msg[32];
+	int thread = *(int*) arg;
+	int i; // Generic loop variable
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		sprintf(msg, "%d %d", thread, i);
+		spLoggerPrintMsg(msg);
+	}
+	return NULL;
+}
+
+static bool asyncLoggerOptionsTest() {
+	SPLoggerOptions options = {true, -1, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerOptionsTest.log",SP_LOGGER_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerFlush() == SP_LOGGER_UNDIFINED);
+	ASSERT_TRUE(spLoggerGetDroppedCount() == 0);
+	options.queueCapacity = 0;
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerOptionsTest.log",SP_LOGGER_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerOptionsTest.log",SP_LOGGER_ERROR_LEVEL,&options)
+			== SP_LOGGER_DEFINED);
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines("asyncLoggerOptionsTest.log") == 0);
+	remove("asyncLoggerOptionsTest.log");
+	return true;
+}
+
+//An asynchronous logger writes what a synchronous logger writes
+static bool asyncLoggerSameOutputTest() {
+	SPLoggerOptions options = {true, 2, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	ASSERT_TRUE(spLoggerCreate("syncLoggerOutput.log",SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	printAllLevels();
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerOutput.log",SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	printAllLevels();
+	spLoggerDestroy();
+	ASSERT_TRUE(identicalFiles("syncLoggerOutput.log","asyncLoggerOutput.log"));
+	remove("syncLoggerOutput.log");
+	remove("asyncLoggerOutput.log");
+	return true;
+}
+
+//Messages of many threads are all written, each thread's in order
+static bool asyncLoggerThreadsTest() {
+	SPLoggerOptions options = {true, 64, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	pthread_t threads[THREADS_NUM];
+	int ids[THREADS_NUM];
+	int next[THREADS_NUM] = {0};
+	int thread, i;
+	FILE* fp;
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerThreadsTest.log",SP_LOGGER_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		ids[thread] = thread;
+		ASSERT_TRUE(pthread_create(&threads[thread], NULL, printMessages, &ids[thread]) == 0);
+	}
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		pthread_join(threads[thread], NULL);
+	}
+	spLoggerDestroy(); // Writes the queued messages
+	fp = fopen("asyncLoggerThreadsTest.log", "r");
+	ASSERT_TRUE(fp != NULL);
+	while (fscanf(fp, "%d %d", &thread, &i) == 2) {
+		ASSERT_TRUE(thread >= 0 && thread < THREADS_NUM && next[thread] == i);
+		next[thread]++;
+	}
+	fclose(fp);
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		ASSERT_TRUE(next[thread] == MESSAGES_NUM);
+	}
+	remove("asyncLoggerThreadsTest.log");
+	return true;
+}
+
+//A full queue drops and counts messages
+static bool asyncLoggerDropTest() {
+	SPLoggerOptions options = {true, 2, 0, SP_LOGGER_OVERFLOW_DROP, false, 0, 0, 0};
+	int lines;
+	int i; // Generic loop variable
+	long long dropped;
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerDropTest.log",SP_LOGGER_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		ASSERT_TRUE(spLoggerPrintMsg("dropped or written") == SP_LOGGER_SUCCESS);
+	}
+	ASSERT_TRUE(spLoggerFlush() == SP_LOGGER_SUCCESS);
+	lines = countLines("asyncLoggerDropTest.log"); // Flushed while the logger is alive
+	dropped = spLoggerGetDroppedCount();
+	spLoggerDestroy();
+	ASSERT_TRUE(lines >= 2 && lines + dropped == MESSAGES_NUM);
+	remove("asyncLoggerDropTest.log");
+	return true;
+}
+
+//Messages longer than a record are truncated
+static bool asyncLoggerTruncateTest() {
+	SPLoggerOptions options = {true, 0, 8, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	FILE* fp;
+	char line[32];
+	ASSERT_TRUE(spLoggerCreateWithOptions("asyncLoggerTruncateTest.log",SP_LOGGER_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("0123456789") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("short") == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	fp = fopen("asyncLoggerTruncateTest.log", "r");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "01234567\n") == 0);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "short\n") == 0);
+	fclose(fp);
+	remove("asyncLoggerTruncateTest.log");
+	return true;
+}
+
+int main() {
+	RUN_TEST(asyncLoggerOptionsTest);
+	RUN_TEST(asyncLoggerSameOutputTest);
+	RUN_TEST(asyncLoggerThreadsTest);
+	RUN_TEST(asyncLoggerDropTest);
+	RUN_TEST(asyncLoggerTruncateTest);
+	return 0;
+}
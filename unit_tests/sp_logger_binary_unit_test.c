@@ -0,0 +1,249 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <wchar.h>
+#include <pthread.h>
+#include "unit_test_util.h"
+#include "../SPLogger.h"
+#include "../SPLoggerBinary.h"
+
+#define THREADS_NUM 4
+#define MESSAGES_NUM 5000
+
+// This is a helper function which checks if two files are identical
+static bool identicalFiles(const char* fname1, const char* fname2) {
+	FILE* fp1 = fopen(fname1, "r");
+	FILE* fp2 = fopen(fname2, "r");
+	int ch1 = EOF, ch2 = EOF;
+	if (fp1 != NULL && fp2 != NULL) {
+		do {
+			ch1 = getc(fp1);
+			ch2 = getc(fp2);
+		} while (ch1 != EOF && ch1 == ch2);
+	}
+	if (fp1 != NULL) {
+		fclose(fp1);
+	}
+	if (fp2 != NULL) {
+		fclose(fp2);
+	}
+	return fp1 != NULL && fp2 != NULL && ch1 == ch2;
+}
+
+// Decodes a binary log to a text file
+static SP_LOGGER_MSG decodeFile(const char* binary, const char* text, bool timestamps) {
+	SP_LOGGER_MSG status;
+	FILE* input = fopen(binary, "rb");
+	FILE* output = fopen(text, "w");
+	status = spLoggerBinaryDecode(input, output, timestamps);
+	if (input != NULL) {
+		fclose(input);
+	}
+	if (output != NULL) {
+		fclose(output);
+	}
+	return status;
+}
+
+// Prints messages of every kind of argument, and of the other print functions
+static void printMixed() {
+	static int pointed;
+	const char* word = "binary";
+	short shortNumber = -7;
+	size_t size = 123456789;
+	int i; // Generic loop variable
+	for (i = 0; i < 3; i++) {
+		SP_LOG_ERROR("ints %d %u %x %ld %lld %zu %hd %c %o", -i, 4000000000u, 255 + i, -5L,
+				123456789012LL, size, shortNumber, 'a' + i, 8);
+		SP_LOG_WARNING("floats %5.2f %e %g %Lf", 3.14159, -1e-10, 0.5 * i, (long double) 1.5);
+		SP_LOG_INFO("strings [%-8s|%.3s|%s] %*d|%-*d|%.*f %%", word, word, "", 6, i, 4, i, 2, 2.71828);
+		SP_LOG_DEBUG("pointer %p and no arguments", (void*) &pointed);
+		SP_LOG_DEBUG("plain");
+		SP_LOG_INFO("wide %ls is formatted when printed", L"text");
+		spLoggerPrintError("MSGA", "sp_logger_binary_unit_test.c", "printMixed", 1);
+		spLoggerPrintInfo("MSGC");
+		spLoggerPrintMsg("exact");
+	}
+}
+
+static void* printMessages(void* arg) {
+	int thread = *(int*) arg;
+	int i; // Generic loop variable
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		SP_LOG_INFO("%d %d", thread, i);
+	}
+	return NULL;
+}
+
+//The decoded binary log is the text log
+static bool binaryLoggerSameOutputTest() {
+	SPLoggerOptions sync = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	SPLoggerOptions async = {true, 4, 0, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	ASSERT_TRUE(spLoggerCreate("textLogger.log",SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	printMixed();
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerCreateWithOptions("binaryLogger.bin",SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,&sync)
+			== SP_LOGGER_SUCCESS);
+	printMixed();
+	spLoggerDestroy();
+	ASSERT_TRUE(decodeFile("binaryLogger.bin","binaryLogger.log",false) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(identicalFiles("textLogger.log","binaryLogger.log"));
+	// The sites are defined again in a new log
+	ASSERT_TRUE(spLoggerCreateWithOptions("binaryLogger.bin",SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,&async)
+			== SP_LOGGER_SUCCESS);
+	printMixed();
+	spLoggerDestroy();
+	ASSERT_TRUE(decodeFile("binaryLogger.bin","binaryLogger.log",false) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(identicalFiles("textLogger.log","binaryLogger.log"));
+	remove("textLogger.log");
+	remove("binaryLogger.bin");
+	remove("binaryLogger.log");
+	return true;
+}
+
+//Messages of many threads are all decoded, each thread's in order
+static bool binaryLoggerThreadsTest() {
+	SPLoggerOptions options = {true, 64, 0, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	pthread_t threads[THREADS_NUM];
+	int ids[THREADS_NUM], next[THREADS_NUM] = {0};
+	char line[128];
+	int thread, i, lines = 0;
+	FILE* fp;
+	ASSERT_TRUE(spLoggerCreateWithOptions("binaryLoggerThreads.bin",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		ids[thread] = thread;
+		ASSERT_TRUE(pthread_create(&threads[thread], NULL, printMessages, &ids[thread]) == 0);
+	}
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		pthread_join(threads[thread], NULL);
+	}
+	spLoggerDestroy();
+	ASSERT_TRUE(decodeFile("binaryLoggerThreads.bin","binaryLoggerThreads.log",true) == SP_LOGGER_SUCCESS);
+	fp = fopen("binaryLoggerThreads.log", "r");
+	ASSERT_TRUE(fp != NULL);
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lines++;
+		if (sscanf(line, "- message: %d %d", &thread, &i) == 2) {
+			ASSERT_TRUE(thread >= 0 && thread < THREADS_NUM && i == next[thread]);
+			next[thread]++;
+		}
+	}
+	fclose(fp);
+	ASSERT_TRUE(lines == 3 * THREADS_NUM * MESSAGES_NUM); // A timestamp, a header and a message each
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		ASSERT_TRUE(next[thread] == MESSAGES_NUM);
+	}
+	remove("binaryLoggerThreads.bin");
+	remove("binaryLoggerThreads.log");
+	return true;
+}
+
+//Messages are truncated to fit a small queued record, and still decode (the site
+//definition does not fit either, so the message is formatted when printed)
+static bool binaryLoggerSmallRecordTest() {
+	SPLoggerOptions options = {true, 8, 40, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	char line[128];
+	FILE* fp;
+	ASSERT_TRUE(spLoggerCreateWithOptions("binaryLoggerSmall.bin",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	SP_LOG_INFO("%d:%s", 5, "a string which does not fit in a record");
+	spLoggerPrintMsg("a message which does not fit in a record either");
+	spLoggerDestroy();
+	ASSERT_TRUE(decodeFile("binaryLoggerSmall.bin","binaryLoggerSmall.log",false) == SP_LOGGER_SUCCESS);
+	fp = fopen("binaryLoggerSmall.log", "r");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "---INFO---\n") == 0);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL
+			&& strncmp(line, "- message: 5:a", strlen("- message: 5:a")) == 0
+			&& strlen(line) < strlen("- message: 5:a string which does not fit in a record\n"));
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strncmp(line, "a message", 9) == 0);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) == NULL);
+	fclose(fp);
+	remove("binaryLoggerSmall.bin");
+	remove("binaryLoggerSmall.log");
+	return true;
+}
+
+//Files which are not complete binary logs are rejected
+static bool binaryLoggerDecodeInvalidTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	char bytes[256];
+	size_t length;
+	FILE* fp;
+	ASSERT_TRUE(spLoggerBinaryDecode(NULL, stdout, false) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreate("binaryLoggerInvalid.bin",SP_LOGGER_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	SP_LOG_INFO("text %d", 1);
+	spLoggerDestroy();
+	ASSERT_TRUE(decodeFile("binaryLoggerInvalid.bin","binaryLoggerInvalid.log",false) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreateWithOptions("binaryLoggerInvalid.bin",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	SP_LOG_INFO("binary %d", 1);
+	spLoggerDestroy();
+	fp = fopen("binaryLoggerInvalid.bin", "rb");
+	ASSERT_TRUE(fp != NULL);
+	length = fread(bytes, 1, sizeof(bytes), fp);
+	fclose(fp);
+	ASSERT_TRUE(length > SP_LOGGER_BINARY_HEADER_SIZE + 1);
+	fp = fopen("binaryLoggerInvalid.bin", "wb"); // Cut the last record
+	ASSERT_TRUE(fp != NULL);
+	fwrite(bytes, 1, length - 1, fp);
+	fclose(fp);
+	ASSERT_TRUE(decodeFile("binaryLoggerInvalid.bin","binaryLoggerInvalid.log",false) == SP_LOGGER_INVAlID_ARGUMENT);
+	remove("binaryLoggerInvalid.bin");
+	remove("binaryLoggerInvalid.log");
+	return true;
+}
+
+//Strings with a precision are read only up to it, so they need no '\0' after it
+static bool binaryLoggerPrecisionTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, true, 0, 0, 0};
+	char line[128];
+	char* bytes = (char*) malloc(5); // No '\0'
+	FILE* fp;
+	ASSERT_TRUE(bytes != NULL);
+	memcpy(bytes, "abcde", 5);
+	ASSERT_TRUE(spLoggerCreateWithOptions("binaryLoggerPrecision.bin",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,
+			&options) == SP_LOGGER_SUCCESS);
+	SP_LOG_INFO("%.*s|%.3s|%.0s|%.5s|%.*s|%.10s", 3, bytes, bytes, bytes, bytes, -1, "all", "ab");
+	spLoggerDestroy();
+	free(bytes);
+	ASSERT_TRUE(decodeFile("binaryLoggerPrecision.bin","binaryLoggerPrecision.log",false) == SP_LOGGER_SUCCESS);
+	fp = fopen("binaryLoggerPrecision.log", "r");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "---INFO---\n") == 0);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "- message: abc|abc||abcde|all|ab\n") == 0);
+	fclose(fp);
+	remove("binaryLoggerPrecision.bin");
+	remove("binaryLoggerPrecision.log");
+	return true;
+}
+
+//Argument codes of supported and unsupported formats
+static bool binaryLoggerSignatureTest() {
+	char signature[SP_LOGGER_MAX_SIGNATURE_SIZE];
+	ASSERT_TRUE(spLoggerBinarySignature("%d %u %ld %lu %lld %llu %zu %td %jd", signature));
+	ASSERT_TRUE(strcmp(signature, "iIlLqQztj") == 0);
+	ASSERT_TRUE(spLoggerBinarySignature("%%%*.*f %Lg %s %p %c %hhx", signature));
+	ASSERT_TRUE(strcmp(signature, "iidDspiI") == 0);
+	ASSERT_TRUE(spLoggerBinarySignature("%.*s %*.3s %.0s %.*d %.99999s", signature));
+	ASSERT_TRUE(strcmp(signature, "Psi.3s.0sii.4096s") == 0);
+	ASSERT_FALSE(spLoggerBinarySignature("%n", signature));
+	ASSERT_FALSE(spLoggerBinarySignature("%ls", signature));
+	ASSERT_FALSE(spLoggerBinarySignature("%d%", signature));
+	ASSERT_FALSE(spLoggerBinarySignature("%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d", signature));
+	return true;
+}
+
+int main() {
+	RUN_TEST(binaryLoggerSignatureTest);
+	RUN_TEST(binaryLoggerSameOutputTest);
+	RUN_TEST(binaryLoggerThreadsTest);
+	RUN_TEST(binaryLoggerSmallRecordTest);
+	RUN_TEST(binaryLoggerDecodeInvalidTest);
+	RUN_TEST(binaryLoggerPrecisionTest);
+	return 0;
+}
@@ -0,0 +1,175 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "unit_test_util.h"
+#include "../SPLogger.h"
+
+#define LIMIT_LOG "limitLogger.log"
+#define THREADS_NUM 4
+#define CALLS_NUM 1000
+
+// Counts the lines of a file which contain text, -1 if it cannot be opened
+static int countLines(const char* fname, const char* text) {
+	char line[256];
+	int lines = 0;
+	FILE* fp = fopen(fname, "r");
+	if (fp == NULL) {
+		return -1;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lines += strstr(line, text) != NULL;
+	}
+	fclose(fp);
+	return lines;
+}
+
+// Returns the sum of the counts of the suppression reports of a file
+static long long sumReports(const char* fname) {
+	char line[256];
+	long long sum = 0;
+	unsigned long long count;
+	const char* found;
+	FILE* fp = fopen(fname, "r");
+	if (fp == NULL) {
+		return -1;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		found = strstr(line, "- message: ");
+		if (found != NULL && sscanf(found, "- message: %llu messages of this call site were suppressed",
+				&count) == 1) {
+			sum += (long long) count;
+		}
+	}
+	fclose(fp);
+	return sum;
+}
+
+static void sleepMilliseconds(long ms) {
+	struct timespec wait = {ms / 1000, (ms % 1000) * 1000000L};
+	nanosleep(&wait, NULL);
+}
+
+static void everyNCalls(int calls) {
+	int i; // Generic loop variable
+	for (i = 0; i < calls; i++) {
+		SP_LOG_EVERY_N(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, 10, "sampled %d", i);
+	}
+}
+
+static void limitedCalls(int calls) {
+	int i; // Generic loop variable
+	for (i = 0; i < calls; i++) {
+		SP_LOG_RATE_LIMITED(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, 1.0, 5, "limited %d", i);
+	}
+}
+
+// Calls a site with one token per 1000 seconds every millisecond, for the given time
+static int slowCalls(long ms) {
+	int i; // Generic loop variable
+	for (i = 0; i < ms; i++) {
+		SP_LOG_RATE_LIMITED(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, 0.001, 1, "slow %d", i);
+		sleepMilliseconds(1);
+	}
+	return i;
+}
+
+static void* sampledThread(void* arg) {
+	(void) arg;
+	everyNCalls(CALLS_NUM);
+	return NULL;
+}
+
+//Every n-th call prints, and the first report counts the calls suppressed until then
+static bool limitSampleTest() {
+	ASSERT_TRUE(spLoggerCreate(LIMIT_LOG,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	everyNCalls(CALLS_NUM);
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: sampled") == CALLS_NUM / 10);
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: sampled 10\n") == 1);
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: sampled 11\n") == 0);
+	ASSERT_TRUE(countLines(LIMIT_LOG, "suppressed") >= 1); // At most one report per second
+	ASSERT_TRUE(sumReports(LIMIT_LOG) >= 9 && sumReports(LIMIT_LOG) <= CALLS_NUM - CALLS_NUM / 10);
+	remove(LIMIT_LOG);
+	return true;
+}
+
+//Each thread samples its own calls
+static bool limitSampleThreadsTest() {
+	pthread_t threads[THREADS_NUM];
+	int i; // Generic loop variable
+	ASSERT_TRUE(spLoggerCreate(LIMIT_LOG,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	for (i = 0; i < THREADS_NUM; i++) {
+		ASSERT_TRUE(pthread_create(&threads[i], NULL, sampledThread, NULL) == 0);
+	}
+	for (i = 0; i < THREADS_NUM; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: sampled") == THREADS_NUM * CALLS_NUM / 10);
+	remove(LIMIT_LOG);
+	return true;
+}
+
+//A burst prints at once, then the bucket refills at the given rate
+static bool limitRateTest() {
+	int printed;
+	ASSERT_TRUE(spLoggerCreate(LIMIT_LOG,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	limitedCalls(CALLS_NUM);
+	ASSERT_TRUE(spLoggerFlush() == SP_LOGGER_SUCCESS);
+	printed = countLines(LIMIT_LOG, "message: limited");
+	ASSERT_TRUE(printed >= 5 && printed <= 6); // The burst, and a token if the calls took a second
+	sleepMilliseconds(1100);
+	limitedCalls(SP_LOGGER_MAX_SKIP + 1); // The clock is read again within these calls
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: limited") > printed);
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: limited") <= printed + 2);
+	ASSERT_TRUE(countLines(LIMIT_LOG, "suppressed") >= 2); // In the burst, and before the next message
+	ASSERT_TRUE(sumReports(LIMIT_LOG) >= CALLS_NUM - printed);
+	remove(LIMIT_LOG);
+	return true;
+}
+
+//A site which stays suppressed still reports its suppressed calls periodically
+static bool limitSuppressedReportTest() {
+	int calls;
+	ASSERT_TRUE(spLoggerCreate(LIMIT_LOG,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	calls = slowCalls(1500); // One message, then suppressed calls for at least 1.5 seconds
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines(LIMIT_LOG, "message: slow") == 1);
+	ASSERT_TRUE(countLines(LIMIT_LOG, "suppressed") >= 2); // At the first suppressed call, and a second later
+	ASSERT_TRUE(sumReports(LIMIT_LOG) > calls / 2 && sumReports(LIMIT_LOG) < calls);
+	remove(LIMIT_LOG);
+	return true;
+}
+
+//Filtered calls and invalid arguments
+static bool limitArgumentsTest() {
+	SPLoggerSite site = {SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, "file", "function", 1, "format", 0, 0, ""};
+	SPLoggerLimit limit = {0, 0, 0, 0.0, 0, 0};
+	ASSERT_TRUE(spLoggerCreate(LIMIT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	everyNCalls(CALLS_NUM);
+	limitedCalls(CALLS_NUM);
+	ASSERT_FALSE(spLoggerSample(NULL, &limit, 10));
+	ASSERT_FALSE(spLoggerSample(&site, NULL, 10));
+	ASSERT_FALSE(spLoggerRateLimit(&site, NULL, 1.0, 1));
+	ASSERT_TRUE(spLoggerSample(&site, &limit, 0) && limit.skip == 0);
+	ASSERT_FALSE(spLoggerRateLimit(&site, &limit, 0.0, 1));
+	ASSERT_TRUE(limit.skip == 0); // The next call reads the clock again
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines(LIMIT_LOG, "") == 0);
+	remove(LIMIT_LOG);
+	return true;
+}
+
+int main() {
+	RUN_TEST(limitSampleTest);
+	RUN_TEST(limitSampleThreadsTest);
+	RUN_TEST(limitRateTest);
+	RUN_TEST(limitSuppressedReportTest);
+	RUN_TEST(limitArgumentsTest);
+	return 0;
+}
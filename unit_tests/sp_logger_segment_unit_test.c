@@ -0,0 +1,198 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include "unit_test_util.h"
+#include "../SPLogger.h"
+
+#define SEGMENT_LOG "segmentLogger.log"
+#define MESSAGES_NUM 200
+
+// Returns the size of a file, -1 if it cannot be opened
+static long fileSize(const char* fname) {
+	long size;
+	FILE* fp = fopen(fname, "rb");
+	if (fp == NULL) {
+		return -1;
+	}
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fclose(fp);
+	return size;
+}
+
+// Reads the messages "message <n>" of a segment, checking that they are whole and consecutive from *next
+static bool readSegment(const char* fname, int* next, int* count) {
+	char line[64];
+	int n;
+	FILE* fp = fopen(fname, "r");
+	if (fp == NULL) {
+		return false;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (sscanf(line, "message %d", &n) != 1 || line[strlen(line) - 1] != '\n'
+				|| (*next >= 0 && n != *next)) {
+			fclose(fp);
+			return false;
+		}
+		*next = n + 1;
+		(*count)++;
+	}
+	fclose(fp);
+	return true;
+}
+
+static void removeSegments() {
+	char name[64];
+	int i; // Generic loop variable
+	remove(SEGMENT_LOG);
+	for (i = 1; i < 8; i++) {
+		sprintf(name, "%s.%d", SEGMENT_LOG, i);
+		remove(name);
+	}
+}
+
+// Prints the numbered messages and checks the kept segments, oldest first
+static bool checkRotation(SPLoggerOptions* options, int segmentsNum) {
+	char name[64];
+	int next = -1, count = 0;
+	int i; // Generic loop variable
+	removeSegments();
+	ASSERT_TRUE(spLoggerCreateWithOptions(SEGMENT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,options)
+			== SP_LOGGER_SUCCESS);
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		sprintf(name, "message %03d", i);
+		ASSERT_TRUE(spLoggerPrintMsg(name) == SP_LOGGER_SUCCESS);
+	}
+	spLoggerDestroy();
+	for (i = segmentsNum - 1; i >= 1; i--) {
+		sprintf(name, "%s.%d", SEGMENT_LOG, i);
+		ASSERT_TRUE(fileSize(name) > 0 && fileSize(name) <= options->segmentSize);
+		ASSERT_TRUE(readSegment(name, &next, &count));
+	}
+	sprintf(name, "%s.%d", SEGMENT_LOG, segmentsNum);
+	ASSERT_TRUE(fileSize(name) == -1);
+	ASSERT_TRUE(fileSize(SEGMENT_LOG) <= options->segmentSize);
+	ASSERT_TRUE(readSegment(SEGMENT_LOG, &next, &count));
+	ASSERT_TRUE(next == MESSAGES_NUM); // The last message is in the current segment
+	ASSERT_TRUE(count < MESSAGES_NUM); // The oldest segments were removed
+	removeSegments();
+	return true;
+}
+
+//A full segment rolls over, and only the newest segments are kept
+static bool segmentRotationTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 256, 3};
+	ASSERT_TRUE(checkRotation(&options, 3));
+	options.segmentsNum = 1;
+	ASSERT_TRUE(checkRotation(&options, 1));
+	return true;
+}
+
+//Staged and asynchronous loggers write whole messages to segments
+static bool segmentModesTest() {
+	SPLoggerOptions staged = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 64, 256, 2};
+	SPLoggerOptions async = {true, 16, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 256, 0};
+	ASSERT_TRUE(checkRotation(&staged, 2));
+	ASSERT_TRUE(checkRotation(&async, 4));
+	return true;
+}
+
+//The messages are in the mapped segment before the logger is destroyed
+static bool segmentFlushTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 4096, 2};
+	char content[16] = {0};
+	FILE* fp;
+	removeSegments();
+	ASSERT_TRUE(spLoggerCreateWithOptions(SEGMENT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(fileSize(SEGMENT_LOG) == 4096);
+	ASSERT_TRUE(spLoggerPrintMsg("visible") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerFlush() == SP_LOGGER_SUCCESS);
+	fp = fopen(SEGMENT_LOG, "r");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fread(content, 1, 9, fp) == 9);
+	fclose(fp);
+	ASSERT_TRUE(strcmp(content, "visible\n") == 0); // Followed by zero bytes
+	spLoggerDestroy();
+	ASSERT_TRUE(fileSize(SEGMENT_LOG) == 8);
+	removeSegments();
+	return true;
+}
+
+//A segment which cannot be opened is retried without shifting the kept segments again
+static bool segmentOpenFailureTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 256, 3};
+	struct rlimit saved, limited;
+	char name[64];
+	int next = -1, count = 0, written = 0, failed = 0;
+	int i; // Generic loop variable
+	removeSegments();
+	ASSERT_TRUE(spLoggerCreateWithOptions(SEGMENT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	for (i = 0; i < 40; i++) { // Fills the current segment and two kept ones
+		sprintf(name, "message %03d", i);
+		ASSERT_TRUE(spLoggerPrintMsg(name) == SP_LOGGER_SUCCESS);
+	}
+	ASSERT_TRUE(getrlimit(RLIMIT_FSIZE, &saved) == 0);
+	limited = saved;
+	limited.rlim_cur = 64; // New segments cannot be allocated
+	signal(SIGXFSZ, SIG_IGN);
+	ASSERT_TRUE(setrlimit(RLIMIT_FSIZE, &limited) == 0);
+	for (i = 40; i < 80; i++) { // No assertions, their output may be a file
+		sprintf(name, "message %03d", i);
+		if (spLoggerPrintMsg(name) == SP_LOGGER_SUCCESS) {
+			written = i + 1; // Until the current segment is full
+		} else {
+			failed++;
+		}
+	}
+	setrlimit(RLIMIT_FSIZE, &saved);
+	signal(SIGXFSZ, SIG_DFL);
+	spLoggerDestroy();
+	ASSERT_TRUE(failed > 0 && failed == 80 - written);
+	sprintf(name, "%s.2", SEGMENT_LOG);
+	ASSERT_TRUE(readSegment(name, &next, &count));
+	sprintf(name, "%s.1", SEGMENT_LOG);
+	ASSERT_TRUE(readSegment(name, &next, &count));
+	ASSERT_TRUE(next == written && count >= 30); // The segments written before the failure are kept
+	ASSERT_TRUE(fileSize(SEGMENT_LOG) == 0);
+	removeSegments();
+	return true;
+}
+
+//Segments need a file name and a text logger
+static bool segmentInvalidOptionsTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 256, 2};
+	ASSERT_TRUE(spLoggerCreateWithOptions(NULL,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	options.binary = true;
+	ASSERT_TRUE(spLoggerCreateWithOptions(SEGMENT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	options.binary = false;
+	options.segmentsNum = -1;
+	ASSERT_TRUE(spLoggerCreateWithOptions(SEGMENT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	options.segmentsNum = 2;
+	options.segmentSize = -1;
+	ASSERT_TRUE(spLoggerCreateWithOptions(SEGMENT_LOG,SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreateWithOptions("no_such_dir/segment.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	options.segmentSize = 256;
+	ASSERT_TRUE(spLoggerCreateWithOptions("no_such_dir/segment.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_CANNOT_OPEN_FILE);
+	return true;
+}
+
+int main() {
+	RUN_TEST(segmentRotationTest);
+	RUN_TEST(segmentModesTest);
+	RUN_TEST(segmentFlushTest);
+	RUN_TEST(segmentInvalidOptionsTest);
+	RUN_TEST(segmentOpenFailureTest);
+	return 0;
+}
@@ -0,0 +1,293 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "unit_test_util.h"
+#include "../SPLogger.h"
+#include "../SPLoggerBinary.h"
+
+#define THREADS_NUM 4
+#define MESSAGES_NUM 5000
+#define RACE_ROUNDS 200
+
+static bool raceDone = false;
+static bool printingDone = false;
+
+// Counts the lines of a file, -1 if it cannot be opened
+static int countLines(const char* fname) {
+	FILE* fp = fopen(fname, "r");
+	int ch, lines = 0;
+	if (fp == NULL) {
+		return -1;
+	}
+	while ((ch = getc(fp)) != EOF) {
+		lines += ch == '\n';
+	}
+	fclose(fp);
+	return lines;
+}
+
+// Checks that a file has at least the given number of lines, without reading past them
+static bool hasLines(const char* fname, int lines) {
+	FILE* fp = fopen(fname, "r");
+	int ch;
+	if (fp == NULL) {
+		return false;
+	}
+	while (lines > 0 && (ch = getc(fp)) != EOF) {
+		lines -= ch == '\n';
+	}
+	fclose(fp);
+	return lines <= 0;
+}
+
+// Checks that each message line of a log is whole and that each thread's messages are in order
+static bool messagesInOrder(const char* fname, const char* prefix, int expected) {
+	char line[128];
+	int next[THREADS_NUM] = {0};
+	int thread, i, found = 0;
+	size_t prefixLength = strlen(prefix);
+	FILE* fp = fopen(fname, "r");
+	if (fp == NULL) {
+		return false;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (strncmp(line, prefix, prefixLength) != 0) {
+			continue;
+		}
+		if (sscanf(line + prefixLength, "%d %d", &thread, &i) != 2 || thread < 0
+				|| thread >= THREADS_NUM || i != next[thread]) {
+			fclose(fp);
+			return false;
+		}
+		next[thread]++;
+		found++;
+	}
+	fclose(fp);
+	return found == expected;
+}
+
+static void* printMessages(void* arg) {
+	char msg[32];
+	int thread = *(int*) arg;
+	int i; // Generic loop variable
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		sprintf(msg, "%d %d", thread, i);
+		spLoggerPrintMsg(msg);
+	}
+	return NULL;
+}
+
+static void* printRecords(void* arg) {
+	int thread = *(int*) arg;
+	int i; // Generic loop variable
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		spLoggerLogf(SP_LOGGER_INFO_WARNING_ERROR_LEVEL, NULL, NULL, 0, "%d %d", thread, i);
+	}
+	return NULL;
+}
+
+static void* printSites(void* arg) {
+	int thread = *(int*) arg;
+	int i; // Generic loop variable
+	for (i = 0; i < MESSAGES_NUM; i++) {
+		SP_LOG_INFO("%d %d", thread, i);
+	}
+	return NULL;
+}
+
+// Runs a print function on THREADS_NUM threads and waits for them, so their staging buffers are drained
+static bool runThreads(void* (*print)(void*)) {
+	pthread_t threads[THREADS_NUM];
+	int ids[THREADS_NUM];
+	int thread; // Generic loop variable
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		ids[thread] = thread;
+		if (pthread_create(&threads[thread], NULL, print, &ids[thread]) != 0) {
+			return false;
+		}
+	}
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		pthread_join(threads[thread], NULL);
+	}
+	return true;
+}
+
+//Messages of a synchronous logger printed by many threads are whole
+static bool syncLoggerThreadsTest() {
+	ASSERT_TRUE(spLoggerCreate("syncLoggerThreads.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(runThreads(printMessages));
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines("syncLoggerThreads.log") == THREADS_NUM * MESSAGES_NUM);
+	ASSERT_TRUE(messagesInOrder("syncLoggerThreads.log", "", THREADS_NUM * MESSAGES_NUM));
+	remove("syncLoggerThreads.log");
+	return true;
+}
+
+//Staged messages of many lines are written whole, when the threads exit
+static bool stagingThreadsTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 1000, 0, 0};
+	ASSERT_TRUE(spLoggerCreateWithOptions("stagingThreads.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(runThreads(printRecords));
+	spLoggerDestroy(); // The threads have exited, so their buffers are no longer registered
+	ASSERT_TRUE(countLines("stagingThreads.log") == 2 * THREADS_NUM * MESSAGES_NUM);
+	ASSERT_TRUE(messagesInOrder("stagingThreads.log", "- message: ", THREADS_NUM * MESSAGES_NUM));
+	remove("stagingThreads.log");
+	return true;
+}
+
+//Staged messages are written by flush and destroy
+static bool stagingFlushTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 4096, 0, 0};
+	ASSERT_TRUE(spLoggerCreateWithOptions("stagingFlush.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("first") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(countLines("stagingFlush.log") == 0);
+	ASSERT_TRUE(spLoggerFlush() == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(countLines("stagingFlush.log") == 1);
+	ASSERT_TRUE(spLoggerPrintMsg("second") == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	ASSERT_TRUE(countLines("stagingFlush.log") == 2);
+	options.stagingSize = -1;
+	ASSERT_TRUE(spLoggerCreateWithOptions("stagingFlush.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_INVAlID_ARGUMENT);
+	remove("stagingFlush.log");
+	return true;
+}
+
+//Staged binary records decode, since call sites are defined before they are staged
+static bool stagingBinaryTest() {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, true, 512, 0, 0};
+	FILE* input;
+	FILE* output;
+	ASSERT_TRUE(spLoggerCreateWithOptions("stagingBinary.bin",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options)
+			== SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(runThreads(printSites));
+	spLoggerDestroy();
+	input = fopen("stagingBinary.bin", "rb");
+	output = fopen("stagingBinary.log", "w");
+	ASSERT_TRUE(spLoggerBinaryDecode(input, output, false) == SP_LOGGER_SUCCESS);
+	fclose(input);
+	fclose(output);
+	ASSERT_TRUE(messagesInOrder("stagingBinary.log", "- message: ", THREADS_NUM * MESSAGES_NUM));
+	remove("stagingBinary.bin");
+	remove("stagingBinary.log");
+	return true;
+}
+
+static void* printWhileRacing(void* arg) {
+	SP_LOGGER_MSG status;
+	bool* valid = (bool*) arg;
+	while (!__atomic_load_n(&raceDone, __ATOMIC_ACQUIRE)) {
+		status = spLoggerPrintMsg("racing");
+		if (status != SP_LOGGER_SUCCESS && status != SP_LOGGER_UNDIFINED) {
+			*valid = false;
+		}
+	}
+	return NULL;
+}
+
+static void* createAndDestroy(void* arg) {
+	SPLoggerOptions options = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 256, 0, 0};
+	SP_LOGGER_MSG status;
+	bool* valid = (bool*) arg;
+	int i; // Generic loop variable
+	for (i = 0; i < RACE_ROUNDS; i++) {
+		options.async = i % 2 == 0;
+		status = spLoggerCreateWithOptions("loggerRace.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,&options);
+		if (status != SP_LOGGER_SUCCESS && status != SP_LOGGER_DEFINED) {
+			*valid = false;
+		}
+		spLoggerDestroy();
+	}
+	return NULL;
+}
+
+//Create and destroy may race with each other and with print calls
+static bool createDestroyRaceTest() {
+	pthread_t printers[2], creators[2];
+	bool valid[4] = {true, true, true, true};
+	int thread; // Generic loop variable
+	for (thread = 0; thread < 2; thread++) {
+		ASSERT_TRUE(pthread_create(&printers[thread], NULL, printWhileRacing, &valid[thread]) == 0);
+		ASSERT_TRUE(pthread_create(&creators[thread], NULL, createAndDestroy, &valid[2 + thread]) == 0);
+	}
+	for (thread = 0; thread < 2; thread++) {
+		pthread_join(creators[thread], NULL);
+	}
+	__atomic_store_n(&raceDone, true, __ATOMIC_RELEASE);
+	for (thread = 0; thread < 2; thread++) {
+		pthread_join(printers[thread], NULL);
+	}
+	for (thread = 0; thread < 4; thread++) {
+		ASSERT_TRUE(valid[thread]);
+	}
+	ASSERT_TRUE(spLoggerPrintMsg("done") == SP_LOGGER_UNDIFINED);
+	remove("loggerRace.log");
+	return true;
+}
+
+static void* printUntilDone(void* arg) {
+	SP_LOGGER_MSG status;
+	bool* valid = (bool*) arg;
+	int i; // Generic loop variable
+	for (i = 0; !__atomic_load_n(&printingDone, __ATOMIC_ACQUIRE); i++) {
+		SP_LOG_INFO("printing %d", i);
+		status = spLoggerLogf(SP_LOGGER_INFO_WARNING_ERROR_LEVEL, NULL, NULL, 0, "printing %d", i);
+		if (status != SP_LOGGER_SUCCESS && status != SP_LOGGER_UNDIFINED) {
+			*valid = false;
+		}
+	}
+	return NULL;
+}
+
+// Destroys a logger created with the given options while THREADS_NUM threads print to it
+static bool destroyWhilePrinting(const SPLoggerOptions* options) {
+	pthread_t threads[THREADS_NUM];
+	bool valid[THREADS_NUM];
+	int thread; // Generic loop variable
+	__atomic_store_n(&printingDone, false, __ATOMIC_RELEASE);
+	ASSERT_TRUE(spLoggerCreateWithOptions("destroyPrinting.log",SP_LOGGER_INFO_WARNING_ERROR_LEVEL,options)
+			== SP_LOGGER_SUCCESS);
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		valid[thread] = true;
+		ASSERT_TRUE(pthread_create(&threads[thread], NULL, printUntilDone, &valid[thread]) == 0);
+	}
+	while (!hasLines("destroyPrinting.log", 100)) {
+		spLoggerFlush();
+	}
+	spLoggerDestroy(); // The threads are still printing
+	ASSERT_TRUE(spLoggerPrintMsg("destroyed") == SP_LOGGER_UNDIFINED);
+	__atomic_store_n(&printingDone, true, __ATOMIC_RELEASE);
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		pthread_join(threads[thread], NULL);
+	}
+	for (thread = 0; thread < THREADS_NUM; thread++) {
+		ASSERT_TRUE(valid[thread]);
+	}
+	remove("destroyPrinting.log");
+	return true;
+}
+
+//A logger may be destroyed while other threads print to it
+static bool destroyWhilePrintingTest() {
+	SPLoggerOptions staged = {false, 0, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 256, 0, 0};
+	SPLoggerOptions async = {true, 64, 0, SP_LOGGER_OVERFLOW_BLOCK, false, 0, 0, 0};
+	ASSERT_TRUE(destroyWhilePrinting(NULL));
+	ASSERT_TRUE(destroyWhilePrinting(&staged));
+	ASSERT_TRUE(destroyWhilePrinting(&async));
+	return true;
+}
+
+int main() {
+	RUN_TEST(syncLoggerThreadsTest);
+	RUN_TEST(stagingThreadsTest);
+	RUN_TEST(stagingFlushTest);
+	RUN_TEST(stagingBinaryTest);
+	RUN_TEST(createDestroyRaceTest);
+	RUN_TEST(destroyWhilePrintingTest);
+	return 0;
+}
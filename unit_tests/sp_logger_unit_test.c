@@ -3,7 +3,7 @@
 #include <stdio.h>
 #include "unit_test_util.h" //SUPPORTING MACROS ASSERT_TRUE/ASSERT_FALSE etc..
 #include "../SPLogger.h"
-
+#include <string.h>
 
 // This is a helper function which checks if two files are identical
 static bool identicalFiles(const char* fname1, const char* fname2) {
@@ -97,11 +97,115 @@ static bool basicLoggerWarningTest() {
 	ASSERT_TRUE(identicalFiles(testFile,expectedFile));
 	return true;
 }
+
+// This is a helper function which reads up to size - 1 bytes of a file into buffer
+static size_t readFile(const char* fname, char* buffer, size_t size) {
+	size_t length;
+	FILE* fp = fopen(fname, "r");
+	if (fp == NULL) {
+		return 0;
+	}
+	length = fread(buffer, 1, size - 1, fp);
+	buffer[length] = '\0';
+	fclose(fp);
+	return length;
+}
+
+//Formatted messages get the header of their level and are filtered by the logger level
+static bool loggerLogfTest() {
+	const char* testFile = "loggerLogfTest.log";
+	char content[512];
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_ERROR_LEVEL,"f.c","g",1,"%d",1) == SP_LOGGER_UNDIFINED);
+	ASSERT_TRUE(spLoggerCreate(testFile,SP_LOGGER_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_ERROR_LEVEL,"f.c","g",7,"%d-%s",42,"A") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_WARNING_ERROR_LEVEL,"f.c","g",8,"%.2f",0.5) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_INFO_WARNING_ERROR_LEVEL,NULL,NULL,-1,"%c",'C') == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,"f.c","g",9,"D") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_ERROR_LEVEL,"f.c","g",1,NULL) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_ERROR_LEVEL,NULL,"g",1,"x") == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_WARNING_ERROR_LEVEL,"f.c",NULL,1,"x") == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,"f.c","g",-1,"x") == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerLogf((SP_LOGGER_LEVEL) 7,"f.c","g",1,"x") == SP_LOGGER_INVAlID_ARGUMENT);
+	spLoggerDestroy();
+	readFile(testFile, content, sizeof(content));
+	ASSERT_TRUE(strcmp(content,
+			"---ERROR---\n- file: f.c\n- function: g\n- line: 7\n- message: 42-A\n"
+			"---WARNING---\n- file: f.c\n- function: g\n- line: 8\n- message: 0.50\n"
+			"---INFO---\n- message: C\n") == 0);
+	return true;
+}
+
+//Long messages are truncated, and constant messages can be printed
+static bool loggerLongMessageTest() {
+	const char* testFile = "loggerLongMessageTest.log";
+	static char message[3 * SP_LOGGER_MAX_MESSAGE_SIZE];
+	static char content[4 * SP_LOGGER_MAX_MESSAGE_SIZE];
+	const char* header = "---INFO---\n- message: ";
+	size_t length;
+	memset(message, 'x', sizeof(message) - 1);
+	message[sizeof(message) - 1] = '\0';
+	ASSERT_TRUE(spLoggerCreate(testFile,SP_LOGGER_INFO_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("constant") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintInfo(message) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerLogf(SP_LOGGER_INFO_WARNING_ERROR_LEVEL,NULL,NULL,0,"%s%s",message,message) == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	length = readFile(testFile, content, sizeof(content));
+	ASSERT_TRUE(length == strlen("constant\n") + 2 * SP_LOGGER_MAX_MESSAGE_SIZE);
+	ASSERT_TRUE(strncmp(content, "constant\n", strlen("constant\n")) == 0);
+	ASSERT_TRUE(strncmp(content + strlen("constant\n"), header, strlen(header)) == 0);
+	ASSERT_TRUE(content[strlen("constant\n") + SP_LOGGER_MAX_MESSAGE_SIZE - 2] == 'x');
+	ASSERT_TRUE(content[strlen("constant\n") + SP_LOGGER_MAX_MESSAGE_SIZE - 1] == '\n');
+	ASSERT_TRUE(content[length - 1] == '\n');
+	return true;
+}
+
+// This is a helper function which counts its calls, to check if a logging argument is evaluated
+static int countedCalls = 0;
+static int countCall() {
+	return ++countedCalls;
+}
+
+//The macros print the call site, and skip filtered messages without evaluating their arguments
+static bool loggerMacrosTest() {
+	const char* testFile = "loggerMacrosTest.log";
+	char content[512], expected[512];
+	int line;
+	countedCalls = 0;
+	SP_LOG_ERROR("%d", countCall()); // The logger is undefined
+	ASSERT_TRUE(countedCalls == 0);
+	ASSERT_TRUE(spLoggerCreate(testFile,SP_LOGGER_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	SP_LOG_INFO("%d", countCall());
+	SP_LOG_DEBUG("%d", countCall());
+	ASSERT_TRUE(countedCalls == 0);
+	line = __LINE__ + 1;
+	SP_LOG_WARNING("call %d", countCall());
+	ASSERT_TRUE(countedCalls == 1);
+#undef SP_LOGGER_MIN_LEVEL
+#define SP_LOGGER_MIN_LEVEL 0 // Only errors are compiled from here
+	SP_LOG_WARNING("%d", countCall());
+	ASSERT_TRUE(countedCalls == 1);
+	SP_LOG_ERROR("%d", countCall());
+	ASSERT_TRUE(countedCalls == 2);
+#undef SP_LOGGER_MIN_LEVEL
+#define SP_LOGGER_MIN_LEVEL 3
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerEnabledLevel == -1);
+	readFile(testFile, content, sizeof(content));
+	sprintf(expected, "---WARNING---\n- file: %s\n- function: %s\n- line: %d\n- message: call 1\n"
+			"---ERROR---\n- file: %s\n- function: %s\n- line: %d\n- message: 2\n",
+			__FILE__, __func__, line, __FILE__, __func__, line + 6);
+	ASSERT_TRUE(strcmp(content, expected) == 0);
+	return true;
+}
+
 int main() {
 	RUN_TEST(basicLoggerTest);
 	RUN_TEST(basicLoggerErrorTest);
 	RUN_TEST(basicLoggerDebugTest);
 	RUN_TEST(basicLoggerInfoTest);
 	RUN_TEST(basicLoggerWarningTest);
+	RUN_TEST(loggerLogfTest);
+	RUN_TEST(loggerLongMessageTest);
+	RUN_TEST(loggerMacrosTest);
 	return 0;
 }
@@ -0,0 +1,194 @@
+#include "../SPSkipList.h"
+#include "../SPList.h"
+#include "../SPListElement.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Inserts a copy of element into a sorted list, after the elements equal to it
+static void sortedInsert(SPList reference, SPListElement element) {
+	SPListElement iter = spListGetFirst(reference);
+	while (iter != NULL && spListElementCompare(iter, element) <= 0) {
+		iter = spListGetNext(reference);
+	}
+	if (iter == NULL) {
+		spListInsertLast(reference, element);
+	} else {
+		spListInsertBeforeCurrent(reference, element);
+	}
+}
+
+// Checks that the skip list holds the elements of the sorted reference list, in both directions
+static bool sameElements(SPSkipList list, SPList reference) {
+	SPListElement e1, e2;
+	ASSERT_TRUE(spSkipListGetSize(list) == spListGetSize(reference));
+	for (e1 = spSkipListGetFirst(list), e2 = spListGetFirst(reference); e2 != NULL;
+			e1 = spSkipListGetNext(list), e2 = spListGetNext(reference)) {
+		ASSERT_TRUE(e1 != NULL && spListElementCompare(e1, e2) == 0);
+	}
+	ASSERT_TRUE(e1 == NULL);
+	for (e1 = spSkipListGetLast(list), e2 = spListGetLast(reference); e2 != NULL;
+			e1 = spSkipListGetPrevious(list), e2 = spListGetPrevious(reference)) {
+		ASSERT_TRUE(e1 != NULL && spListElementCompare(e1, e2) == 0);
+	}
+	ASSERT_TRUE(e1 == NULL);
+	return true;
+}
+
+bool skipListInputTest(){
+	// Function variables
+	SPSkipList list = spSkipListCreate();
+	SPListElement e1 = spListElementCreate(1,1.0);
+	// Assertions
+	ASSERT_TRUE(list != NULL);
+	ASSERT_TRUE(spSkipListGetSize(NULL) == -1);
+	ASSERT_TRUE(spSkipListGetSize(list) == 0);
+	ASSERT_TRUE(spSkipListInsert(NULL,e1) == SP_SKIP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spSkipListInsert(list,NULL) == SP_SKIP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spSkipListRemove(list,e1) == SP_SKIP_LIST_NOT_FOUND);
+	ASSERT_TRUE(spSkipListRemoveFirst(list) == SP_SKIP_LIST_EMPTY);
+	ASSERT_TRUE(spSkipListRemoveLast(NULL) == SP_SKIP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spSkipListRemoveCurrent(list) == SP_SKIP_LIST_INVALID_CURRENT);
+	ASSERT_TRUE(spSkipListMin(list) == NULL && spSkipListMax(list) == NULL);
+	ASSERT_TRUE(spSkipListGetFirst(list) == NULL && spSkipListGetNext(list) == NULL);
+	ASSERT_TRUE(spSkipListInsert(list,e1) == SP_SKIP_LIST_SUCCESS);
+	ASSERT_TRUE(spSkipListMin(list) == spSkipListMax(list));
+	ASSERT_TRUE(spListElementCompare(spSkipListMin(list),e1) == 0);
+	ASSERT_TRUE(spSkipListMin(list) != e1); // A copy is stored
+	ASSERT_TRUE(spSkipListClear(list) == SP_SKIP_LIST_SUCCESS);
+	ASSERT_TRUE(spSkipListGetSize(list) == 0 && spSkipListMin(list) == NULL);
+	ASSERT_TRUE(spSkipListClear(NULL) == SP_SKIP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spSkipListCopy(NULL) == NULL);
+	// Deallocation
+	spSkipListDestroy(list);
+	spSkipListDestroy(NULL);
+	spListElementDestroy(e1);
+	return true;
+}
+
+// Applies random operations to a skip list and to a sorted reference list
+bool skipListRandomTest(){
+	// Function variables
+	int i, position, operation;
+	// Skip list variables
+	SPSkipList list = spSkipListCreate();
+	SPSkipList copy;
+	SPList reference = spListCreateWithBackend(SP_LIST_VECTOR_BACKEND);
+	SPListElement e = spListElementCreate(0,0.0);
+	srand(2016);
+	for (i = 0; i < 6000; i++) {
+		operation = rand() % 10;
+		if (i > 4500) { // Drain the lists
+			operation = 7 + rand() % 3;
+		}
+		if (operation < 6 || spListGetSize(reference) == 0) { // Many equal elements
+			spListElementSetIndex(e, rand() % 30);
+			spListElementSetValue(e, (double) (rand() % 20));
+			ASSERT_TRUE(spSkipListInsert(list,e) == SP_SKIP_LIST_SUCCESS);
+			sortedInsert(reference, e);
+		} else if (operation == 6) { // Remove an element equal to a random one
+			position = rand() % spListGetSize(reference);
+			spListElementSetIndex(e, spListElementGetIndex(spListGetAt(reference, position)));
+			spListElementSetValue(e, spListElementGetValue(spListGetAt(reference, position)));
+			ASSERT_TRUE(spSkipListRemove(list,e) == SP_SKIP_LIST_SUCCESS);
+			spListRemoveCurrent(reference);
+		} else if (operation == 7) {
+			ASSERT_TRUE(spSkipListRemoveFirst(list) == SP_SKIP_LIST_SUCCESS);
+			spListGetFirst(reference);
+			spListRemoveCurrent(reference);
+		} else if (operation == 8) {
+			ASSERT_TRUE(spSkipListRemoveLast(list) == SP_SKIP_LIST_SUCCESS);
+			spListGetLast(reference);
+			spListRemoveCurrent(reference);
+		} else { // Remove through the internal iterator
+			position = rand() % spListGetSize(reference);
+			spSkipListGetFirst(list);
+			spListGetAt(reference, position);
+			while (position-- > 0) {
+				spSkipListGetNext(list);
+			}
+			ASSERT_TRUE(spSkipListRemoveCurrent(list) == SP_SKIP_LIST_SUCCESS);
+			ASSERT_TRUE(spSkipListGetCurrent(list) == NULL);
+			spListRemoveCurrent(reference);
+		}
+		if (spListGetSize(reference) > 0) {
+			ASSERT_TRUE(spListElementCompare(spSkipListMin(list), spListGetFirst(reference)) == 0);
+			ASSERT_TRUE(spListElementCompare(spSkipListMax(list), spListGetLast(reference)) == 0);
+		}
+		if (i % 500 == 0) {
+			ASSERT_TRUE(sameElements(list, reference));
+			copy = spSkipListCopy(list);
+			ASSERT_TRUE(sameElements(copy, reference));
+			ASSERT_TRUE(spSkipListInsert(copy,e) == SP_SKIP_LIST_SUCCESS); // The copy is independent
+			ASSERT_TRUE(spSkipListGetSize(copy) == spListGetSize(reference) + 1);
+			spSkipListDestroy(copy);
+		}
+	}
+	ASSERT_TRUE(sameElements(list, reference));
+	// Deallocation
+	spSkipListDestroy(list);
+	spListDestroy(reference);
+	spListElementDestroy(e);
+	return true;
+}
+
+bool skipListForEachTest(){
+	// Function variables
+	int i;
+	double previous = -1.0;
+	// Skip list variables
+	SPSkipList list = spSkipListCreate();
+	SPListElement e = spListElementCreate(0,0.0);
+	for (i = 0; i < 100; i++) { // Inserted in descending order
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, 100.0 - i);
+		spSkipListInsert(list,e);
+	}
+	i = 0;
+	SP_SKIP_LIST_FOREACH(SPListElement, current, list) {
+		ASSERT_TRUE(spListElementGetValue(current) > previous);
+		previous = spListElementGetValue(current);
+		i++;
+	}
+	ASSERT_TRUE(i == 100);
+	// Deallocation
+	spSkipListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+bool skipListToArrayTest(){
+	// Function variables
+	int i;
+	int indices[10];
+	double values[10];
+	// Skip list variables
+	SPSkipList list = spSkipListCreate();
+	SPListElement e = spListElementCreate(0,0.0);
+	for (i = 0; i < 10; i++) { // Inserted in descending order
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, 10.0 - i);
+		spSkipListInsert(list,e);
+	}
+	ASSERT_TRUE(spSkipListToArray(NULL, indices, values) == -1);
+	ASSERT_TRUE(spSkipListToArray(list, NULL, values) == -1);
+	spSkipListGetFirst(list);
+	spSkipListGetNext(list); // The iterator points at the second element
+	ASSERT_TRUE(spSkipListToArray(list, indices, values) == 10);
+	for (i = 0; i < 10; i++) {
+		ASSERT_TRUE(indices[i] == 9 - i && values[i] == 1.0 + i);
+	}
+	ASSERT_TRUE(spListElementGetIndex(spSkipListGetCurrent(list)) == 8); // Unchanged
+	// Deallocation
+	spSkipListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+int main() {
+	RUN_TEST(skipListInputTest);
+	RUN_TEST(skipListRandomTest);
+	RUN_TEST(skipListForEachTest);
+	RUN_TEST(skipListToArrayTest);
+	return 0;
+}
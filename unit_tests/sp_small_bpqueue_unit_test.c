@@ -0,0 +1,114 @@
+#include "../SPSmallBPQueue.h"
+#include "../SPBPriorityQueue.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+bool smallQueueInitTest(){
+	// SPSmallBPQueue variables
+	SPSmallBPQueue q1;
+	// Assertions
+	ASSERT_TRUE(spSmallBPQueueInit(NULL, 2) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueueInit(&q1, -1) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueueInit(&q1, SP_SMALL_BPQUEUE_CAPACITY + 1) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueueInit(&q1, SP_SMALL_BPQUEUE_CAPACITY) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spSmallBPQueueInit(&q1, 0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spSmallBPQueueIsEmpty(&q1));
+	ASSERT_TRUE(spSmallBPQueueIsFull(&q1));
+	ASSERT_TRUE(spSmallBPQueueOffer(&q1, 1, 1.0) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spSmallBPQueueSize(&q1) == 0);
+	ASSERT_TRUE(spSmallBPQueueSize(NULL) == -1);
+	ASSERT_TRUE(spSmallBPQueueGetMaxSize(NULL) == -1);
+	ASSERT_TRUE(spSmallBPQueueGetMaxSize(&q1) == 0);
+	return true;
+}
+
+bool smallQueueEnqueueTest(){
+	// Function variables
+	int i; // Generic loop variable
+	// SPSmallBPQueue variables
+	SPSmallBPQueue q1;
+	SPListElement e1 = spListElementCreate(1,1);
+	SPListElement e2 = spListElementCreate(3,2);
+	SPListElement e3 = spListElementCreate(2,2);
+	SPListElement order[3] = {e1,e3,e3};
+	SPListElement temp; // temporary variable to hold peek's return element
+	spSmallBPQueueInit(&q1, 3);
+	// Assertions
+	ASSERT_TRUE(spSmallBPQueueEnqueue(NULL,e1) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueueEnqueue(&q1,NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueueOffer(&q1,-1,1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueueOffer(&q1,1,-1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spSmallBPQueuePeek(&q1) == NULL);
+	ASSERT_TRUE(spSmallBPQueueMinValue(&q1) == -1.0);
+	ASSERT_TRUE(spSmallBPQueueEnqueue(&q1,e1) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spSmallBPQueueEnqueue(&q1,e2) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spSmallBPQueueEnqueue(&q1,e3) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spSmallBPQueueEnqueue(&q1,e3) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spSmallBPQueueSize(&q1) == 3);
+	ASSERT_TRUE(spSmallBPQueueMinValue(&q1) == 1.0);
+	ASSERT_TRUE(spSmallBPQueueMaxValue(&q1) == 2.0);
+	temp = spSmallBPQueuePeekLast(&q1);
+	ASSERT_TRUE(spListElementCompare(temp,e3) == 0);
+	spListElementDestroy(temp);
+	for (i = 0; i < 3; i++) { // check if the queue saved the right elements
+		ASSERT_TRUE(spSmallBPQueueIndexAt(&q1, 0) == spListElementGetIndex(order[i]));
+		temp = spSmallBPQueuePeek(&q1);
+		ASSERT_TRUE(spListElementCompare(temp,order[i]) == 0);
+		spListElementDestroy(temp);
+		ASSERT_TRUE(spSmallBPQueueDequeue(&q1) == SP_BPQUEUE_SUCCESS);
+	}
+	ASSERT_TRUE(spSmallBPQueueDequeue(&q1) == SP_BPQUEUE_EMPTY);
+	ASSERT_TRUE(spSmallBPQueueDequeue(NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	// Deallocation
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	spListElementDestroy(e3);
+	return true;
+}
+
+// Compares the whole content of the small queue with a list backed SPBPQueue
+bool smallQueueRandomTest(){
+	// Function variables
+	int maxSize, i, j;
+	SP_BPQUEUE_MSG msg;
+	// SPBPQueue variables
+	SPSmallBPQueue q;
+	SPBPQueue reference;
+	SPBPQueue copy;
+	SPListElement e;
+	srand(2016);
+	for (maxSize = 1; maxSize <= SP_SMALL_BPQUEUE_CAPACITY; maxSize++) {
+		spSmallBPQueueInit(&q, maxSize);
+		reference = spBPQueueCreate(maxSize);
+		for (i = 0; i < 500; i++) {
+			if (rand() % 8 == 0) {
+				ASSERT_TRUE(spSmallBPQueueDequeue(&q) == spBPQueueDequeue(reference));
+			} else {
+				e = spListElementCreate(rand() % 40, (double) (rand() % 16));
+				msg = spSmallBPQueueEnqueue(&q,e);
+				ASSERT_TRUE(msg == spBPQueueEnqueue(reference,e));
+				spListElementDestroy(e);
+			}
+			ASSERT_TRUE(spSmallBPQueueSize(&q) == spBPQueueSize(reference));
+			copy = spBPQueueCopy(reference);
+			for (j = 0; j < spSmallBPQueueSize(&q); j++) {
+				e = spBPQueuePeek(copy);
+				ASSERT_TRUE(spSmallBPQueueIndexAt(&q, j) == spListElementGetIndex(e));
+				ASSERT_TRUE(spSmallBPQueueValueAt(&q, j) == spListElementGetValue(e));
+				spListElementDestroy(e);
+				spBPQueueDequeue(copy);
+			}
+			spBPQueueDestroy(copy);
+		}
+		spBPQueueDestroy(reference);
+	}
+	return true;
+}
+
+int main() {
+	RUN_TEST(smallQueueInitTest);
+	RUN_TEST(smallQueueEnqueueTest);
+	RUN_TEST(smallQueueRandomTest);
+	return 0;
+}
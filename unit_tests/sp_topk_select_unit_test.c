@@ -0,0 +1,110 @@
+#include "../SPTopKSelect.h"
+#include "../SPBPriorityQueue.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define RANDOM_MAX_N 3000
+
+bool topKSelectInputTest(){
+	// Function variables
+	double values[3] = {3,1,2};
+	int outIdx[3];
+	double outVal[3];
+	// Assertions
+	ASSERT_TRUE(spTopKSelect(NULL,NULL,3,2,outIdx,outVal) == -1);
+	ASSERT_TRUE(spTopKSelect(values,NULL,3,2,NULL,outVal) == -1);
+	ASSERT_TRUE(spTopKSelect(values,NULL,3,2,outIdx,NULL) == -1);
+	ASSERT_TRUE(spTopKSelect(values,NULL,-1,2,outIdx,outVal) == -1);
+	ASSERT_TRUE(spTopKSelect(values,NULL,3,-1,outIdx,outVal) == -1);
+	ASSERT_TRUE(spTopKSelect(values,NULL,0,2,outIdx,outVal) == 0);
+	ASSERT_TRUE(spTopKSelect(values,NULL,3,0,outIdx,outVal) == 0);
+	ASSERT_TRUE(spTopKSelect(values,NULL,3,5,outIdx,outVal) == 3); // k > n
+	ASSERT_TRUE(outIdx[0] == 1 && outIdx[1] == 2 && outIdx[2] == 0);
+	ASSERT_TRUE(outVal[0] == 1 && outVal[1] == 2 && outVal[2] == 3);
+	return true;
+}
+
+bool topKSelectTiesTest(){
+	// Function variables
+	double values[6] = {2,1,2,1,2,0};
+	int indices[6] = {10,11,3,20,1,7};
+	int outIdx[4];
+	double outVal[4];
+	int expectedIdx[4] = {7,11,20,1};
+	int i; // Generic loop variable
+	// Assertions
+	ASSERT_TRUE(spTopKSelect(values,indices,6,4,outIdx,outVal) == 4);
+	for (i = 0; i < 4; i++) {
+		ASSERT_TRUE(outIdx[i] == expectedIdx[i]);
+	}
+	ASSERT_TRUE(spTopKSelectBelow(values,indices,6,4,1.0,outIdx,outVal) == 3);
+	ASSERT_TRUE(outIdx[0] == 7 && outIdx[1] == 11 && outIdx[2] == 20);
+	ASSERT_TRUE(spTopKSelectBelow(values,indices,6,4,-1.0,outIdx,outVal) == 0);
+	return true;
+}
+
+// Compares the selection with a list backed SPBPQueue fed element by element
+bool topKSelectRandomTest(){
+	// Function variables
+	static double values[RANDOM_MAX_N];
+	static int indices[RANDOM_MAX_N];
+	static int outIdx[RANDOM_MAX_N];
+	static double outVal[RANDOM_MAX_N];
+	int n, k, i, selected;
+	// SPBPQueue variables
+	SPBPQueue reference;
+	SPListElement e;
+	srand(2016);
+	for (n = 1; n <= RANDOM_MAX_N; n = n * 3 + 1) {
+		for (k = 1; k <= n; k = k * 2 + 1) {
+			for (i = 0; i < n; i++) {
+				values[i] = (double) (rand() % (n / 2 + 1)); // Plenty of ties
+				indices[i] = rand() % 100000;
+			}
+			reference = spBPQueueCreateWithBackend(k, SP_BPQUEUE_HEAP_BACKEND);
+			for (i = 0; i < n; i++) {
+				e = spListElementCreate(indices[i], values[i]);
+				spBPQueueEnqueue(reference, e);
+				spListElementDestroy(e);
+			}
+			selected = spTopKSelect(values,indices,n,k,outIdx,outVal);
+			ASSERT_TRUE(selected == k);
+			for (i = 0; i < k; i++) {
+				e = spBPQueuePeek(reference);
+				ASSERT_TRUE(spListElementGetIndex(e) == outIdx[i]);
+				ASSERT_TRUE(spListElementGetValue(e) == outVal[i]);
+				spListElementDestroy(e);
+				spBPQueueDequeue(reference);
+			}
+			spBPQueueDestroy(reference);
+		}
+	}
+	return true;
+}
+
+// The output can be loaded into a queue in one pass
+bool topKSelectLoadQueueTest(){
+	// Function variables
+	double values[5] = {5,4,3,2,1};
+	int outIdx[3];
+	double outVal[3];
+	// SPBPQueue variables
+	SPBPQueue q1 = spBPQueueCreate(3);
+	// Assertions
+	ASSERT_TRUE(spTopKSelect(values,NULL,5,3,outIdx,outVal) == 3);
+	ASSERT_TRUE(spBPQueueEnqueueSorted(q1,outIdx,outVal,3) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spBPQueueMinValue(q1) == 1);
+	ASSERT_TRUE(spBPQueueMaxValue(q1) == 3);
+	// Deallocation
+	spBPQueueDestroy(q1);
+	return true;
+}
+
+int main() {
+	RUN_TEST(topKSelectInputTest);
+	RUN_TEST(topKSelectTiesTest);
+	RUN_TEST(topKSelectRandomTest);
+	RUN_TEST(topKSelectLoadQueueTest);
+	return 0;
+}